@@ -105,8 +105,8 @@ amm-info@iis.fraunhofer.de
 #include "mmtisobmff/configdescriptor/vvc_decoderconfigrecord.h"
 #include "mmtisobmff/helper/commonhelpertools.h"
 #include "mmtisobmff/helper/printhelpertools.h"
-#include "tree/tree_parser.h"
-#include "service/servicesingleton.h"
+#include "tree/box_event_parser.h"
+#include "service/parsercontext.h"
 #include "box/containerbox.h"
 #include "box/mvhdbox.h"
 #include "box/tkhdbox.h"
@@ -1453,6 +1453,56 @@ struct BoxPrinter {
   std::map<Fourcc, std::function<void(const BoxItem&, const std::string&)>> printMap;
 };
 
+//! Prints the boxes while walking the file, so no box tree needs to be built
+struct BoxEventPrinter : public IBoxEventHandler {
+  explicit BoxEventPrinter(BoxPrinter& printer) : pm(printer) {}
+
+  EBoxEventAction onBoxBegin(const Fourcc& type, uint64_t /*offset*/, uint64_t size,
+                             uint32_t depth) override {
+    std::string treeSpaces(static_cast<size_t>(depth), ' ');
+    std::cout << treeSpaces << toString(type) << " (" << size << ")" << std::endl;
+
+    if (depth == 0 && type == "moov"_fcc) {
+      hasMovieBox = true;
+    }
+    return EBoxEventAction::decode;
+  }
+
+  void onBoxPayload(const BoxItem& item, uint32_t depth) override {
+    if (depth == 0) {
+      addOverhead(*item, overheadInfo);
+    }
+
+    std::string treeSpaces(static_cast<size_t>(depth), ' ');
+    treeSpaces.append("|");
+
+    if (std::dynamic_pointer_cast<box::CInvalidBox>(item) != nullptr) {
+      std::cout << treeSpaces << " <invalid box>" << std::endl;
+      return;
+    }
+
+    if (std::dynamic_pointer_cast<box::CUnknownBox>(item) != nullptr) {
+      std::cout << treeSpaces << " <unknown box>" << std::endl;
+      return;
+    }
+
+    if (std::dynamic_pointer_cast<box::CContainerBox>(item) != nullptr) {
+      return;
+    }
+
+    try {
+      pm.printMap.at(item->type())(item, treeSpaces);
+    } catch (std::out_of_range&) {
+      // Printing is not implemented for this box.
+      std::cout << treeSpaces << " <unknown details>" << std::endl;
+    }
+  }
+
+  BoxPrinter& pm;
+  SOverheadInfo overheadInfo;
+  bool hasMovieBox = false;
+};
+
 void doWork(int argc, char** argv) {
   std::string fileUri = std::string(argv[1]);
   bool logging = false;
@@ -1473,50 +1523,20 @@ void doWork(int argc, char** argv) {
     redirectLoggingToFile("mmtisobmff_print_mp4_boxes.log", RedirectMode::overwrite);
   }
 
-  mmt::isobmff::setupServicesOnce();
+  CParserContext parserContext;
 
   std::unique_ptr<IIsobmffInput> input = ilo::make_unique<CIsobmffFileInput>(fileUri);
 
-  BoxTree tree;
+  BoxEventPrinter eventPrinter(pm);
 
   try {
-    parseTree(tree, input);
+    parseBoxEvents(parserContext, input, eventPrinter);
   } catch (std::exception& e) {
     std::cerr << "Exception occured: " << e.what() << std::endl;
-    std::cerr << "Printing successfully parsed content." << std::endl;
+    std::cerr << "Printed successfully parsed content." << std::endl;
   }
 
-  visitAllOf(tree, [&pm](const BoxElement& boxElement, int32_t level) {
-    std::string boxName = toString(boxElement.item->type());
-    uint64_t boxSize = boxElement.item->size();
-
-    std::string treeSpaces(static_cast<size_t>(level), ' ');
-    std::cout << treeSpaces << boxName << " (" << boxSize << ")" << std::endl;
-    treeSpaces.append("|");
-
-    if (std::dynamic_pointer_cast<box::CInvalidBox>(boxElement.item) != nullptr) {
-      std::cout << treeSpaces << " <invalid box>" << std::endl;
-      return;
-    }
-
-    if (std::dynamic_pointer_cast<box::CUnknownBox>(boxElement.item) != nullptr) {
-      std::cout << treeSpaces << " <unknown box>" << std::endl;
-      return;
-    }
-
-    if (std::dynamic_pointer_cast<box::CContainerBox>(boxElement.item) != nullptr) {
-      return;
-    }
-
-    try {
-      pm.printMap.at(boxElement.item->type())(boxElement.item, treeSpaces);
-    } catch (std::out_of_range&) {
-      // Printing is not implemented for this box.
-      std::cout << treeSpaces << " <unknown details>" << std::endl;
-    }
-  });
-
-  auto overheadInfo = calculateOverhead(tree);
+  const SOverheadInfo& overheadInfo = eventPrinter.overheadInfo;
   uint64_t totalSize = overheadInfo.sizeOverhead + overheadInfo.sizePayload;
   std::cout << "\n\nOverhead Info: " << std::endl;
   std::cout << "--Total Size: " << totalSize << " [Byte]" << std::endl;
@@ -1527,7 +1547,7 @@ void doWork(int argc, char** argv) {
             << "%)" << std::endl;
 
   // Check if we actually have moov data to print some extra infos.
-  if (findFirstBoxWithFourccAndType<box::CContainerBox>(tree, ilo::toFcc("moov"))) {
+  if (eventPrinter.hasMovieBox) {
     extraInfo(argc, argv);
   } else {
     std::cout << "\nInfo: Extra Info block is not being printed "
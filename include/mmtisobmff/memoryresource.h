@@ -0,0 +1,168 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2025 - 2026 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+/*!
+ * @file memoryresource.h
+ * @brief Memory resources used for the boxes of readers and writers
+ * \defgroup memory Memory resources for box allocation
+ *
+ * Allocation interface in the spirit of std::pmr::memory_resource for C++11 builds
+ */
+
+#pragma once
+
+// System includes
+#include <cstddef>
+#include <memory>
+
+namespace mmt {
+namespace isobmff {
+/*!
+ * @brief Interface of a memory resource
+ *
+ * Readers and writers allocate their boxes from a memory resource (see @ref SReaderConfig and
+ * @ref SMovieConfig). Implementations must be thread-safe, since boxes can be created from several
+ * threads at once (e.g. when lazily parsed sample tables are accessed).
+ *
+ * \ingroup memory
+ */
+struct IMemoryResource {
+  virtual ~IMemoryResource() {}
+
+  /*!
+   * @brief Allocates memory
+   *
+   * @param bytes Number of bytes to allocate
+   * @param alignment Required alignment of the returned memory (power of two)
+   * @return Pointer to the allocated memory. Throws if the allocation failed.
+   */
+  virtual void* allocate(std::size_t bytes, std::size_t alignment) = 0;
+
+  /*!
+   * @brief Returns memory allocated by @ref allocate
+   *
+   * @param ptr Pointer returned by @ref allocate
+   * @param bytes Number of bytes passed to @ref allocate
+   * @param alignment Alignment passed to @ref allocate
+   */
+  virtual void deallocate(void* ptr, std::size_t bytes, std::size_t alignment) = 0;
+};
+
+/*!
+ * @brief Monotonic arena memory resource
+ *
+ * Allocates from a list of growing memory blocks. Deallocation is a no-op and all memory is
+ * released at once when the resource is destroyed. This avoids per-box heap allocations and frees
+ * a complete box tree in one operation.
+ *
+ * @note Memory is never reused while the resource is alive, so this resource is not suitable for
+ * allocations with a lot of churn.
+ *
+ * \ingroup memory
+ */
+class CMonotonicMemoryResource : public IMemoryResource {
+ public:
+  /*!
+   * @brief Monotonic memory resource constructor
+   *
+   * @param initialBlockSize Size in bytes of the first block. Following blocks double in size.
+   */
+  explicit CMonotonicMemoryResource(std::size_t initialBlockSize = 64 * 1024);
+  ~CMonotonicMemoryResource() override;
+
+  CMonotonicMemoryResource& operator=(const CMonotonicMemoryResource&) = delete;
+  CMonotonicMemoryResource(const CMonotonicMemoryResource&) = delete;
+
+  void* allocate(std::size_t bytes, std::size_t alignment) override;
+
+  //! Does nothing, memory is released when the resource is destroyed
+  void deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override;
+
+  //! Total size in bytes of all blocks requested from the heap so far
+  std::size_t reservedBytes() const;
+
+ private:
+  struct SImpl;
+  std::unique_ptr<SImpl> m_impl;
+};
+}  // namespace isobmff
+}  // namespace mmt
@@ -91,7 +91,9 @@ amm-info@iis.fraunhofer.de
 #pragma once
 
 // System includes
+#include <limits>
 #include <string>
+#include <vector>
 
 #include <stdio.h>
 
@@ -104,12 +106,29 @@ amm-info@iis.fraunhofer.de
 
 namespace mmt {
 namespace isobmff {
+/*!
+ * @brief Single read operation of a batch (see @ref IIsobmffInput::readBatch)
+ */
+struct SInputReadRequest {
+  /*! Position in bytes relative to the input start to read from */
+  pos_type position = 0;
+  /*! Begin of the pre-allocated target buffer range */
+  ilo::ByteBuffer::iterator begin;
+  /*! End of the pre-allocated target buffer range */
+  ilo::ByteBuffer::iterator end;
+  /*! Number of bytes actually read (set by the input) */
+  size_t bytesRead = 0;
+};
+
 /*!
  * @brief Input interface
  *
  * Input interface that is used by @ref CIsobmffReader to read files from either disk or memory.
  */
 struct IIsobmffInput {
+  //! Value returned by @ref size if the input does not know its size
+  static constexpr pos_type unknownSize = std::numeric_limits<pos_type>::max();
+
   virtual ~IIsobmffInput() {}
 
   /*!
@@ -135,6 +154,61 @@ struct IIsobmffInput {
   virtual bool isEOI() = 0;
   //! Clones the input
   virtual std::unique_ptr<IIsobmffInput> clone() = 0;
+
+  /*!
+   * @brief Total size of the input in bytes
+   *
+   * Allows parsing the input without seeking to the end to find out how much data is available.
+   * Implementations should cache the size, since it is queried frequently.
+   *
+   * @return Size in bytes or @ref unknownSize if the input does not know its size
+   */
+  virtual pos_type size() { return unknownSize; }
+
+  /*!
+   * @brief Direct read-only access to a range of the input without copying
+   *
+   * Inputs that keep the complete data addressable in memory (like @ref CIsobmffMmapInput or
+   * @ref CIsobmffMemoryInput) can return a pointer to the requested range. The reading position
+   * is not changed by this call.
+   *
+   * @param pos Position in bytes relative to the input start
+   * @param size Number of bytes that must be accessible starting at pos
+   * @return Pointer to the requested range or nullptr if direct access is not supported by the
+   * input or the range is not available
+   *
+   * @note The pointer stays valid as long as the input (or any of its clones) is alive.
+   */
+  virtual const uint8_t* view(pos_type /*pos*/, size_t /*size*/) { return nullptr; }
+
+  /*!
+   * @brief Shared ownership of the complete input data
+   *
+   * Inputs that are backed by a single shared byte buffer (like @ref CIsobmffMemoryInput) return
+   * it here. Boxes are then parsed directly from this buffer instead of being copied into a
+   * staging buffer first.
+   *
+   * @return The buffer holding the complete input or nullptr if the input is not backed by one
+   */
+  virtual std::shared_ptr<const ilo::ByteBuffer> sharedBuffer() { return nullptr; }
+
+  /*!
+   * @brief Reads several independent ranges of the input
+   *
+   * Inputs that support asynchronous I/O (like @ref CIsobmffUringFileInput) can queue all
+   * requests at once and collect the completions. The default implementation reads one request
+   * after the other.
+   *
+   * @param [in,out] requests Ranges to read. bytesRead is set for every request.
+   *
+   * @note The reading position after this call is unspecified. Seek before the next @ref read.
+   */
+  virtual void readBatch(std::vector<SInputReadRequest>& requests) {
+    for (auto& request : requests) {
+      seek(request.position);
+      request.bytesRead = read(request.begin, request.end);
+    }
+  }
 };
 
 /*!
@@ -201,9 +275,140 @@ struct CIsobmffFileInput : public IIsobmffInput {
     return std::unique_ptr<IIsobmffInput>(new CIsobmffFileInput(m_filename));
   }
 
+  //! Size of the file in bytes (determined once on first call)
+  virtual pos_type size() override;
+
  private:
   ilo::CFileWrapper m_file;
   std::string m_filename;
+  pos_type m_size = unknownSize;
+};
+
+/*!
+ * @brief Implementation of a positional (pread based) file input reader
+ *
+ * Reads files from disk without a shared file cursor. Every read is done at the reading position
+ * of the input instance (pread on POSIX, ReadFile with an explicit offset on Windows) and there
+ * is no stdio buffering in between.
+ *
+ * Clones share the same file descriptor but have their own reading position. Therefore all track
+ * readers of a @ref CIsobmffReader use a single file descriptor, and different clones can be
+ * used concurrently from different threads.
+ *
+ * \ingroup input
+ */
+struct CIsobmffPositionalFileInput : public IIsobmffInput {
+  /*!
+   * @brief Positional file input constructor
+   *
+   * @param filename Path to the input file
+   */
+  explicit CIsobmffPositionalFileInput(const std::string& filename);
+
+  /*!
+   * @brief Read data from file input into a buffer
+   *
+   * The user must provide a pre-allocated buffer to read into. The number of bytes to read is
+   * determined by the distance between the given begin and end iterators of the output buffer.
+   *
+   * @note The returned size must be checked. In case the input has less data left than requested,
+   * the returned size will signal the number of bytes actually written to the output buffer.
+   *
+   * @note begin and end iterators must both point to the same underlying buffer structure
+   * and memory must be accessible in a continuous way.
+   */
+  virtual size_t read(ilo::ByteBuffer::iterator inBegin, ilo::ByteBuffer::iterator inEnd) override;
+
+  /*!
+   * @brief Function to seek to a fixed position in the input file
+   *
+   * When called, the reader pointer for the next @ref read call is set to parameter pos.
+   *
+   * @param pos Position in bytes relative to file start at which to continue reading with the next
+   * @ref read call.
+   */
+  virtual void seek(pos_type pos) override;
+
+  /*!
+   * @brief Function to seek relative to a given origin
+   *
+   * When called, the pointer to read from with a future @ref read call is set to an
+   * offset relative to origin.
+   *
+   * @param offset Offset in bytes to seek to relative to origin.
+   *              A positive value indicates seeking towards the end,
+   *              a negative value seeking towards the front.
+   * @param origin Origin to start seeking at.
+   */
+  virtual void seek(offset_type offset, SeekingOrigin origin) override;
+
+  //! Function to get the current position in the stream
+  virtual pos_type tell() override { return m_pos; }
+
+  //! Function to check if input is "end of input"
+  virtual bool isEOI() override;
+
+  //! Clones the input (the clone shares the file descriptor, but has its own reading position)
+  virtual std::unique_ptr<IIsobmffInput> clone() override {
+    return std::unique_ptr<IIsobmffInput>(new CIsobmffPositionalFileInput(m_file));
+  }
+
+  //! Size of the file in bytes (cached, refreshed when reading reaches the cached size)
+  virtual pos_type size() override;
+
+ protected:
+  struct SFileHandle;
+  explicit CIsobmffPositionalFileInput(std::shared_ptr<const SFileHandle> file);
+
+  std::shared_ptr<const SFileHandle> m_file;
+  pos_type m_pos;
+  pos_type m_size = unknownSize;
+};
+
+/*!
+ * @brief Implementation of a file input reader with batched asynchronous reads (io_uring)
+ *
+ * Behaves like @ref CIsobmffPositionalFileInput, but implements @ref readBatch with Linux
+ * io_uring: all requests of a batch are queued at once and their completions are collected
+ * afterwards, so many reads are in flight with a single system call.
+ *
+ * On systems without io_uring support (other operating systems, older kernels or if io_uring is
+ * disabled) the batch is read with positional reads instead.
+ *
+ * @note Clones share the file descriptor, but every clone has its own submission ring.
+ *
+ * \ingroup input
+ */
+struct CIsobmffUringFileInput : public CIsobmffPositionalFileInput {
+  /*!
+   * @brief io_uring file input constructor
+   *
+   * @param filename Path to the input file
+   * @param queueDepth Maximum number of reads that are in flight at the same time
+   */
+  explicit CIsobmffUringFileInput(const std::string& filename, uint32_t queueDepth = 64);
+  virtual ~CIsobmffUringFileInput() override;
+
+  //! Clones the input (the clone shares the file descriptor, but has its own ring)
+  virtual std::unique_ptr<IIsobmffInput> clone() override {
+    return std::unique_ptr<IIsobmffInput>(new CIsobmffUringFileInput(m_file, m_queueDepth));
+  }
+
+  /*!
+   * @brief Reads several independent ranges of the file with one submission
+   *
+   * @param [in,out] requests Ranges to read. bytesRead is set for every request.
+   */
+  virtual void readBatch(std::vector<SInputReadRequest>& requests) override;
+
+ private:
+  struct SRing;
+  CIsobmffUringFileInput(std::shared_ptr<const SFileHandle> file, uint32_t queueDepth);
+
+  uint32_t m_queueDepth;
+  std::unique_ptr<SRing> m_ring;
+  //! Set if the ring could not be created, batches are read with positional reads then
+  bool m_ringUnavailable;
 };
 
 /*!
@@ -272,9 +477,212 @@ struct CIsobmffMemoryInput : public IIsobmffInput {
     return std::unique_ptr<IIsobmffInput>(new CIsobmffMemoryInput(buffer));
   }
 
+  //! Direct access to a range of the input buffer (nullptr if out of range)
+  virtual const uint8_t* view(pos_type pos, size_t size) override;
+
+  //! The externally managed buffer this input reads from
+  virtual std::shared_ptr<const ilo::ByteBuffer> sharedBuffer() override { return buffer; }
+
+  //! Size of the input buffer in bytes
+  virtual pos_type size() override { return static_cast<pos_type>(buffer->size()); }
+
  private:
   std::shared_ptr<const ilo::ByteBuffer> buffer;
   ilo::ByteBuffer::const_iterator ptr;
 };
+
+/*!
+ * @brief Implementation of a memory mapped file input reader
+ *
+ * Maps the complete file read-only into memory. Reading is done from the mapping instead of
+ * going through stdio buffers and samples can be accessed without copying (see @ref view and the
+ * sample view functions of the track readers).
+ *
+ * Clones share the same mapping. The mapping is released when the last clone is destroyed.
+ *
+ * \ingroup input
+ */
+struct CIsobmffMmapInput : public IIsobmffInput {
+  /*!
+   * @brief Memory mapped file input constructor
+   *
+   * @param filename Path to the input file
+   */
+  explicit CIsobmffMmapInput(const std::string& filename);
+
+  /*!
+   * @brief Read data from the mapped file into a buffer
+   *
+   * The user must provide a pre-allocated buffer to read into. The number of bytes to read is
+   * determined by the distance between the given begin and end iterators of the output buffer.
+   *
+   * @note The returned size must be checked. In case the input has less data left than requested,
+   * the returned size will signal the number of bytes actually written to the output buffer.
+   *
+   * @note begin and end iterators must both point to the same underlying buffer structure
+   * and memory must be accessible in a continuous way.
+   */
+  virtual size_t read(ilo::ByteBuffer::iterator inBegin, ilo::ByteBuffer::iterator inEnd) override;
+
+  /*!
+   * @brief Function to seek to a fixed position in the mapped file
+   *
+   * When called, the reader pointer for the next @ref read call is set to parameter pos.
+   *
+   * @param pos Position in bytes relative to file start at which to continue reading with the next
+   * @ref read call.
+   */
+  virtual void seek(pos_type pos) override;
+
+  /*!
+   * @brief Function to seek relative to a given origin
+   *
+   * When called, the reader pointer for the next @ref read call is set to an
+   * offset relative to origin.
+   *
+   * @param offset Offset in bytes to seek to (relative to origin).
+   *              A positive value indicates seeking towards the end,
+   *              a negative value seeking towards the front.
+   * @param origin Origin to start seeking at.
+   */
+  virtual void seek(offset_type offset, SeekingOrigin origin) override;
+
+  //! Function to get the current reading position in the stream in bytes
+  virtual pos_type tell() override { return m_pos; }
+
+  //! Function to check if input is "end of input"
+  virtual bool isEOI() override;
+
+  //! Clones the input (the clone shares the mapping, but has its own reading position)
+  virtual std::unique_ptr<IIsobmffInput> clone() override {
+    return std::unique_ptr<IIsobmffInput>(new CIsobmffMmapInput(m_mapping));
+  }
+
+  //! Direct access to a range of the mapped file (nullptr if out of range)
+  virtual const uint8_t* view(pos_type pos, size_t size) override;
+
+  //! Size of the mapped file in bytes
+  virtual pos_type size() override;
+
+ private:
+  struct SMapping;
+  explicit CIsobmffMmapInput(std::shared_ptr<const SMapping> mapping);
+
+  std::shared_ptr<const SMapping> m_mapping;
+  pos_type m_pos;
+};
+
+/*!
+ * @brief Configuration of a @ref CIsobmffCachedInput
+ */
+struct SCachedInputConfig {
+  /*!
+   * Size of one cache block in bytes. Reads of at least this size bypass the cache and are
+   * forwarded to the wrapped input directly.
+   */
+  size_t blockSize = 64 * 1024;
+  /*! Maximum number of blocks kept in the cache. The least recently used block is evicted first. */
+  size_t maxCachedBlocks = 16;
+  /*!
+   * Number of blocks that are additionally fetched (in the same read call to the wrapped input)
+   * when a sequential access pattern is detected. 0 disables read-ahead.
+   */
+  size_t readAheadBlocks = 2;
+};
+
+/*!
+ * @brief Input decorator adding a block cache and sequential read-ahead to any input
+ *
+ * Wraps another input (file, memory or user defined) and serves small reads (like box headers or
+ * small audio samples) from a least recently used cache of fixed size blocks. Consecutive block
+ * misses are detected as sequential access and the following blocks are fetched with the same
+ * read call. This reduces the number of calls to the wrapped input, which is especially
+ * beneficial for inputs with a high per call latency (e.g. network filesystems).
+ *
+ * @note The cache is not shared between clones. Every clone wraps a clone of the wrapped input
+ * and has its own cache.
+ *
+ * \ingroup input
+ */
+struct CIsobmffCachedInput : public IIsobmffInput {
+  /*!
+   * @brief Cached input constructor
+   *
+   * @param input Input to wrap
+   * @param config Cache configuration
+   */
+  explicit CIsobmffCachedInput(std::unique_ptr<IIsobmffInput>&& input,
+                               const SCachedInputConfig& config = SCachedInputConfig());
+  virtual ~CIsobmffCachedInput() override;
+
+  /*!
+   * @brief Read data from the cached input into a buffer
+   *
+   * The user must provide a pre-allocated buffer to read into. The number of bytes to read is
+   * determined by the distance between the given begin and end iterators of the output buffer.
+   *
+   * @note The returned size must be checked. In case the input has less data left than requested,
+   * the returned size will signal the number of bytes actually written to the output buffer.
+   *
+   * @note begin and end iterators must both point to the same underlying buffer structure
+   * and memory must be accessible in a continuous way.
+   */
+  virtual size_t read(ilo::ByteBuffer::iterator inBegin, ilo::ByteBuffer::iterator inEnd) override;
+
+  /*!
+   * @brief Function to seek to a fixed position in the input
+   *
+   * When called, the reader pointer for the next @ref read call is set to parameter pos.
+   *
+   * @param pos Position in bytes relative to the input start at which to continue reading with
+   * the next @ref read call.
+   */
+  virtual void seek(pos_type pos) override;
+
+  /*!
+   * @brief Function to seek relative to a given origin
+   *
+   * When called, the reader pointer for the next @ref read call is set to an
+   * offset relative to origin.
+   *
+   * @param offset Offset in bytes to seek to (relative to origin).
+   *              A positive value indicates seeking towards the end,
+   *              a negative value seeking towards the front.
+   * @param origin Origin to start seeking at.
+   */
+  virtual void seek(offset_type offset, SeekingOrigin origin) override;
+
+  //! Function to get the current reading position in the stream in bytes
+  virtual pos_type tell() override { return m_pos; }
+
+  //! Function to check if input is "end of input"
+  virtual bool isEOI() override;
+
+  //! Clones the input (the clone wraps a clone of the wrapped input and has an empty cache)
+  virtual std::unique_ptr<IIsobmffInput> clone() override {
+    return std::unique_ptr<IIsobmffInput>(new CIsobmffCachedInput(m_input->clone(), m_config));
+  }
+
+  //! Direct access is forwarded to the wrapped input
+  virtual const uint8_t* view(pos_type pos, size_t size) override {
+    return m_input->view(pos, size);
+  }
+
+  //! The shared buffer is forwarded from the wrapped input
+  virtual std::shared_ptr<const ilo::ByteBuffer> sharedBuffer() override {
+    return m_input->sharedBuffer();
+  }
+
+  //! The size is forwarded from the wrapped input
+  virtual pos_type size() override { return m_input->size(); }
+
+ private:
+  struct SBlockCache;
+
+  std::unique_ptr<IIsobmffInput> m_input;
+  SCachedInputConfig m_config;
+  std::unique_ptr<SBlockCache> m_cache;
+  pos_type m_pos;
+};
 }  // namespace isobmff
 }  // namespace mmt
@@ -95,6 +95,7 @@ amm-info@iis.fraunhofer.de
 #include <cstdint>
 #include <algorithm>
 #include <type_traits>
+#include <string>
 
 // External includes
 #include "ilo/string_utils.h"
@@ -102,6 +103,7 @@ amm-info@iis.fraunhofer.de
 // Internal includes
 #include "mmtisobmff/types.h"
 #include "mmtisobmff/reader/input.h"
+#include "mmtisobmff/memoryresource.h"
 
 namespace mmt {
 namespace isobmff {
@@ -205,6 +207,46 @@ using CTrackInfoVec = std::vector<CTrackInfo>;
 
 struct ITrackReader;
 
+/*!
+ * @brief Optional configuration of a @ref CIsobmffReader
+ *
+ * \ingroup mp4reader
+ */
+struct SReaderConfig {
+  /*!
+   * @brief Memory resource all boxes and sample tables of the reader are allocated from
+   *
+   * If not set, the reader uses its own @ref CMonotonicMemoryResource, so the complete box tree and
+   * all sample tables are released at once when the reader and all track readers are destroyed. A
+   * resource can be shared between several readers.
+   */
+  std::shared_ptr<IMemoryResource> memoryResource = nullptr;
+  /*!
+   * @brief Sample index file to open the input from
+   *
+   * If set and the file was written by @ref CIsobmffReader::writeSampleIndex for the same input,
+   * the top-level box layout and the sample tables are taken from it instead of deriving them
+   * from the input. The index is only used if the input size and a hash over the headers of all
+   * top-level boxes and the complete 'moov' and 'moof' boxes still match. Otherwise (or if the
+   * file does not exist or is corrupt) the input is parsed as usual. Rewritten 'moov' and 'moof'
+   * boxes and a changed top-level box layout are detected that way.
+   *
+   * @note The media data itself is not hashed, so 'mdat' payloads rewritten in place without
+   * changing their size are not detected. Remove the index file when modifying media data in
+   * place.
+   */
+  std::string sampleIndexFile;
+  /*!
+   * @brief Number of threads used to derive sample tables
+   *
+   * Tracks of non-fragmented files and track fragments of fragmented files are derived
+   * independently and distributed over this number of threads (including the calling one). The
+   * resulting sample tables do not depend on it. A value of 1 or 0 derives them on the calling
+   * thread only.
+   */
+  size_t sampleTableThreadCount = 1;
+};
+
 /*!
  * @brief MP4 reader interface
  *
@@ -234,6 +276,27 @@ struct CIsobmffReader {
    */
   CIsobmffReader(std::unique_ptr<IIsobmffInput>&& input);
 
+  /*!
+   * @brief Create an MP4 reader instance with a custom configuration
+   *
+   * @param input @ref IIsobmffInput object to read from.
+   * @param config @ref SReaderConfig of the reader.
+   *
+   * @see CIsobmffReader(std::unique_ptr<IIsobmffInput>&&)
+   */
+  CIsobmffReader(std::unique_ptr<IIsobmffInput>&& input, const SReaderConfig& config);
+
+  /*!
+   * @brief Write a sample index file for the input
+   *
+   * The index stores the top-level box layout and the sample tables of all tracks, so readers
+   * created later with @ref SReaderConfig::sampleIndexFile can skip deriving them. The file is
+   * written in native byte order and is meant as a cache on the same machine.
+   *
+   * @param filename Path of the index file, an existing file is overwritten.
+   */
+  void writeSampleIndex(const std::string& filename) const;
+
   //! Get movie information
   CMovieInfo movieInfo() const;
   //! Get number of tracks contained in the file
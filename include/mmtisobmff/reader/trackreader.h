@@ -197,6 +197,50 @@ class CGenericTrackReader : public ITrackReader {
    */
   virtual SSampleExtraInfo sampleByIndex(size_t sampleIndex, CSample& sample,
                                          bool preallocate = true) const;
+  /*!
+   * @brief Reads the next sample as a view without copying the payload (state is maintained in
+   * track reader)
+   *
+   * Shares the reading position with @ref nextSample. If the input supports direct access (like
+   * @ref CIsobmffMmapInput), the view points directly into the input data. Otherwise the payload
+   * is read into a buffer owned by this track reader.
+   *
+   * @param [out] sampleView View of one access unit (AU). If empty, track is EOS.
+   * @return Extra information containing (for example) timestamp information of the retrieved
+   * sample
+   *
+   * @note End of stream is signalled via an empty sample view. Make sure to check for each sample.
+   * @note The payload is only valid as long as this track reader is alive and, if it is held by the
+   * track reader, until the next read call.
+   */
+  virtual SSampleExtraInfo nextSampleView(CSampleView& sampleView) const;
+  /*!
+   * @brief Reads sample at a specified index as a view without copying the payload
+   *
+   * @param [in] sampleIndex 0-based index indicating which sample to read
+   * @param [out] sampleView View of one access unit (AU). If empty, track is EOS.
+   * @return Extra information containing (for example) timestamp information of the retrieved
+   * sample
+   *
+   * @note See @ref nextSampleView for the lifetime of the payload.
+   * @note This function will set a new reference point for future @ref nextSample and @ref
+   * nextSampleView calls.
+   */
+  virtual SSampleExtraInfo sampleViewByIndex(size_t sampleIndex, CSampleView& sampleView) const;
+  /*!
+   * @brief Reads the next samples with one batched request to the input (state is maintained in
+   * track reader)
+   *
+   * All sample reads are handed to the input at once, which allows inputs with asynchronous I/O
+   * (like @ref CIsobmffUringFileInput) to have all reads in flight at the same time.
+   *
+   * @param [out] samples Read samples. Resized to the number of samples actually read, which is
+   * less than sampleCount at the end of the track (empty if the track is EOS).
+   * @param [in] sampleCount Maximum number of samples to read
+   * @return Extra information for each of the retrieved samples
+   */
+  virtual std::vector<SSampleExtraInfo> nextSamples(std::vector<CSample>& samples,
+                                                    size_t sampleCount) const;
   /*!
    * @brief Reads sample by seeking to the user given time point and fulfilling the seek mode
    * requirements
@@ -233,6 +277,52 @@ class CGenericTrackReader : public ITrackReader {
    * point.
    */
   virtual SSampleExtraInfo resolveTimestamp(const SSeekConfig& seekConfig) const;
+  /*!
+   * @brief Returns the indices of all sync samples of the track
+   *
+   * The sync samples are taken from the 'stss' box or the 'trun' sample flags. They are indexed
+   * once when the sample table is derived, so no sample payload is read.
+   *
+   * @return 0-based sample indices of all sync samples in ascending order
+   *
+   * @note Every call copies the index, one entry per sync sample (that is per sample for tracks
+   * without 'stss' box). Use @ref syncSampleCount and @ref syncSampleIndex to access it without a
+   * copy.
+   */
+  virtual std::vector<size_t> syncSampleIndices() const;
+  /*!
+   * @brief Returns the number of sync samples of the track
+   *
+   * @return Number of sync samples, 0 if the track has none
+   */
+  virtual size_t syncSampleCount() const;
+  /*!
+   * @brief Returns the sample index of a sync sample without copying the sync sample index
+   *
+   * @param [in] syncSampleNumber 0-based number of the sync sample, less than @ref syncSampleCount
+   * @return 0-based sample index of the sync sample
+   */
+  virtual size_t syncSampleIndex(size_t syncSampleNumber) const;
+  /*!
+   * @brief Returns all groups of pictures (GOPs) of the track
+   *
+   * Every sync sample starts a GOP which lasts until the next sync sample or the end of the track.
+   * Samples before the first sync sample are not part of any GOP.
+   *
+   * @return GOPs in ascending order
+   */
+  virtual std::vector<SGopInfo> gopBoundaries() const;
+  /*!
+   * @brief Returns the sync sample closest to a sample
+   *
+   * If the sample lies right in the middle of two sync samples, the preceding one is returned.
+   *
+   * @param [in] sampleIndex 0-based index of the sample
+   * @return 0-based index of the closest sync sample
+   *
+   * @note Throws if the track has no sync sample at all (check @ref syncSampleCount first).
+   */
+  virtual size_t nearestSyncSample(size_t sampleIndex) const;
   /*!
    * @brief Get coding name as given in the 'stsd' box
    *
@@ -476,6 +566,40 @@ class CMpeghTrackReader : public ITrackReader {
    */
   SSampleExtraInfo sampleByIndex(size_t sampleIndex, CSample& sample,
                                  bool preallocate = true) const;
+  /*!
+   * @brief Reads the next sample as a view without copying the payload (state is maintained in
+   * track reader)
+   *
+   * @param [out] sampleView View of one access unit (AU). If empty, track is EOS.
+   * @return Extra information containing (for example) timestamp information of the retrieved
+   * sample.
+   *
+   * @note See @ref CGenericTrackReader::nextSampleView for the lifetime of the payload.
+   */
+  SSampleExtraInfo nextSampleView(CSampleView& sampleView) const;
+  /*!
+   * @brief Reads sample at a specified index as a view without copying the payload
+   *
+   * @param [in] sampleIndex 0-based index indicating which sample to read.
+   * @param [out] sampleView View of one access unit (AU). If empty, track is EOS.
+   * @return Extra information containing (for example) timestamp information of the retrieved
+   * sample.
+   *
+   * @note See @ref CGenericTrackReader::nextSampleView for the lifetime of the payload.
+   */
+  SSampleExtraInfo sampleViewByIndex(size_t sampleIndex, CSampleView& sampleView) const;
+  /*!
+   * @brief Reads the next samples with one batched request to the input
+   *
+   * @param [out] samples Read samples. Resized to the number of samples actually read (empty if
+   * the track is EOS).
+   * @param [in] sampleCount Maximum number of samples to read
+   * @return Extra information for each of the retrieved samples
+   *
+   * @note See @ref CGenericTrackReader::nextSamples for details.
+   */
+  std::vector<SSampleExtraInfo> nextSamples(std::vector<CSample>& samples,
+                                            size_t sampleCount) const;
   /*!
    * @brief Reads sample by seeking to a given point in time while fulfilling the seek mode
    * requirements
@@ -512,6 +636,45 @@ class CMpeghTrackReader : public ITrackReader {
    * point.
    */
   SSampleExtraInfo resolveTimestamp(const SSeekConfig& seekConfig) const;
+  /*!
+   * @brief Returns the indices of all sync samples of the track
+   *
+   * @return 0-based sample indices of all sync samples in ascending order
+   *
+   * @note See @ref CGenericTrackReader::syncSampleIndices for details.
+   */
+  std::vector<size_t> syncSampleIndices() const;
+  /*!
+   * @brief Returns the number of sync samples of the track
+   *
+   * @return Number of sync samples, 0 if the track has none
+   */
+  size_t syncSampleCount() const;
+  /*!
+   * @brief Returns the sample index of a sync sample without copying the sync sample index
+   *
+   * @param [in] syncSampleNumber 0-based number of the sync sample, less than syncSampleCount
+   * @return 0-based sample index of the sync sample
+   */
+  size_t syncSampleIndex(size_t syncSampleNumber) const;
+  /*!
+   * @brief Returns all groups of pictures (GOPs) of the track
+   *
+   * @return GOPs in ascending order
+   *
+   * @note See @ref CGenericTrackReader::gopBoundaries for details.
+   */
+  std::vector<SGopInfo> gopBoundaries() const;
+  /*!
+   * @brief Returns the sync sample closest to a sample
+   *
+   * @param [in] sampleIndex 0-based index of the sample
+   * @return 0-based index of the closest sync sample
+   *
+   * @note See @ref CGenericTrackReader::nearestSyncSample for details. Throws if the track has no
+   * sync sample at all.
+   */
+  size_t nearestSyncSample(size_t sampleIndex) const;
 
   /*!
    * @brief Get coding name as given in the 'stsd' box
@@ -612,6 +775,40 @@ class CMp4aTrackReader : public ITrackReader {
    */
   SSampleExtraInfo sampleByIndex(size_t sampleIndex, CSample& sample,
                                  bool preallocate = true) const;
+  /*!
+   * @brief Reads the next sample as a view without copying the payload (state is maintained in
+   * track reader)
+   *
+   * @param [out] sampleView View of one access unit (AU). If empty, track is EOS.
+   * @return Extra information containing (for example) timestamp information of the retrieved
+   * sample.
+   *
+   * @note See @ref CGenericTrackReader::nextSampleView for the lifetime of the payload.
+   */
+  SSampleExtraInfo nextSampleView(CSampleView& sampleView) const;
+  /*!
+   * @brief Reads sample at a specified index as a view without copying the payload
+   *
+   * @param [in] sampleIndex 0-based index indicating which sample to read.
+   * @param [out] sampleView View of one access unit (AU). If empty, track is EOS.
+   * @return Extra information containing (for example) timestamp information of the retrieved
+   * sample.
+   *
+   * @note See @ref CGenericTrackReader::nextSampleView for the lifetime of the payload.
+   */
+  SSampleExtraInfo sampleViewByIndex(size_t sampleIndex, CSampleView& sampleView) const;
+  /*!
+   * @brief Reads the next samples with one batched request to the input
+   *
+   * @param [out] samples Read samples. Resized to the number of samples actually read (empty if
+   * the track is EOS).
+   * @param [in] sampleCount Maximum number of samples to read
+   * @return Extra information for each of the retrieved samples
+   *
+   * @note See @ref CGenericTrackReader::nextSamples for details.
+   */
+  std::vector<SSampleExtraInfo> nextSamples(std::vector<CSample>& samples,
+                                            size_t sampleCount) const;
   /*!
    * @brief Reads sample by seeking to the user given time point and fulfilling the seek mode
    * requirements
@@ -648,6 +845,45 @@ class CMp4aTrackReader : public ITrackReader {
    * point.
    */
   SSampleExtraInfo resolveTimestamp(const SSeekConfig& seekConfig) const;
+  /*!
+   * @brief Returns the indices of all sync samples of the track
+   *
+   * @return 0-based sample indices of all sync samples in ascending order
+   *
+   * @note See @ref CGenericTrackReader::syncSampleIndices for details.
+   */
+  std::vector<size_t> syncSampleIndices() const;
+  /*!
+   * @brief Returns the number of sync samples of the track
+   *
+   * @return Number of sync samples, 0 if the track has none
+   */
+  size_t syncSampleCount() const;
+  /*!
+   * @brief Returns the sample index of a sync sample without copying the sync sample index
+   *
+   * @param [in] syncSampleNumber 0-based number of the sync sample, less than syncSampleCount
+   * @return 0-based sample index of the sync sample
+   */
+  size_t syncSampleIndex(size_t syncSampleNumber) const;
+  /*!
+   * @brief Returns all groups of pictures (GOPs) of the track
+   *
+   * @return GOPs in ascending order
+   *
+   * @note See @ref CGenericTrackReader::gopBoundaries for details.
+   */
+  std::vector<SGopInfo> gopBoundaries() const;
+  /*!
+   * @brief Returns the sync sample closest to a sample
+   *
+   * @param [in] sampleIndex 0-based index of the sample
+   * @return 0-based index of the closest sync sample
+   *
+   * @note See @ref CGenericTrackReader::nearestSyncSample for details. Throws if the track has no
+   * sync sample at all.
+   */
+  size_t nearestSyncSample(size_t sampleIndex) const;
 
   /*!
    * @brief Get coding name as given in the 'stsd' box
@@ -795,6 +1031,45 @@ class CAvcTrackReader : public ITrackReader {
    * point.
    */
   SSampleExtraInfo resolveTimestamp(const SSeekConfig& seekConfig) const;
+  /*!
+   * @brief Returns the indices of all sync samples of the track
+   *
+   * @return 0-based sample indices of all sync samples in ascending order
+   *
+   * @note See @ref CGenericTrackReader::syncSampleIndices for details.
+   */
+  std::vector<size_t> syncSampleIndices() const;
+  /*!
+   * @brief Returns the number of sync samples of the track
+   *
+   * @return Number of sync samples, 0 if the track has none
+   */
+  size_t syncSampleCount() const;
+  /*!
+   * @brief Returns the sample index of a sync sample without copying the sync sample index
+   *
+   * @param [in] syncSampleNumber 0-based number of the sync sample, less than syncSampleCount
+   * @return 0-based sample index of the sync sample
+   */
+  size_t syncSampleIndex(size_t syncSampleNumber) const;
+  /*!
+   * @brief Returns all groups of pictures (GOPs) of the track
+   *
+   * @return GOPs in ascending order
+   *
+   * @note See @ref CGenericTrackReader::gopBoundaries for details.
+   */
+  std::vector<SGopInfo> gopBoundaries() const;
+  /*!
+   * @brief Returns the sync sample closest to a sample
+   *
+   * @param [in] sampleIndex 0-based index of the sample
+   * @return 0-based index of the closest sync sample
+   *
+   * @note See @ref CGenericTrackReader::nearestSyncSample for details. Throws if the track has no
+   * sync sample at all.
+   */
+  size_t nearestSyncSample(size_t sampleIndex) const;
 
   /*!
    * @brief Get coding name as given in the 'stsd' box
@@ -942,6 +1217,45 @@ class CHevcTrackReader : public ITrackReader {
    * point.
    */
   SSampleExtraInfo resolveTimestamp(const SSeekConfig& seekConfig) const;
+  /*!
+   * @brief Returns the indices of all sync samples of the track
+   *
+   * @return 0-based sample indices of all sync samples in ascending order
+   *
+   * @note See @ref CGenericTrackReader::syncSampleIndices for details.
+   */
+  std::vector<size_t> syncSampleIndices() const;
+  /*!
+   * @brief Returns the number of sync samples of the track
+   *
+   * @return Number of sync samples, 0 if the track has none
+   */
+  size_t syncSampleCount() const;
+  /*!
+   * @brief Returns the sample index of a sync sample without copying the sync sample index
+   *
+   * @param [in] syncSampleNumber 0-based number of the sync sample, less than syncSampleCount
+   * @return 0-based sample index of the sync sample
+   */
+  size_t syncSampleIndex(size_t syncSampleNumber) const;
+  /*!
+   * @brief Returns all groups of pictures (GOPs) of the track
+   *
+   * @return GOPs in ascending order
+   *
+   * @note See @ref CGenericTrackReader::gopBoundaries for details.
+   */
+  std::vector<SGopInfo> gopBoundaries() const;
+  /*!
+   * @brief Returns the sync sample closest to a sample
+   *
+   * @param [in] sampleIndex 0-based index of the sample
+   * @return 0-based index of the closest sync sample
+   *
+   * @note See @ref CGenericTrackReader::nearestSyncSample for details. Throws if the track has no
+   * sync sample at all.
+   */
+  size_t nearestSyncSample(size_t sampleIndex) const;
 
   /*!
    * @brief Get coding name as given in the 'stsd' box
@@ -1046,6 +1360,40 @@ class CJxsTrackReader : public ITrackReader {
    */
   SSampleExtraInfo sampleByIndex(size_t sampleIndex, CSample& jxsSample,
                                  bool preallocate = true) const;
+  /*!
+   * @brief Reads the next sample as a view without copying the payload (state is maintained in
+   * track reader)
+   *
+   * @param [out] sampleView View of one access unit (AU). If empty, track is EOS.
+   * @return Extra information containing (for example) timestamp information of the retrieved
+   * sample.
+   *
+   * @note See @ref CGenericTrackReader::nextSampleView for the lifetime of the payload.
+   */
+  SSampleExtraInfo nextSampleView(CSampleView& sampleView) const;
+  /*!
+   * @brief Reads sample at a specified index as a view without copying the payload
+   *
+   * @param [in] sampleIndex 0-based index indicating which sample to read.
+   * @param [out] sampleView View of one access unit (AU). If empty, track is EOS.
+   * @return Extra information containing (for example) timestamp information of the retrieved
+   * sample.
+   *
+   * @note See @ref CGenericTrackReader::nextSampleView for the lifetime of the payload.
+   */
+  SSampleExtraInfo sampleViewByIndex(size_t sampleIndex, CSampleView& sampleView) const;
+  /*!
+   * @brief Reads the next samples with one batched request to the input
+   *
+   * @param [out] samples Read samples. Resized to the number of samples actually read (empty if
+   * the track is EOS).
+   * @param [in] sampleCount Maximum number of samples to read
+   * @return Extra information for each of the retrieved samples
+   *
+   * @note See @ref CGenericTrackReader::nextSamples for details.
+   */
+  std::vector<SSampleExtraInfo> nextSamples(std::vector<CSample>& samples,
+                                            size_t sampleCount) const;
   /*!
    * @brief Reads sample by seeking to the user given time point and fulfilling the seek mode
    * requirements
@@ -1082,6 +1430,45 @@ class CJxsTrackReader : public ITrackReader {
    * point.
    */
   SSampleExtraInfo resolveTimestamp(const SSeekConfig& seekConfig) const;
+  /*!
+   * @brief Returns the indices of all sync samples of the track
+   *
+   * @return 0-based sample indices of all sync samples in ascending order
+   *
+   * @note See @ref CGenericTrackReader::syncSampleIndices for details.
+   */
+  std::vector<size_t> syncSampleIndices() const;
+  /*!
+   * @brief Returns the number of sync samples of the track
+   *
+   * @return Number of sync samples, 0 if the track has none
+   */
+  size_t syncSampleCount() const;
+  /*!
+   * @brief Returns the sample index of a sync sample without copying the sync sample index
+   *
+   * @param [in] syncSampleNumber 0-based number of the sync sample, less than syncSampleCount
+   * @return 0-based sample index of the sync sample
+   */
+  size_t syncSampleIndex(size_t syncSampleNumber) const;
+  /*!
+   * @brief Returns all groups of pictures (GOPs) of the track
+   *
+   * @return GOPs in ascending order
+   *
+   * @note See @ref CGenericTrackReader::gopBoundaries for details.
+   */
+  std::vector<SGopInfo> gopBoundaries() const;
+  /*!
+   * @brief Returns the sync sample closest to a sample
+   *
+   * @param [in] sampleIndex 0-based index of the sample
+   * @return 0-based index of the closest sync sample
+   *
+   * @note See @ref CGenericTrackReader::nearestSyncSample for details. Throws if the track has no
+   * sync sample at all.
+   */
+  size_t nearestSyncSample(size_t sampleIndex) const;
 
   /*!
    * @brief Get coding name as given in the 'stsd' box
@@ -1232,6 +1619,45 @@ class CVvcTrackReader : public ITrackReader {
    * point.
    */
   SSampleExtraInfo resolveTimestamp(const SSeekConfig& seekConfig) const;
+  /*!
+   * @brief Returns the indices of all sync samples of the track
+   *
+   * @return 0-based sample indices of all sync samples in ascending order
+   *
+   * @note See @ref CGenericTrackReader::syncSampleIndices for details.
+   */
+  std::vector<size_t> syncSampleIndices() const;
+  /*!
+   * @brief Returns the number of sync samples of the track
+   *
+   * @return Number of sync samples, 0 if the track has none
+   */
+  size_t syncSampleCount() const;
+  /*!
+   * @brief Returns the sample index of a sync sample without copying the sync sample index
+   *
+   * @param [in] syncSampleNumber 0-based number of the sync sample, less than syncSampleCount
+   * @return 0-based sample index of the sync sample
+   */
+  size_t syncSampleIndex(size_t syncSampleNumber) const;
+  /*!
+   * @brief Returns all groups of pictures (GOPs) of the track
+   *
+   * @return GOPs in ascending order
+   *
+   * @note See @ref CGenericTrackReader::gopBoundaries for details.
+   */
+  std::vector<SGopInfo> gopBoundaries() const;
+  /*!
+   * @brief Returns the sync sample closest to a sample
+   *
+   * @param [in] sampleIndex 0-based index of the sample
+   * @return 0-based index of the closest sync sample
+   *
+   * @note See @ref CGenericTrackReader::nearestSyncSample for details. Throws if the track has no
+   * sync sample at all.
+   */
+  size_t nearestSyncSample(size_t sampleIndex) const;
 
   /*!
    * @brief Get coding name as given in the 'stsd' box
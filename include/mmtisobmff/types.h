@@ -300,6 +300,60 @@ struct CSample {
   SSampleGroupInfo sampleGroupInfo;
 };
 
+/*!
+ * @brief Non-owning view of an isobmff sample
+ *
+ * Same meta data as @ref CSample, but the payload is not copied into a sample owned buffer.
+ * Instead data points directly into the input (e.g. @ref CIsobmffMmapInput or
+ * @ref CIsobmffMemoryInput) if the input supports direct access. For all other inputs data points
+ * to a buffer owned by the track reader.
+ *
+ * @note The payload is only valid as long as the track reader that filled the view is alive.
+ * If the payload is held by the track reader, it is only valid until the next read call on the
+ * same track reader.
+ */
+struct CSampleView {
+  /*! Constructs an empty sample view */
+  CSampleView()
+      : data(nullptr),
+        size(0),
+        duration(0),
+        ctsOffset(0),
+        isSyncSample(false),
+        fragmentNumber(0) {}
+
+  /*! Clear the sample view - the view is empty after the call */
+  void clear() {
+    data = nullptr;
+    size = 0;
+    duration = 0;
+    ctsOffset = 0;
+    isSyncSample = false;
+    fragmentNumber = 0;
+    sampleGroupInfo.clear();
+  }
+
+  /*! Returns true if the sample view is empty - newly constructed and cleared views are empty */
+  bool empty() const { return size == 0 && duration == 0; }
+  /*! Pointer to the sample data as defined in ISO/IEC 14496-14 and 14496-15 (not owned) */
+  const uint8_t* data;
+  /*! Size of the sample data in bytes */
+  size_t size;
+  /*! Sample duration in ticks of track timescale */
+  uint64_t duration;
+  /*! Sample composition time offset in ticks of track timescale. @see CSample::ctsOffset */
+  int64_t ctsOffset;
+  /*! Marks a sample as a SyncSample. @see CSample::isSyncSample */
+  bool isSyncSample;
+  /*!
+   * Specifies whether this sample is part of a fragment and if yes, its index.\n
+   * 0 : not part of a fragment, >= 1 : part of the numbered fragment
+   */
+  uint32_t fragmentNumber;
+  /*! Describes what sample group this sample is part of (if any) */
+  SSampleGroupInfo sampleGroupInfo;
+};
+
 /*!
  * @brief Sample for codecs that make use of Network Abstraction Layer Units (NALU)
  *
@@ -726,6 +780,16 @@ struct SSeekConfig {
 struct SSampleExtraInfo {
   CIsoTimestamp timestamp;
 };
+
+//! Group of pictures (GOP), a sync sample and all samples up to the next sync sample
+struct SGopInfo {
+  /*! 0-based index of the sync sample starting the GOP */
+  size_t firstSampleIndex = 0;
+  /*! Number of samples in the GOP, including the sync sample */
+  size_t sampleCount = 0;
+  /*! Timestamp of the sync sample starting the GOP */
+  CIsoTimestamp timestamp;
+};
 }  // namespace isobmff
 }  // namespace mmt
 
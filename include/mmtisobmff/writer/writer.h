@@ -100,6 +100,7 @@ amm-info@iis.fraunhofer.de
 
 // Internal includes
 #include "mmtisobmff/writer/output.h"
+#include "mmtisobmff/memoryresource.h"
 
 namespace mmt {
 namespace isobmff {
@@ -168,6 +169,14 @@ struct SMovieConfig {
    * @note The buffer structure must all be big endian style.
    */
   std::vector<ilo::ByteBuffer> userData;
+  /*!
+   * @brief Optional value, memory resource all boxes of the writer are allocated from (default is
+   * the heap)
+   *
+   * @note The boxes of fragments are created and released continuously while writing, so a
+   * @ref CMonotonicMemoryResource is only suitable for writers creating a small number of boxes.
+   */
+  std::shared_ptr<IMemoryResource> memoryResource = nullptr;
 };
 
 struct ITrackWriter;
@@ -98,22 +98,30 @@ amm-info@iis.fraunhofer.de
 // Internal headers
 #include "box.h"
 #include "mmtisobmff/types.h"
+#include "common/resourceallocator.h"
 
 namespace mmt {
 namespace isobmff {
 namespace box {
 
+//! Allocator used for all boxes created by one parser context
+typedef CResourceAllocator<IBox> BoxAllocator;
+
 typedef std::function<std::shared_ptr<IBox>(ilo::ByteBuffer::const_iterator&,
                                             const ilo::ByteBuffer::const_iterator&)>
     ParseCreateFunction;
-typedef std::function<std::shared_ptr<IBox>(const CBox::SBoxWriteConfig&)> WriteCreateFunction;
+typedef std::shared_ptr<IBox> (*RegistryParseCreateFunction)(ilo::ByteBuffer::const_iterator&,
+                                                             const ilo::ByteBuffer::const_iterator&,
+                                                             const BoxAllocator&);
+typedef std::shared_ptr<IBox> (*RegistryWriteCreateFunction)(const CBox::SBoxWriteConfig&,
+                                                             const BoxAllocator&);
 
 enum class CContainerType { isContainer, noContainer };
 
 struct CBoxRegistryEntry {
   ilo::Fourcc fcc;
-  ParseCreateFunction parseCreate;
-  WriteCreateFunction writeCreate;
+  RegistryParseCreateFunction parseCreate;
+  RegistryWriteCreateFunction writeCreate;
   CContainerType containerType;
 };
 
@@ -125,15 +133,18 @@ struct CBoxRegistryEntry {
 #define ISOBMFF_CONCAT(x, y) ISOBMFF_XCONCAT(x, y)
 #define ISOBMFF_UNIQVARNAME(name) ISOBMFF_CONCAT(name, __LINE__)
 
-#define BOXREGISTRY_FUNCTIONS(boxtype, writeconfigtype)                                     \
-  static std::shared_ptr<mmt::isobmff::box::IBox> createParseBox(                           \
-      ilo::ByteBuffer::const_iterator& begin, const ilo::ByteBuffer::const_iterator& end) { \
-    return std::make_shared<boxtype>(begin, end);                                           \
-  }                                                                                         \
-  static std::shared_ptr<mmt::isobmff::box::IBox> createWriteBox(                           \
-      const mmt::isobmff::box::CBox::SBoxWriteConfig& boxData) {                            \
-    return std::make_shared<boxtype>(dynamic_cast<const writeconfigtype&>(boxData));        \
-  }                                                                                         \
+#define BOXREGISTRY_FUNCTIONS(boxtype, writeconfigtype)                                    \
+  static std::shared_ptr<mmt::isobmff::box::IBox> createParseBox(                          \
+      ilo::ByteBuffer::const_iterator& begin, const ilo::ByteBuffer::const_iterator& end,  \
+      const mmt::isobmff::box::BoxAllocator& allocator) {                                  \
+    return std::allocate_shared<boxtype>(allocator, begin, end);                           \
+  }                                                                                        \
+  static std::shared_ptr<mmt::isobmff::box::IBox> createWriteBox(                          \
+      const mmt::isobmff::box::CBox::SBoxWriteConfig& boxData,                             \
+      const mmt::isobmff::box::BoxAllocator& allocator) {                                  \
+    return std::allocate_shared<boxtype>(allocator,                                        \
+                                         dynamic_cast<const writeconfigtype&>(boxData));   \
+  }                                                                                        \
   struct ISOBMFF_UNIQVARNAME(boxregistry_functions) {}
 
 #define BOXREGISTRY_REGISTER_FOURCC_FCC(fourcc, fourcc_string, container_type)    \
@@ -102,7 +102,7 @@ namespace isobmff {
 namespace box {
 
 //! co64 box according to ISO 14496-12
-class CChunkOffset64Box : public virtual CFullBox {
+class CChunkOffset64Box final : public CFullBox {
  public:
   struct SCo64BoxWriteConfig : SFullBoxWriteConfig {
     std::vector<uint64_t> chunkOffsets;
@@ -110,6 +110,9 @@ class CChunkOffset64Box : public virtual CFullBox {
     SCo64BoxWriteConfig() : SFullBoxWriteConfig(ilo::toFcc("co64"), 0, 0) {}
   };
 
+  EBoxKind kind() const override { return EBoxKind::chunkOffset64; }
+  static bool classof(const IBox& box) { return box.kind() == EBoxKind::chunkOffset64; }
+
   //! constructor to init member variables through parsing
   CChunkOffset64Box(ilo::ByteBuffer::const_iterator& begin,
                     const ilo::ByteBuffer::const_iterator& end);
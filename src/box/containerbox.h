@@ -102,7 +102,7 @@ namespace mmt {
 namespace isobmff {
 namespace box {
 
-class CContainerBox : public CBox {
+class CContainerBox final : public CBox {
  public:
   using SharedBoxWriteConfigVector = std::vector<std::shared_ptr<SBoxWriteConfig>>;
 
@@ -110,6 +110,9 @@ class CContainerBox : public CBox {
     SContainerBoxWriteConfig(ilo::Fourcc fourcc) : SBoxWriteConfig(fourcc) {}
   };
 
+  EBoxKind kind() const override { return EBoxKind::container; }
+  static bool classof(const IBox& box) { return box.kind() == EBoxKind::container; }
+
   CContainerBox(ilo::ByteBuffer::const_iterator& begin, const ilo::ByteBuffer::const_iterator& end);
 
   explicit CContainerBox(const SContainerBoxWriteConfig& containerWriteConfig);
@@ -102,7 +102,7 @@ namespace isobmff {
 namespace box {
 
 //! ctts box according to ISO 14496-12
-class CCompositionTimeToSampleBox : public CFullBox {
+class CCompositionTimeToSampleBox final : public CFullBox {
  public:
   struct SCttsEntry {
     uint32_t sampleCount = 0;
@@ -116,6 +116,9 @@ class CCompositionTimeToSampleBox : public CFullBox {
     SCttsBoxWriteConfig() : SFullBoxWriteConfig(ilo::toFcc("ctts"), 0, 0) {}
   };
 
+  EBoxKind kind() const override { return EBoxKind::compositionTimeToSample; }
+  static bool classof(const IBox& box) { return box.kind() == EBoxKind::compositionTimeToSample; }
+
   //! constructor to init member variables through parsing
   CCompositionTimeToSampleBox(ilo::ByteBuffer::const_iterator& begin,
                               const ilo::ByteBuffer::const_iterator& end);
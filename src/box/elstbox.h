@@ -102,7 +102,7 @@ namespace isobmff {
 namespace box {
 
 //! Edit List box according to ISO 14496-12
-class CEditListBox : public CFullBox {
+class CEditListBox final : public CFullBox {
  public:
   struct SElstEntry {
     uint64_t segmentDuration = 0;
@@ -118,6 +118,9 @@ class CEditListBox : public CFullBox {
     SEditListBoxWriteConfig() : SFullBoxWriteConfig(ilo::toFcc("elst"), 0, 0) {}
   };
 
+  EBoxKind kind() const override { return EBoxKind::editList; }
+  static bool classof(const IBox& box) { return box.kind() == EBoxKind::editList; }
+
   //! constructor to init member variables through parsing
   CEditListBox(ilo::ByteBuffer::const_iterator& begin, const ilo::ByteBuffer::const_iterator& end);
 
@@ -102,7 +102,7 @@ namespace isobmff {
 namespace box {
 
 //! Ftype box according to ISO 14496-12
-class CFileTypeBox : public CBox {
+class CFileTypeBox final : public CBox {
  public:
   struct SFtypBoxWriteConfig : CBox::SBoxWriteConfig {
     uint32_t minorVersion = 0;
@@ -112,6 +112,9 @@ class CFileTypeBox : public CBox {
     SFtypBoxWriteConfig() : SBoxWriteConfig(ilo::toFcc("ftyp")), majorBrand(ilo::toFcc("0000")) {}
   };
 
+  EBoxKind kind() const override { return EBoxKind::fileType; }
+  static bool classof(const IBox& box) { return box.kind() == EBoxKind::fileType; }
+
   //! constructor to init member variables through parsing
   CFileTypeBox(ilo::ByteBuffer::const_iterator& begin, const ilo::ByteBuffer::const_iterator& end);
 
@@ -102,7 +102,7 @@ namespace mmt {
 namespace isobmff {
 namespace box {
 
-class CHandlerReferenceBox : public CFullBox {
+class CHandlerReferenceBox final : public CFullBox {
  public:
   struct SHdlrBoxWriteConfig : SFullBoxWriteConfig {
     SHdlrBoxWriteConfig()
@@ -112,6 +112,9 @@ class CHandlerReferenceBox : public CFullBox {
     std::string name;
   };
 
+  EBoxKind kind() const override { return EBoxKind::handlerReference; }
+  static bool classof(const IBox& box) { return box.kind() == EBoxKind::handlerReference; }
+
   //! constructor to init member variables through parsing
   CHandlerReferenceBox(ilo::ByteBuffer::const_iterator& begin,
                        const ilo::ByteBuffer::const_iterator& end);
@@ -87,6 +87,9 @@ amm-info@iis.fraunhofer.de
 
 #pragma once
 
+// System headers
+#include <memory>
+
 // External headers
 #include "ilo/common_types.h"
 
@@ -97,6 +100,41 @@ namespace mmt {
 namespace isobmff {
 namespace box {
 
+/*!
+ * Kinds of box classes that can be identified without RTTI (see boxCast)
+ *
+ * Only final classes get a kind of their own. All other classes report unspecified.
+ */
+enum class EBoxKind : uint8_t {
+  unspecified,
+  lazy,
+  container,
+  fileType,
+  movieHeader,
+  trackHeader,
+  editList,
+  mediaHeader,
+  handlerReference,
+  sampleDescription,
+  decodingTimeToSample,
+  compositionTimeToSample,
+  syncSample,
+  sampleToChunk,
+  sampleSize,
+  compactSampleSize,
+  chunkOffset,
+  chunkOffset64,
+  sampleToGroup,
+  sampleGroupDescription,
+  trackExtends,
+  movieFragmentHeader,
+  trackFragmentHeader,
+  trackFragmentDecodeTime,
+  trackRun,
+  segmentIndex,
+  objectDescriptor
+};
+
 //! Box after ISO 14496-12
 struct IBox {
   struct SBoxWriteConfig {
@@ -124,6 +162,9 @@ struct IBox {
   virtual void write(ilo::ByteBuffer& buffer, ilo::ByteBuffer::iterator& position) const = 0;
 
   virtual std::vector<SAttribute> getAttributeList() const = 0;
+
+  //! kind of the concrete box class
+  virtual EBoxKind kind() const { return EBoxKind::unspecified; }
 };
 
 //! FullBox after ISO 14496-12
@@ -145,6 +186,33 @@ struct IFullBox {
   virtual uint8_t version() const = 0;
 };
 
+namespace detail {
+template <class type>
+auto boxCast(const std::shared_ptr<IBox>& box, int)
+    -> decltype(type::classof(*box), std::shared_ptr<type>()) {
+  return type::classof(*box) ? std::static_pointer_cast<type>(box) : nullptr;
+}
+
+template <class type>
+std::shared_ptr<type> boxCast(const std::shared_ptr<IBox>& box, long) {
+  return std::dynamic_pointer_cast<type>(box);
+}
+}  // namespace detail
+
+/*!
+ * cast a box to the requested type, nullptr if the box is not of that type
+ *
+ * Classes with a kind of their own provide classof and are checked by their kind tag. Base
+ * classes and interfaces fall back to a dynamic cast.
+ */
+template <class type>
+std::shared_ptr<type> boxCast(const std::shared_ptr<IBox>& box) {
+  if (box == nullptr) {
+    return nullptr;
+  }
+  return detail::boxCast<type>(box, 0);
+}
+
 }  // namespace box
 }  // namespace isobmff
 }  // namespace mmt
@@ -100,7 +100,7 @@ namespace mmt {
 namespace isobmff {
 namespace box {
 
-class CObjectDescriptorBox : public CFullBox {
+class CObjectDescriptorBox final : public CFullBox {
  public:
   struct SIodsBoxWriteConfig : SFullBoxWriteConfig {
     uint8_t audioProfileLevelIndication;
@@ -110,6 +110,9 @@ class CObjectDescriptorBox : public CFullBox {
         : SFullBoxWriteConfig(ilo::toFcc("iods"), 0, 0), audioProfileLevelIndication(0) {}
   };
 
+  EBoxKind kind() const override { return EBoxKind::objectDescriptor; }
+  static bool classof(const IBox& box) { return box.kind() == EBoxKind::objectDescriptor; }
+
   //! constructor to init member variables through parsing
   CObjectDescriptorBox(ilo::ByteBuffer::const_iterator& begin,
                        const ilo::ByteBuffer::const_iterator& end);
@@ -0,0 +1,151 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2025 - 2026 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+/*
+ * Project: MPEG-4 ISO Base Media File Format (ISO BMFF) library
+ * Content: box wrapper deferring payload parsing until first access
+ */
+
+// External headers
+#include "ilo/bytebuffertools.h"
+
+// Internal headers
+#include "lazybox.h"
+#include "common/logging.h"
+#include "common/bytebuffertools_extension.h"
+
+namespace mmt {
+namespace isobmff {
+namespace box {
+
+CLazyBox::CLazyBox(const std::shared_ptr<const ilo::ByteBuffer>& buffer,
+                   ilo::ByteBuffer::const_iterator begin, ilo::ByteBuffer::const_iterator end,
+                   const ParseCreateFunction& parseCreate)
+    : m_buffer(buffer),
+      m_offset(static_cast<size_t>(begin - buffer->begin())),
+      m_length(static_cast<size_t>(end - begin)),
+      m_parseCreate(parseCreate) {
+  ILO_ASSERT(m_parseCreate, "No parse function given for lazy box");
+  BoxSizeType boxSizeType = tools::getBoxSizeAndType(begin, end);
+  m_size = boxSizeType.size;
+  m_type = boxSizeType.type;
+  m_had64BitSizeInInput = boxSizeType.headerLengthInBytes > 8;
+  if (m_size == 0) {
+    m_size = static_cast<uint64_t>(m_length);  // box extends to the end of the buffer
+  }
+}
+
+uint64_t CLazyBox::size() const {
+  if (isParsed()) {
+    return m_box->size();
+  }
+  return m_size;
+}
+
+void CLazyBox::updateSize(uint64_t size) {
+  box()->updateSize(size);
+}
+
+void CLazyBox::write(ilo::ByteBuffer& buffer, ilo::ByteBuffer::iterator& position) const {
+  box()->write(buffer, position);
+}
+
+SAttributeList CLazyBox::getAttributeList() const {
+  return box()->getAttributeList();
+}
+
+const std::shared_ptr<IBox>& CLazyBox::box() const {
+  std::call_once(m_parseOnce, [this]() {
+    auto begin = m_buffer->begin() + static_cast<std::ptrdiff_t>(m_offset);
+    auto end = begin + static_cast<std::ptrdiff_t>(m_length);
+    m_box = m_parseCreate(begin, end);
+    m_parsed.store(true, std::memory_order_release);
+    if (begin != end) {
+      ILO_LOG_WARNING("box was not fully parsed: %s", ilo::toString(m_type).c_str());
+    }
+  });
+  return m_box;
+}
+
+}  // namespace box
+}  // namespace isobmff
+}  // namespace mmt
@@ -102,7 +102,7 @@ namespace mmt {
 namespace isobmff {
 namespace box {
 
-class CMediaHeaderBox : public CFullBox {
+class CMediaHeaderBox final : public CFullBox {
  public:
   struct SMdhdBoxWriteConfig : SFullBoxWriteConfig {
     uint64_t creationTime = 0;
@@ -115,6 +115,9 @@ class CMediaHeaderBox : public CFullBox {
         : SFullBoxWriteConfig(ilo::toFcc("mdhd"), 0, 0), language(ilo::toIsoLang("und")) {}
   };
 
+  EBoxKind kind() const override { return EBoxKind::mediaHeader; }
+  static bool classof(const IBox& box) { return box.kind() == EBoxKind::mediaHeader; }
+
   //! constructor to init member variables through parsing
   CMediaHeaderBox(ilo::ByteBuffer::const_iterator& begin,
                   const ilo::ByteBuffer::const_iterator& end);
@@ -99,7 +99,7 @@ namespace mmt {
 namespace isobmff {
 namespace box {
 
-class CMovieFragmentHeaderBox : public CFullBox {
+class CMovieFragmentHeaderBox final : public CFullBox {
  public:
   struct SMfhdBoxWriteConfig : SFullBoxWriteConfig {
     uint32_t sequenceNumber;
@@ -107,6 +107,9 @@ class CMovieFragmentHeaderBox : public CFullBox {
     SMfhdBoxWriteConfig() : SFullBoxWriteConfig(ilo::toFcc("mfhd"), 0, 0), sequenceNumber(1) {}
   };
 
+  EBoxKind kind() const override { return EBoxKind::movieFragmentHeader; }
+  static bool classof(const IBox& box) { return box.kind() == EBoxKind::movieFragmentHeader; }
+
   //! constructor to init member variables through parsing
   CMovieFragmentHeaderBox(ilo::ByteBuffer::const_iterator& begin,
                           const ilo::ByteBuffer::const_iterator& end);
@@ -103,7 +103,7 @@ namespace mmt {
 namespace isobmff {
 namespace box {
 
-class CMovieHeaderBox : public CFullBox {
+class CMovieHeaderBox final : public CFullBox {
  public:
   struct SMvhdBoxWriteConfig : SFullBoxWriteConfig {
     uint64_t creationTime = 0;
@@ -120,6 +120,9 @@ class CMovieHeaderBox : public CFullBox {
           matrix({0x00010000, 0, 0, 0, 0x00010000, 0, 0, 0, 0x40000000}) {}
   };
 
+  EBoxKind kind() const override { return EBoxKind::movieHeader; }
+  static bool classof(const IBox& box) { return box.kind() == EBoxKind::movieHeader; }
+
   //! constructor to init member variables through parsing
   CMovieHeaderBox(ilo::ByteBuffer::const_iterator& begin,
                   const ilo::ByteBuffer::const_iterator& end);
@@ -100,7 +100,7 @@ amm-info@iis.fraunhofer.de
 namespace mmt {
 namespace isobmff {
 namespace box {
-class CSampleToGroupBox : public CFullBox {
+class CSampleToGroupBox final : public CFullBox {
  public:
   struct SSampleGroupEntry {
     SSampleGroupEntry(const uint32_t& sSampleCount, const uint32_t& sGroupDescriptionIndex)
@@ -121,6 +121,9 @@ class CSampleToGroupBox : public CFullBox {
         : SFullBoxWriteConfig(ilo::toFcc("sbgp"), boxVer, 0) {}
   };
 
+  EBoxKind kind() const override { return EBoxKind::sampleToGroup; }
+  static bool classof(const IBox& box) { return box.kind() == EBoxKind::sampleToGroup; }
+
   //! constructor to init member variables through parsing
   CSampleToGroupBox(ilo::ByteBuffer::const_iterator& begin,
                     const ilo::ByteBuffer::const_iterator& end);
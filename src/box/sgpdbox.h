@@ -101,7 +101,7 @@ amm-info@iis.fraunhofer.de
 namespace mmt {
 namespace isobmff {
 namespace box {
-class CSampleGroupDescriptionBox : public CFullBox {
+class CSampleGroupDescriptionBox final : public CFullBox {
  public:
   struct SSampleGroupDescriptionEntry {
     std::shared_ptr<CSampleGroupEntry> sampleGroupEntry;
@@ -118,6 +118,9 @@ class CSampleGroupDescriptionBox : public CFullBox {
         : SFullBoxWriteConfig(ilo::toFcc("sgpd"), boxVersion, 0) {}
   };
 
+  EBoxKind kind() const override { return EBoxKind::sampleGroupDescription; }
+  static bool classof(const IBox& box) { return box.kind() == EBoxKind::sampleGroupDescription; }
+
   //! constructor to init member variables through parsing
   CSampleGroupDescriptionBox(ilo::ByteBuffer::const_iterator& begin,
                              const ilo::ByteBuffer::const_iterator& end);
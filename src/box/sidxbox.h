@@ -102,7 +102,7 @@ namespace mmt {
 namespace isobmff {
 namespace box {
 
-class CSegmentIndexBox : public CFullBox {
+class CSegmentIndexBox final : public CFullBox {
  public:
   struct SSidxReference {
     bool referenceType = false;
@@ -123,6 +123,9 @@ class CSegmentIndexBox : public CFullBox {
     SSidxBoxWriteConfig() : SFullBoxWriteConfig(ilo::toFcc("sidx"), 0, 0) {}
   };
 
+  EBoxKind kind() const override { return EBoxKind::segmentIndex; }
+  static bool classof(const IBox& box) { return box.kind() == EBoxKind::segmentIndex; }
+
   //! constructor to init member variables through parsing
   CSegmentIndexBox(ilo::ByteBuffer::const_iterator& begin,
                    const ilo::ByteBuffer::const_iterator& end);
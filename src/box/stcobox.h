@@ -102,7 +102,7 @@ namespace isobmff {
 namespace box {
 
 //! stco box according to ISO 14496-12
-class CChunkOffsetBox : public virtual CFullBox {
+class CChunkOffsetBox final : public CFullBox {
  public:
   struct SStcoBoxWriteConfig : SFullBoxWriteConfig {
     std::vector<uint32_t> chunkOffsets;
@@ -110,6 +110,9 @@ class CChunkOffsetBox : public virtual CFullBox {
     SStcoBoxWriteConfig() : SFullBoxWriteConfig(ilo::toFcc("stco"), 0, 0) {}
   };
 
+  EBoxKind kind() const override { return EBoxKind::chunkOffset; }
+  static bool classof(const IBox& box) { return box.kind() == EBoxKind::chunkOffset; }
+
   //! constructor to init member variables through parsing
   CChunkOffsetBox(ilo::ByteBuffer::const_iterator& begin,
                   const ilo::ByteBuffer::const_iterator& end);
@@ -102,7 +102,7 @@ namespace isobmff {
 namespace box {
 
 //! stsc box according to ISO 14496-12
-class CSampleToChunkBox : public CFullBox {
+class CSampleToChunkBox final : public CFullBox {
  public:
   struct SStscEntry {
     SStscEntry(uint32_t first_chnk = 0, uint32_t samples_per_chnk = 0,
@@ -123,6 +123,9 @@ class CSampleToChunkBox : public CFullBox {
     SStscBoxWriteConfig() : SFullBoxWriteConfig(ilo::toFcc("stsc"), 0, 0) {}
   };
 
+  EBoxKind kind() const override { return EBoxKind::sampleToChunk; }
+  static bool classof(const IBox& box) { return box.kind() == EBoxKind::sampleToChunk; }
+
   //! constructor to init member variables through parsing
   CSampleToChunkBox(ilo::ByteBuffer::const_iterator& begin,
                     const ilo::ByteBuffer::const_iterator& end);
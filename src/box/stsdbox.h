@@ -95,7 +95,7 @@ namespace mmt {
 namespace isobmff {
 namespace box {
 
-class CSampleDescriptionBox : public CFullBox {
+class CSampleDescriptionBox final : public CFullBox {
  public:
   struct SStsdBoxWriteConfig : SFullBoxWriteConfig {
     uint32_t entryCount = 0;
@@ -103,6 +103,9 @@ class CSampleDescriptionBox : public CFullBox {
     SStsdBoxWriteConfig(uint8_t boxVer) : SFullBoxWriteConfig(ilo::toFcc("stsd"), boxVer, 0) {}
   };
 
+  EBoxKind kind() const override { return EBoxKind::sampleDescription; }
+  static bool classof(const IBox& box) { return box.kind() == EBoxKind::sampleDescription; }
+
   //! constructor to init member variables through parsing
   CSampleDescriptionBox(ilo::ByteBuffer::const_iterator& begin,
                         const ilo::ByteBuffer::const_iterator& end);
@@ -99,7 +99,7 @@ namespace isobmff {
 namespace box {
 
 //! stss box according to ISO 14496-12
-class CSyncSampleTableBox : public CFullBox {
+class CSyncSampleTableBox final : public CFullBox {
  public:
   struct SStssEntry {
     SStssEntry(uint32_t sample_number = 0) : sampleNumber(sample_number) {}
@@ -116,6 +116,9 @@ class CSyncSampleTableBox : public CFullBox {
     }
   };
 
+  EBoxKind kind() const override { return EBoxKind::syncSample; }
+  static bool classof(const IBox& box) { return box.kind() == EBoxKind::syncSample; }
+
   //! constructor to init member variables through parsing
   CSyncSampleTableBox(ilo::ByteBuffer::const_iterator& begin,
                       const ilo::ByteBuffer::const_iterator& end);
@@ -101,7 +101,7 @@ namespace mmt {
 namespace isobmff {
 namespace box {
 
-class CSampleSizeBox : public CFullBox {
+class CSampleSizeBox final : public CFullBox {
  public:
   struct SStszBoxWriteConfig : SFullBoxWriteConfig {
     uint32_t sampleSize = 0;
@@ -111,6 +111,9 @@ class CSampleSizeBox : public CFullBox {
     SStszBoxWriteConfig() : SFullBoxWriteConfig(ilo::toFcc("stsz"), 0, 0) {}
   };
 
+  EBoxKind kind() const override { return EBoxKind::sampleSize; }
+  static bool classof(const IBox& box) { return box.kind() == EBoxKind::sampleSize; }
+
   //! constructor to init member variables through parsing
   CSampleSizeBox(ilo::ByteBuffer::const_iterator& begin,
                  const ilo::ByteBuffer::const_iterator& end);
@@ -123,7 +126,7 @@ class CSampleSizeBox : public CFullBox {
 
   uint32_t sampleCount() const { return m_sampleCount; }
 
-  std::vector<uint32_t> entrySize() const { return m_entrySize; }
+  const std::vector<uint32_t>& entrySize() const { return m_entrySize; }
 
   SAttributeList getAttributeList() const override;
 
@@ -99,7 +99,7 @@ namespace isobmff {
 namespace box {
 
 //! stts box according to ISO 14496-12
-class CDecodingTimeToSampleBox : public CFullBox {
+class CDecodingTimeToSampleBox final : public CFullBox {
  public:
   struct SSttsEntry {
     SSttsEntry(uint32_t sample_count = 0, uint32_t sample_delta = 0)
@@ -119,6 +119,9 @@ class CDecodingTimeToSampleBox : public CFullBox {
     }
   };
 
+  EBoxKind kind() const override { return EBoxKind::decodingTimeToSample; }
+  static bool classof(const IBox& box) { return box.kind() == EBoxKind::decodingTimeToSample; }
+
   //! constructor to init member variables through parsing
   CDecodingTimeToSampleBox(ilo::ByteBuffer::const_iterator& begin,
                            const ilo::ByteBuffer::const_iterator& end);
@@ -101,7 +101,7 @@ namespace mmt {
 namespace isobmff {
 namespace box {
 
-class CCompactSampleSizeBox : public CFullBox {
+class CCompactSampleSizeBox final : public CFullBox {
  public:
   enum class EFieldSize { fieldSize4, fieldSize8, fieldSize16 };
 
@@ -113,6 +113,9 @@ class CCompactSampleSizeBox : public CFullBox {
     std::vector<uint16_t> entrySizes;
   };
 
+  EBoxKind kind() const override { return EBoxKind::compactSampleSize; }
+  static bool classof(const IBox& box) { return box.kind() == EBoxKind::compactSampleSize; }
+
   //! constructor to init member variables through parsing
   CCompactSampleSizeBox(ilo::ByteBuffer::const_iterator& begin,
                         const ilo::ByteBuffer::const_iterator& end);
@@ -125,7 +128,7 @@ class CCompactSampleSizeBox : public CFullBox {
 
   uint32_t sampleCount() const { return m_sampleCount; }
 
-  std::vector<uint16_t> entrySizes() const { return m_entrySizes; }
+  const std::vector<uint16_t>& entrySizes() const { return m_entrySizes; }
 
   SAttributeList getAttributeList() const override;
 
@@ -101,7 +101,7 @@ namespace mmt {
 namespace isobmff {
 namespace box {
 
-class CTrackFragmentMDTBox : public CFullBox {
+class CTrackFragmentMDTBox final : public CFullBox {
  public:
   struct STfdtBoxWriteConfig : SFullBoxWriteConfig {
     uint64_t baseMediaDecodeTime = 0;
@@ -109,6 +109,9 @@ class CTrackFragmentMDTBox : public CFullBox {
     STfdtBoxWriteConfig() : SFullBoxWriteConfig(ilo::toFcc("tfdt"), 0, 0) {}
   };
 
+  EBoxKind kind() const override { return EBoxKind::trackFragmentDecodeTime; }
+  static bool classof(const IBox& box) { return box.kind() == EBoxKind::trackFragmentDecodeTime; }
+
   //! constructor to init member variables through parsing
   CTrackFragmentMDTBox(ilo::ByteBuffer::const_iterator& begin,
                        const ilo::ByteBuffer::const_iterator& end);
@@ -102,7 +102,7 @@ namespace mmt {
 namespace isobmff {
 namespace box {
 
-class CTrackFragmentHeaderBox : public CFullBox {
+class CTrackFragmentHeaderBox final : public CFullBox {
  public:
   struct STfhdBoxWriteConfig : SFullBoxWriteConfig {
     uint32_t trackId = 0;
@@ -122,6 +122,9 @@ class CTrackFragmentHeaderBox : public CFullBox {
     STfhdBoxWriteConfig() : SFullBoxWriteConfig(ilo::toFcc("tfhd"), 0, 0) {}
   };
 
+  EBoxKind kind() const override { return EBoxKind::trackFragmentHeader; }
+  static bool classof(const IBox& box) { return box.kind() == EBoxKind::trackFragmentHeader; }
+
   //! constructor to init member variables through parsing
   CTrackFragmentHeaderBox(ilo::ByteBuffer::const_iterator& begin,
                           const ilo::ByteBuffer::const_iterator& end);
@@ -102,7 +102,7 @@ namespace mmt {
 namespace isobmff {
 namespace box {
 
-class CTrackHeaderBox : public CFullBox {
+class CTrackHeaderBox final : public CFullBox {
  public:
   struct STkhdBoxWriteConfig : CFullBox::SFullBoxWriteConfig {
     bool trackIsEnabled = true;
@@ -125,6 +125,9 @@ class CTrackHeaderBox : public CFullBox {
           matrix({0x00010000, 0, 0, 0, 0x00010000, 0, 0, 0, 0x40000000}) {}
   };
 
+  EBoxKind kind() const override { return EBoxKind::trackHeader; }
+  static bool classof(const IBox& box) { return box.kind() == EBoxKind::trackHeader; }
+
   //! constructor to init member variables through parsing
   CTrackHeaderBox(ilo::ByteBuffer::const_iterator& begin,
                   const ilo::ByteBuffer::const_iterator& end);
@@ -98,7 +98,7 @@ namespace mmt {
 namespace isobmff {
 namespace box {
 
-class CTrackExtendsBox : public CFullBox {
+class CTrackExtendsBox final : public CFullBox {
  public:
   struct STrexBoxWriteConfig : SFullBoxWriteConfig {
     uint32_t trackID = 0;
@@ -110,6 +110,9 @@ class CTrackExtendsBox : public CFullBox {
     STrexBoxWriteConfig() : SFullBoxWriteConfig(ilo::toFcc("trex"), 0, 0) {}
   };
 
+  EBoxKind kind() const override { return EBoxKind::trackExtends; }
+  static bool classof(const IBox& box) { return box.kind() == EBoxKind::trackExtends; }
+
   //! constructor to init member variables through parsing
   CTrackExtendsBox(ilo::ByteBuffer::const_iterator& begin,
                    const ilo::ByteBuffer::const_iterator& end);
@@ -133,7 +133,7 @@ class CTrunEntry {
   bool m_ctsOffsetPresent;
 };
 
-class CTrackRunBox : public CFullBox {
+class CTrackRunBox final : public CFullBox {
  public:
   struct STrunBoxWriteConfig : SFullBoxWriteConfig {
     bool dataOffsetPresent = false;
@@ -150,6 +150,9 @@ class CTrackRunBox : public CFullBox {
     STrunBoxWriteConfig() : SFullBoxWriteConfig(ilo::toFcc("trun"), 0, 301) {}
   };
 
+  EBoxKind kind() const override { return EBoxKind::trackRun; }
+  static bool classof(const IBox& box) { return box.kind() == EBoxKind::trackRun; }
+
   //! constructor to init member variables through parsing
   CTrackRunBox(ilo::ByteBuffer::const_iterator& begin, const ilo::ByteBuffer::const_iterator& end);
 
@@ -87,11 +87,26 @@ amm-info@iis.fraunhofer.de
 
 #pragma once
 
+// System includes
+#include <cstddef>
+#include <stdexcept>
+
 // Internal includes
 #include "mmtisobmff/types.h"
 
 namespace mmt {
 namespace isobmff {
+/*!
+ * Fourcc literal, e.g. "moov"_fcc
+ *
+ * Evaluated at compile time when used in a constant expression, so box type comparisons don't
+ * convert strings at runtime like ilo::toFcc does.
+ */
+constexpr ilo::Fourcc operator"" _fcc(const char* fcc, std::size_t length) {
+  return length == 4 ? ilo::Fourcc{{fcc[0], fcc[1], fcc[2], fcc[3]}}
+                     : throw std::invalid_argument("A fourcc must consist of exactly 4 characters");
+}
+
 //! Basic generic box information valid for all boxes
 struct BoxSizeType {
   /*!
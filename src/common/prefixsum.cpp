@@ -0,0 +1,174 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2025 - 2026 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+/*
+ * Project: MPEG-4 ISO Base Media File Format (ISO BMFF) library
+ * Content: prefix sums used to expand sample tables
+ */
+
+// System includes
+#if defined(__AVX2__)
+// The compiler targets AVX2, no dispatch needed
+#define MMTISOBMFF_PREFIX_SUM_AVX2
+#define MMTISOBMFF_AVX2_TARGET
+#include <immintrin.h>
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+// AVX2 is compiled for this function only and selected at runtime
+#define MMTISOBMFF_PREFIX_SUM_AVX2
+#define MMTISOBMFF_PREFIX_SUM_DISPATCH
+#define MMTISOBMFF_AVX2_TARGET __attribute__((target("avx2")))
+#include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+// Internal includes
+#include "prefixsum.h"
+
+namespace mmt {
+namespace isobmff {
+namespace tools {
+namespace {
+#if defined(MMTISOBMFF_PREFIX_SUM_AVX2)
+bool hasAvx2() {
+#if defined(MMTISOBMFF_PREFIX_SUM_DISPATCH)
+  static const bool supported = __builtin_cpu_supports("avx2") != 0;
+  return supported;
+#else
+  return true;
+#endif
+}
+
+//! Sums blocks of 8 values, returns the number of values processed and updates carry
+MMTISOBMFF_AVX2_TARGET size_t exclusivePrefixSumAvx2(const uint32_t* values, size_t count,
+                                                     uint32_t& carry, uint32_t* sums) {
+  size_t i = 0;
+  __m256i carryVec = _mm256_set1_epi32(static_cast<int>(carry));
+  for (; i + 8 <= count; i += 8) {
+    __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+    // Inclusive scan within both 128 bit lanes
+    __m256i scan = _mm256_add_epi32(in, _mm256_slli_si256(in, 4));
+    scan = _mm256_add_epi32(scan, _mm256_slli_si256(scan, 8));
+    // Add the total of the lower lane to the upper lane
+    __m256i lowerTotal = _mm256_shuffle_epi32(_mm256_permute2x128_si256(scan, scan, 0x08), 0xFF);
+    scan = _mm256_add_epi32(scan, lowerTotal);
+
+    __m256i out = _mm256_add_epi32(carryVec, _mm256_sub_epi32(scan, in));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(sums + i), out);
+    carryVec = _mm256_add_epi32(carryVec,
+                                _mm256_permutevar8x32_epi32(scan, _mm256_set1_epi32(7)));
+  }
+  carry = static_cast<uint32_t>(_mm256_extract_epi32(carryVec, 0));
+  return i;
+}
+#endif
+}  // namespace
+
+void exclusivePrefixSum(const uint32_t* values, size_t count, uint32_t start, uint32_t* sums) {
+  size_t i = 0;
+  uint32_t carry = start;
+
+#if defined(MMTISOBMFF_PREFIX_SUM_AVX2)
+  if (hasAvx2()) {
+    i = exclusivePrefixSumAvx2(values, count, carry, sums);
+  }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+  const uint32x4_t zero = vdupq_n_u32(0);
+  uint32x4_t carryVec = vdupq_n_u32(carry);
+  for (; i + 4 <= count; i += 4) {
+    uint32x4_t in = vld1q_u32(values + i);
+    uint32x4_t scan = vaddq_u32(in, vextq_u32(zero, in, 3));
+    scan = vaddq_u32(scan, vextq_u32(zero, scan, 2));
+
+    vst1q_u32(sums + i, vaddq_u32(carryVec, vsubq_u32(scan, in)));
+    carryVec = vaddq_u32(carryVec, vdupq_n_u32(vgetq_lane_u32(scan, 3)));
+  }
+  carry = vgetq_lane_u32(carryVec, 0);
+#endif
+
+  for (; i < count; ++i) {
+    sums[i] = carry;
+    carry += values[i];
+  }
+}
+}  // namespace tools
+}  // namespace isobmff
+}  // namespace mmt
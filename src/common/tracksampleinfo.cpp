@@ -0,0 +1,372 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2025 - 2026 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+/*
+ * Project: MPEG-4 ISO Base Media File Format (ISO BMFF) library
+ * Content: columnar sample table
+ */
+
+// System includes
+#include <limits>
+#include <numeric>
+
+// Internal includes
+#include "tracksampleinfo.h"
+#include "prefixsum.h"
+
+namespace mmt {
+namespace isobmff {
+namespace {
+//! Replaces the vector by a copy of exactly its size allocated from resource
+template <class T>
+void moveToResource(ResourceVector<T>& values, const std::shared_ptr<IMemoryResource>& resource) {
+  values = ResourceVector<T>(values.begin(), values.end(), CResourceAllocator<T>(resource));
+}
+}  // namespace
+
+CMetaSample CTrackSampleInfo::operator[](size_t sampleIndex) const {
+  ILO_ASSERT_WITH(sampleIndex < size(), std::out_of_range, "Sample index is out of range");
+  return CMetaSample(sampleOffset(sampleIndex), sampleSize(sampleIndex),
+                     sampleDuration(sampleIndex), ctsOffset(sampleIndex), dtsValue(sampleIndex),
+                     m_fragmentNumberRuns.at(sampleIndex), isSyncSample(sampleIndex), m_trackId,
+                     m_timeScale, m_sampleGroupInfoRuns.at(sampleIndex));
+}
+
+size_t CTrackSampleInfo::firstSampleStartingAt(uint64_t time) const {
+  if (time == 0 || m_timingRunStarts.empty()) {
+    return 0;
+  }
+  // Tracks of constant duration consist of a single run starting at 0, so no search is needed.
+  // Otherwise the runs starting before time form a prefix, the sample is in the last of them or
+  // starts the next one.
+  size_t run = 0;
+  if (!hasConstantDuration()) {
+    auto nextRun = std::lower_bound(m_timingRunStarts.begin(), m_timingRunStarts.end(), time);
+    run = static_cast<size_t>(nextRun - m_timingRunStarts.begin()) - 1;
+  }
+  const auto& timingRun = m_timingRuns.runs()[run];
+  const size_t runLength = m_timingRuns.runLength(run);
+  if (timingRun.value.duration != 0) {
+    const uint64_t remaining = time - m_timingRunStarts[run];
+    const uint64_t sampleInRun = (remaining - 1) / timingRun.value.duration + 1;
+    if (sampleInRun < runLength) {
+      return timingRun.firstSample + static_cast<size_t>(sampleInRun);
+    }
+  }
+  return timingRun.firstSample + runLength;
+}
+
+int64_t CTrackSampleInfo::dtsValue(size_t sampleIndex) const {
+  const auto& run = m_timingRuns.run(sampleIndex);
+  return run.value.dtsValue +
+         static_cast<int64_t>(run.value.duration * (sampleIndex - run.firstSample));
+}
+
+void CTrackSampleInfo::push_back(const CMetaSample& sample) {
+  appendSize(sample.size);
+  appendOffset(sample.offset);
+  appendTiming(sample.duration, sample.dtsValue);
+  appendCtsOffset(sample.ctsOffset);
+  appendFragmentNumber(sample.fragmentNumber);
+  appendSyncSamples(sample.isSyncSample);
+  appendSampleGroupInfo(sample.sampleGroupInfo);
+}
+
+void CTrackSampleInfo::appendSize(uint64_t size, size_t count) {
+  ILO_ASSERT(size <= std::numeric_limits<uint32_t>::max(),
+             "Sample sizes larger than 32 bit are not supported");
+  m_sizes.insert(m_sizes.end(), count, static_cast<uint32_t>(size));
+  if (count > 0) {
+    m_maxSampleSize = std::max(m_maxSampleSize, static_cast<uint32_t>(size));
+  }
+}
+
+void CTrackSampleInfo::appendSizes(const uint32_t* sizes, size_t count) {
+  uint32_t maxSize = m_maxSampleSize;
+  for (size_t i = 0; i < count; ++i) {
+    maxSize = std::max(maxSize, sizes[i]);
+  }
+  m_sizes.insert(m_sizes.end(), sizes, sizes + count);
+  m_maxSampleSize = maxSize;
+}
+
+void CTrackSampleInfo::appendSizes(const uint16_t* sizes, size_t count) {
+  m_sizes.reserve(m_sizes.size() + count);
+  uint32_t maxSize = m_maxSampleSize;
+  for (size_t i = 0; i < count; ++i) {
+    maxSize = std::max<uint32_t>(maxSize, sizes[i]);
+    m_sizes.push_back(sizes[i]);
+  }
+  m_maxSampleSize = maxSize;
+}
+
+void CTrackSampleInfo::appendChunk(uint64_t chunkOffset, size_t count) {
+  const size_t firstSample = m_offsetsInRun.size();
+  ILO_ASSERT(count <= m_sizes.size() - firstSample, "Chunk samples without size");
+  if (count == 0) {
+    return;
+  }
+
+  uint64_t chunkSize = 0;
+  for (size_t i = firstSample; i < firstSample + count; ++i) {
+    chunkSize += m_sizes[i];
+  }
+  ILO_ASSERT(chunkSize <= std::numeric_limits<uint64_t>::max() - chunkOffset,
+             "sample offset exceeds the maximum length!");
+  const uint64_t maxOffsetInRun = std::numeric_limits<uint32_t>::max();
+  if (chunkSize > maxOffsetInRun) {
+    // Offsets inside the chunk do not fit into 32 bit, place the samples one by one
+    uint64_t sampleOffset = chunkOffset;
+    for (size_t i = firstSample; i < firstSample + count; ++i) {
+      appendOffset(sampleOffset);
+      sampleOffset += m_sizes[i];
+    }
+    return;
+  }
+
+  // Continue the last run if the whole chunk is in reach of its base offset
+  uint64_t start = 0;
+  if (!m_offsetRuns.runs().empty() && chunkOffset >= m_offsetRuns.runs().back().value &&
+      chunkOffset - m_offsetRuns.runs().back().value <= maxOffsetInRun - chunkSize) {
+    start = chunkOffset - m_offsetRuns.runs().back().value;
+    m_offsetRuns.extendRun(count);
+  } else {
+    m_offsetRuns.startRun(chunkOffset, count);
+  }
+  m_offsetsInRun.resize(firstSample + count);
+  tools::exclusivePrefixSum(&m_sizes[firstSample], count, static_cast<uint32_t>(start),
+                            &m_offsetsInRun[firstSample]);
+}
+
+void CTrackSampleInfo::appendOffset(uint64_t offset) {
+  // Samples of a chunk or track run share the base offset of the first sample
+  if (!m_offsetRuns.runs().empty()) {
+    uint64_t baseOffset = m_offsetRuns.runs().back().value;
+    if (offset >= baseOffset && offset - baseOffset <= std::numeric_limits<uint32_t>::max()) {
+      m_offsetRuns.extendRun();
+      m_offsetsInRun.push_back(static_cast<uint32_t>(offset - baseOffset));
+      return;
+    }
+  }
+  m_offsetRuns.startRun(offset);
+  m_offsetsInRun.push_back(0);
+}
+
+void CTrackSampleInfo::appendOffsetRun(uint64_t baseOffset, const uint32_t* offsetsInRun,
+                                       size_t count) {
+  m_offsetRuns.startRun(baseOffset, count);
+  m_offsetsInRun.insert(m_offsetsInRun.end(), offsetsInRun, offsetsInRun + count);
+}
+
+void CTrackSampleInfo::appendTiming(uint64_t duration, int64_t dtsValue, size_t count) {
+  if (count == 0) {
+    return;
+  }
+  const uint64_t runStart = m_durationSum;
+  m_durationSum += duration * count;
+  // Continue the last run if the samples follow it seamlessly with the same duration
+  if (!m_timingRuns.runs().empty()) {
+    const auto& lastRun = m_timingRuns.runs().back();
+    size_t lastRunLength = m_timingRuns.runLength(m_timingRuns.runs().size() - 1);
+    if (lastRun.value.duration == duration &&
+        lastRun.value.dtsValue + static_cast<int64_t>(duration * lastRunLength) == dtsValue) {
+      m_timingRuns.extendRun(count);
+      return;
+    }
+  }
+  m_timingRuns.startRun(STiming{duration, dtsValue}, count);
+  m_timingRunStarts.push_back(runStart);
+}
+
+size_t CTrackSampleInfo::syncSampleCountUpTo(size_t sampleIndex) const {
+  if (m_allSyncSamples) {
+    return std::min(sampleIndex + 1, m_syncSamples.size());
+  }
+  auto next = std::upper_bound(m_syncSampleIndices.begin(), m_syncSampleIndices.end(),
+                               sampleIndex);
+  return static_cast<size_t>(next - m_syncSampleIndices.begin());
+}
+
+void CTrackSampleInfo::appendSyncSamples(bool isSyncSample, size_t count) {
+  const size_t firstSample = m_syncSamples.size();
+  ILO_ASSERT(count <= std::numeric_limits<uint32_t>::max() - firstSample,
+             "Sample count exceeds the supported maximum");
+  if (count == 0) {
+    return;
+  }
+  if (!isSyncSample) {
+    storeSyncSampleIndices();
+  } else if (!m_allSyncSamples) {
+    for (size_t i = firstSample; i < firstSample + count; ++i) {
+      m_syncSampleIndices.push_back(static_cast<uint32_t>(i));
+    }
+  }
+  m_syncSamples.insert(m_syncSamples.end(), count, isSyncSample);
+}
+
+void CTrackSampleInfo::setSyncSample(size_t sampleIndex) {
+  if (m_syncSamples.at(sampleIndex)) {
+    return;
+  }
+  m_syncSamples[sampleIndex] = true;
+  // Sync samples are usually signaled in ascending order, others are sorted in
+  const auto index = static_cast<uint32_t>(sampleIndex);
+  if (m_syncSampleIndices.empty() || m_syncSampleIndices.back() < index) {
+    m_syncSampleIndices.push_back(index);
+  } else {
+    m_syncSampleIndices.insert(
+        std::upper_bound(m_syncSampleIndices.begin(), m_syncSampleIndices.end(), index), index);
+  }
+  if (m_syncSampleIndices.size() == m_syncSamples.size()) {
+    m_syncSampleIndices.clear();
+    m_allSyncSamples = true;
+  }
+}
+
+void CTrackSampleInfo::storeSyncSampleIndices() {
+  if (!m_allSyncSamples) {
+    return;
+  }
+  m_syncSampleIndices.resize(m_syncSamples.size());
+  std::iota(m_syncSampleIndices.begin(), m_syncSampleIndices.end(), 0u);
+  m_allSyncSamples = false;
+}
+
+void CTrackSampleInfo::appendSamples(const CTrackSampleInfo& other, int64_t dtsOffset) {
+  ILO_ASSERT(other.m_offsetsInRun.size() == other.size() &&
+                 other.m_timingRuns.sampleCount() == other.size() &&
+                 other.m_ctsOffsetRuns.sampleCount() == other.size() &&
+                 other.m_fragmentNumberRuns.sampleCount() == other.size() &&
+                 other.m_syncSamples.size() == other.size() &&
+                 other.m_sampleGroupInfoRuns.sampleCount() == other.size(),
+             "Appended sample table is incomplete");
+
+  m_sizes.insert(m_sizes.end(), other.m_sizes.begin(), other.m_sizes.end());
+  m_maxSampleSize = std::max(m_maxSampleSize, other.m_maxSampleSize);
+
+  // Offset runs are kept as they are, the in-run offsets refer to their base
+  const auto& offsetRuns = other.m_offsetRuns.runs();
+  for (size_t i = 0; i < offsetRuns.size(); ++i) {
+    m_offsetRuns.startRun(offsetRuns[i].value, other.m_offsetRuns.runLength(i));
+  }
+  m_offsetsInRun.insert(m_offsetsInRun.end(), other.m_offsetsInRun.begin(),
+                        other.m_offsetsInRun.end());
+
+  const auto& timingRuns = other.m_timingRuns.runs();
+  for (size_t i = 0; i < timingRuns.size(); ++i) {
+    appendTiming(timingRuns[i].value.duration, timingRuns[i].value.dtsValue + dtsOffset,
+                 other.m_timingRuns.runLength(i));
+  }
+
+  m_ctsOffsetRuns.append(other.m_ctsOffsetRuns);
+  m_fragmentNumberRuns.append(other.m_fragmentNumberRuns);
+  const size_t firstSample = m_syncSamples.size();
+  ILO_ASSERT(other.size() <= std::numeric_limits<uint32_t>::max() - firstSample,
+             "Sample count exceeds the supported maximum");
+  if (!other.m_allSyncSamples) {
+    storeSyncSampleIndices();
+    for (auto index : other.m_syncSampleIndices) {
+      m_syncSampleIndices.push_back(static_cast<uint32_t>(firstSample + index));
+    }
+  } else if (!m_allSyncSamples) {
+    for (size_t i = 0; i < other.size(); ++i) {
+      m_syncSampleIndices.push_back(static_cast<uint32_t>(firstSample + i));
+    }
+  }
+  m_syncSamples.insert(m_syncSamples.end(), other.m_syncSamples.begin(),
+                       other.m_syncSamples.end());
+  m_sampleGroupInfoRuns.append(other.m_sampleGroupInfoRuns);
+}
+
+void CTrackSampleInfo::shrinkToFit(const std::shared_ptr<IMemoryResource>& resource) {
+  moveToResource(m_sizes, resource);
+  moveToResource(m_offsetsInRun, resource);
+  m_offsetRuns.shrinkToFit(resource);
+  m_timingRuns.shrinkToFit(resource);
+  moveToResource(m_timingRunStarts, resource);
+  m_ctsOffsetRuns.shrinkToFit(resource);
+  m_fragmentNumberRuns.shrinkToFit(resource);
+  moveToResource(m_syncSamples, resource);
+  moveToResource(m_syncSampleIndices, resource);
+  m_sampleGroupInfoRuns.shrinkToFit(resource);
+}
+}  // namespace isobmff
+}  // namespace mmt
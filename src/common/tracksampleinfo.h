@@ -88,12 +88,17 @@ amm-info@iis.fraunhofer.de
 #pragma once
 
 // System includes
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <stdexcept>
 #include <vector>
 #include <map>
 
 // Internal includes
 #include "mmtisobmff/types.h"
+#include "common/logging.h"
+#include "common/resourceallocator.h"
 
 namespace mmt {
 namespace isobmff {
@@ -145,7 +150,261 @@ struct CMetaSample {
   SSampleGroupInfo sampleGroupInfo;
 };
 
-using CTrackSampleInfo = std::vector<CMetaSample>;
+/*!
+ * Index of the run containing the most recently looked up sample
+ *
+ * Only used as starting point for the next lookup, so it can be shared between threads without
+ * synchronization beyond the atomic access.
+ */
+class CRunHint {
+ public:
+  CRunHint() : m_run(0) {}
+  CRunHint(const CRunHint& other) : m_run(other.get()) {}
+  CRunHint& operator=(const CRunHint& other) {
+    set(other.get());
+    return *this;
+  }
+
+  size_t get() const { return m_run.load(std::memory_order_relaxed); }
+  void set(size_t run) const { m_run.store(run, std::memory_order_relaxed); }
+
+ private:
+  mutable std::atomic<size_t> m_run;
+};
+
+//! Sample property stored as runs of consecutive samples, looked up by sample index
+template <class T>
+class CSampleRuns {
+ public:
+  struct SRun {
+    size_t firstSample;
+    T value;
+  };
+
+  //! Appends count samples, extending the last run if it has the same value
+  void append(const T& value, size_t count = 1) {
+    if (!m_runs.empty() && m_runs.back().value == value) {
+      extendRun(count);
+    } else {
+      startRun(value, count);
+    }
+  }
+
+  //! Appends count samples as a new run
+  void startRun(const T& value, size_t count = 1) {
+    if (count == 0) {
+      return;
+    }
+    m_runs.push_back(SRun{m_sampleCount, value});
+    m_sampleCount += count;
+  }
+
+  //! Appends count samples to the last run
+  void extendRun(size_t count = 1) {
+    ILO_ASSERT(!m_runs.empty(), "No run to extend");
+    m_sampleCount += count;
+  }
+
+  //! Run containing the sample. Lookups of the same or the next run are O(1), others O(log n).
+  const SRun& run(size_t sampleIndex) const {
+    ILO_ASSERT_WITH(sampleIndex < m_sampleCount, std::out_of_range,
+                    "Sample index is out of range");
+    size_t hint = m_hint.get();
+    if (hint < m_runs.size() && contains(hint, sampleIndex)) {
+      return m_runs[hint];
+    }
+    if (hint + 1 < m_runs.size() && contains(hint + 1, sampleIndex)) {
+      m_hint.set(hint + 1);
+      return m_runs[hint + 1];
+    }
+
+    auto next = std::upper_bound(
+        m_runs.begin(), m_runs.end(), sampleIndex,
+        [](size_t index, const SRun& run) { return index < run.firstSample; });
+    size_t found = static_cast<size_t>(next - m_runs.begin()) - 1;
+    m_hint.set(found);
+    return m_runs[found];
+  }
+
+  const T& at(size_t sampleIndex) const { return run(sampleIndex).value; }
+
+  //! Number of samples in the run with the given index
+  size_t runLength(size_t run) const {
+    size_t end = run + 1 < m_runs.size() ? m_runs[run + 1].firstSample : m_sampleCount;
+    return end - m_runs[run].firstSample;
+  }
+
+  size_t sampleCount() const { return m_sampleCount; }
+  const ResourceVector<SRun>& runs() const { return m_runs; }
+  //! Moves the runs into an array of exactly their size allocated from resource
+  void shrinkToFit(const std::shared_ptr<IMemoryResource>& resource) {
+    m_runs = ResourceVector<SRun>(m_runs.begin(), m_runs.end(), CResourceAllocator<SRun>(resource));
+  }
+
+  //! Appends all runs of another column, merging its first run into the last one if equal
+  void append(const CSampleRuns& other) {
+    for (size_t i = 0; i < other.m_runs.size(); ++i) {
+      append(other.m_runs[i].value, other.runLength(i));
+    }
+  }
+
+ private:
+  bool contains(size_t run, size_t sampleIndex) const {
+    return m_runs[run].firstSample <= sampleIndex &&
+           (run + 1 == m_runs.size() || sampleIndex < m_runs[run + 1].firstSample);
+  }
+
+  ResourceVector<SRun> m_runs;
+  size_t m_sampleCount = 0;
+  CRunHint m_hint;
+};
+
+/*!
+ * Sample table of one track
+ *
+ * Stores the sample properties column by column instead of a CMetaSample per sample: sizes and
+ * sync flags per sample, offsets as 32 bit offsets into runs with a common 64 bit base (chunks or
+ * track runs), and durations, decoding times, composition offsets, fragment numbers and sample
+ * group information as runs of equal values. Track id and time scale are stored once.
+ *
+ * The table is built by appending every column in sample order. Once built it is shared read-only
+ * between all track readers of the track. Sample start times and sync samples are indexed while
+ * appending, so timestamps can be resolved without scanning the track. Tracks of constant sample
+ * duration and tracks consisting of sync samples only need no per sample index at all.
+ *
+ * While appending, the columns grow on the heap. shrinkToFit moves the finished table into the
+ * memory resource of the reader, so the growth of the columns does not waste arena memory.
+ */
+class CTrackSampleInfo {
+ public:
+  struct STiming {
+    uint64_t duration;
+    //! Decoding time of the first sample of the run
+    int64_t dtsValue;
+  };
+
+  explicit CTrackSampleInfo(uint32_t trackId = 0, uint32_t timeScale = 0)
+      : m_trackId(trackId), m_timeScale(timeScale) {}
+
+  size_t size() const { return m_sizes.size(); }
+  bool empty() const { return m_sizes.empty(); }
+
+  //! All properties of a sample
+  CMetaSample operator[](size_t sampleIndex) const;
+
+  uint32_t trackId() const { return m_trackId; }
+  uint32_t timeScale() const { return m_timeScale; }
+  uint64_t sampleSize(size_t sampleIndex) const { return m_sizes[sampleIndex]; }
+  uint64_t sampleOffset(size_t sampleIndex) const {
+    return m_offsetRuns.at(sampleIndex) + m_offsetsInRun[sampleIndex];
+  }
+  uint64_t sampleDuration(size_t sampleIndex) const {
+    return m_timingRuns.at(sampleIndex).duration;
+  }
+  int64_t dtsValue(size_t sampleIndex) const;
+  int64_t ctsOffset(size_t sampleIndex) const { return m_ctsOffsetRuns.at(sampleIndex); }
+  bool isSyncSample(size_t sampleIndex) const { return m_syncSamples[sampleIndex]; }
+
+  //! Largest sample size of the track, maintained while appending
+  uint64_t maxSampleSize() const { return m_maxSampleSize; }
+  //! Sum of all sample durations of the track, maintained while appending
+  uint64_t durationSum() const { return m_durationSum; }
+
+  /*!
+   * Index of the first sample starting at or after time, size() if there is none
+   *
+   * The start of a sample is the sum of the durations of all samples before it, in units of the
+   * time scale. O(1) for tracks of constant sample duration, O(log n) in the number of timing runs
+   * otherwise.
+   */
+  size_t firstSampleStartingAt(uint64_t time) const;
+  //! True if all samples have the same duration and follow each other without decoding time gaps
+  bool hasConstantDuration() const { return m_timingRuns.runs().size() <= 1; }
+
+  //! True if every sample is a sync sample, no sync sample index is stored in that case
+  bool allSyncSamples() const { return m_allSyncSamples; }
+  size_t syncSampleCount() const {
+    return m_allSyncSamples ? m_syncSamples.size() : m_syncSampleIndices.size();
+  }
+  //! Sample index of the n-th sync sample
+  size_t syncSampleIndex(size_t n) const {
+    return m_allSyncSamples ? n : m_syncSampleIndices.at(n);
+  }
+  //! Number of sync samples up to and including the sample
+  size_t syncSampleCountUpTo(size_t sampleIndex) const;
+
+  //! Columns of the table, used to store it in a sample index
+  const ResourceVector<uint32_t>& sizes() const { return m_sizes; }
+  const ResourceVector<uint32_t>& offsetsInRun() const { return m_offsetsInRun; }
+  const CSampleRuns<uint64_t>& offsetRuns() const { return m_offsetRuns; }
+  const CSampleRuns<STiming>& timingRuns() const { return m_timingRuns; }
+  const CSampleRuns<int64_t>& ctsOffsetRuns() const { return m_ctsOffsetRuns; }
+  const CSampleRuns<uint32_t>& fragmentNumberRuns() const { return m_fragmentNumberRuns; }
+  //! Empty if every sample is a sync sample
+  const ResourceVector<uint32_t>& syncSampleIndices() const { return m_syncSampleIndices; }
+  const CSampleRuns<SSampleGroupInfo>& sampleGroupInfoRuns() const {
+    return m_sampleGroupInfoRuns;
+  }
+
+  void setTimeScale(uint32_t timeScale) { m_timeScale = timeScale; }
+
+  //! Appends a complete sample, track id and time scale of the sample are ignored
+  void push_back(const CMetaSample& sample);
+
+  //! Appends count samples of the same size
+  void appendSize(uint64_t size, size_t count = 1);
+  void appendSizes(const uint32_t* sizes, size_t count);
+  void appendSizes(const uint16_t* sizes, size_t count);
+  void appendOffset(uint64_t offset);
+  //! Appends count samples as a new offset run, offsetsInRun are relative to baseOffset
+  void appendOffsetRun(uint64_t baseOffset, const uint32_t* offsetsInRun, size_t count);
+  //! Appends the offsets of count samples stored back to back at chunkOffset, their sizes have to
+  //! be appended already
+  void appendChunk(uint64_t chunkOffset, size_t count);
+  //! Appends count samples of the same duration, the first one decoded at dtsValue
+  void appendTiming(uint64_t duration, int64_t dtsValue, size_t count = 1);
+  void appendCtsOffset(int64_t ctsOffset, size_t count = 1) {
+    m_ctsOffsetRuns.append(ctsOffset, count);
+  }
+  void appendFragmentNumber(uint32_t fragmentNumber, size_t count = 1) {
+    m_fragmentNumberRuns.append(fragmentNumber, count);
+  }
+  void appendSyncSamples(bool isSyncSample, size_t count = 1);
+  void setSyncSample(size_t sampleIndex);
+  void appendSampleGroupInfo(const SSampleGroupInfo& sampleGroupInfo, size_t count = 1) {
+    m_sampleGroupInfoRuns.append(sampleGroupInfo, count);
+  }
+
+  //! Appends all samples of another table, their decoding times shifted by dtsOffset
+  void appendSamples(const CTrackSampleInfo& other, int64_t dtsOffset);
+
+  //! Moves every column into an array of exactly its size allocated from resource, null for the
+  //! heap. Releases the memory reserved for further appends.
+  void shrinkToFit(const std::shared_ptr<IMemoryResource>& resource = nullptr);
+
+ private:
+  //! Stores the indices of the samples so far, needed as soon as one is not a sync sample
+  void storeSyncSampleIndices();
+
+  uint32_t m_trackId;
+  uint32_t m_timeScale;
+  uint32_t m_maxSampleSize = 0;
+  uint64_t m_durationSum = 0;
+  ResourceVector<uint32_t> m_sizes;
+  ResourceVector<uint32_t> m_offsetsInRun;
+  CSampleRuns<uint64_t> m_offsetRuns;
+  CSampleRuns<STiming> m_timingRuns;
+  //! Sum of the durations of all samples before each timing run
+  ResourceVector<uint64_t> m_timingRunStarts;
+  CSampleRuns<int64_t> m_ctsOffsetRuns;
+  CSampleRuns<uint32_t> m_fragmentNumberRuns;
+  ResourceVector<bool> m_syncSamples;
+  //! Ascending, only stored if not every sample is a sync sample
+  ResourceVector<uint32_t> m_syncSampleIndices;
+  bool m_allSyncSamples = true;
+  CSampleRuns<SSampleGroupInfo> m_sampleGroupInfoRuns;
+};
+
 using TrackIdToTrackSampleInfo = std::map<uint32_t, CTrackSampleInfo>;
 }  // namespace isobmff
 }  // namespace mmt
@@ -87,6 +87,31 @@ amm-info@iis.fraunhofer.de
 
 // System includes
 #include <stdexcept>
+#include <limits>
+#include <list>
+#include <unordered_map>
+
+#if defined(WIN32) || defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define MMTISOBMFF_HAVE_IO_URING
+#include <cstring>
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#endif
+#endif
 
 // External includes
 
@@ -104,6 +129,8 @@ amm-info@iis.fraunhofer.de
 
 namespace mmt {
 namespace isobmff {
+constexpr pos_type IIsobmffInput::unknownSize;
+
 size_t CIsobmffFileInput::read(ilo::ByteBuffer::iterator inBegin, ilo::ByteBuffer::iterator inEnd) {
   size_t len = static_cast<size_t>(inEnd - inBegin);
   char* buffer = reinterpret_cast<char*>(&(*inBegin));
@@ -135,12 +162,407 @@ void CIsobmffFileInput::seek(offset_type offset, SeekingOrigin origin) {
   ILO_ASSERT(err == 0, "Could not seek to position");
 }
 
+pos_type CIsobmffFileInput::size() {
+  if (m_size == unknownSize) {
+    auto currentPos = ilo_ftello(m_file.get());
+    int err = ilo_fseeko(m_file.get(), 0, SEEK_END);
+    ILO_ASSERT(err == 0, "Could not seek to end of file");
+    m_size = static_cast<pos_type>(ilo_ftello(m_file.get()));
+    err = ilo_fseeko(m_file.get(), currentPos, SEEK_SET);
+    ILO_ASSERT(err == 0, "Could not seek to position");
+  }
+  return m_size;
+}
+
 bool CIsobmffFileInput::isEOI() {
   auto c = fgetc(m_file.get());
   ungetc(c, m_file.get());
   return feof(m_file.get()) != 0;
 }
 
+//! File descriptor (handle) shared by all clones of a CIsobmffPositionalFileInput
+struct CIsobmffPositionalFileInput::SFileHandle {
+  explicit SFileHandle(const std::string& filename);
+  ~SFileHandle();
+
+  SFileHandle(const SFileHandle&) = delete;
+  SFileHandle& operator=(const SFileHandle&) = delete;
+
+  //! Reads up to size bytes at pos, returns the number of bytes read (0 at the end of the file)
+  size_t readAt(pos_type pos, uint8_t* data, size_t size) const;
+  //! Current size of the file in bytes
+  uint64_t fileSize() const;
+
+#if defined(WIN32) || defined(_WIN32)
+  HANDLE fileHandle = INVALID_HANDLE_VALUE;
+#else
+  int fd = -1;
+#endif
+};
+
+#if defined(WIN32) || defined(_WIN32)
+CIsobmffPositionalFileInput::SFileHandle::SFileHandle(const std::string& filename) {
+  fileHandle = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                           FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+  ILO_ASSERT(fileHandle != INVALID_HANDLE_VALUE, "Could not open file %s", filename.c_str());
+}
+
+CIsobmffPositionalFileInput::SFileHandle::~SFileHandle() {
+  CloseHandle(fileHandle);
+}
+
+size_t CIsobmffPositionalFileInput::SFileHandle::readAt(pos_type pos, uint8_t* data,
+                                                         size_t size) const {
+  size_t totalRead = 0;
+  while (totalRead < size) {
+    // ReadFile with an offset given in OVERLAPPED does not depend on the shared file pointer
+    OVERLAPPED overlapped = {};
+    uint64_t readPos = pos + totalRead;
+    overlapped.Offset = static_cast<DWORD>(readPos & 0xFFFFFFFFu);
+    overlapped.OffsetHigh = static_cast<DWORD>(readPos >> 32);
+
+    DWORD chunkSize = static_cast<DWORD>(std::min<size_t>(size - totalRead, 0x40000000u));
+    DWORD bytesRead = 0;
+    if (!ReadFile(fileHandle, data + totalRead, chunkSize, &bytesRead, &overlapped)) {
+      ILO_ASSERT(GetLastError() == ERROR_HANDLE_EOF, "Could not read from file");
+      break;
+    }
+    if (bytesRead == 0) {
+      break;
+    }
+    totalRead += bytesRead;
+  }
+  return totalRead;
+}
+
+uint64_t CIsobmffPositionalFileInput::SFileHandle::fileSize() const {
+  LARGE_INTEGER size;
+  ILO_ASSERT(GetFileSizeEx(fileHandle, &size), "Could not get file size");
+  return static_cast<uint64_t>(size.QuadPart);
+}
+#else
+CIsobmffPositionalFileInput::SFileHandle::SFileHandle(const std::string& filename) {
+  fd = open(filename.c_str(), O_RDONLY);
+  ILO_ASSERT(fd >= 0, "Could not open file %s", filename.c_str());
+}
+
+CIsobmffPositionalFileInput::SFileHandle::~SFileHandle() {
+  close(fd);
+}
+
+size_t CIsobmffPositionalFileInput::SFileHandle::readAt(pos_type pos, uint8_t* data,
+                                                         size_t size) const {
+  size_t totalRead = 0;
+  while (totalRead < size) {
+#if defined __ANDROID__ && __ANDROID_API__ >= 24
+    ssize_t bytesRead = pread64(fd, data + totalRead, size - totalRead,
+                                static_cast<SEEK_OFFSET_T>(pos + totalRead));
+#else
+    ssize_t bytesRead = pread(fd, data + totalRead, size - totalRead,
+                              static_cast<SEEK_OFFSET_T>(pos + totalRead));
+#endif
+    if (bytesRead < 0 && errno == EINTR) {
+      continue;
+    }
+    ILO_ASSERT(bytesRead >= 0, "Could not read from file");
+    if (bytesRead == 0) {
+      break;
+    }
+    totalRead += static_cast<size_t>(bytesRead);
+  }
+  return totalRead;
+}
+
+uint64_t CIsobmffPositionalFileInput::SFileHandle::fileSize() const {
+  struct stat fileStat;
+  ILO_ASSERT(fstat(fd, &fileStat) == 0, "Could not get file size");
+  return static_cast<uint64_t>(fileStat.st_size);
+}
+#endif
+
+CIsobmffPositionalFileInput::CIsobmffPositionalFileInput(const std::string& filename)
+    : m_file(std::make_shared<const SFileHandle>(filename)), m_pos(0) {}
+
+CIsobmffPositionalFileInput::CIsobmffPositionalFileInput(std::shared_ptr<const SFileHandle> file)
+    : m_file(file), m_pos(0) {}
+
+size_t CIsobmffPositionalFileInput::read(ilo::ByteBuffer::iterator inBegin,
+                                         ilo::ByteBuffer::iterator inEnd) {
+  if (inBegin == inEnd) {
+    return 0;
+  }
+  size_t actuallyRead =
+      m_file->readAt(m_pos, &(*inBegin), static_cast<size_t>(inEnd - inBegin));
+  m_pos += actuallyRead;
+  return actuallyRead;
+}
+
+void CIsobmffPositionalFileInput::seek(pos_type pos) {
+  ILO_ASSERT(pos <= static_cast<pos_type>(std::numeric_limits<offset_type>::max()),
+             "Could not seek to position");
+  m_pos = pos;
+}
+
+void CIsobmffPositionalFileInput::seek(offset_type offset, SeekingOrigin origin) {
+  offset_type basePos = 0;
+
+  switch (origin) {
+    case SeekingOrigin::beg:
+      break;
+    case SeekingOrigin::end:
+      basePos = static_cast<offset_type>(m_file->fileSize());
+      break;
+    case SeekingOrigin::cur:
+      basePos = static_cast<offset_type>(m_pos);
+      break;
+  }
+
+  ILO_ASSERT(basePos + offset >= 0, "Could not seek to position");
+  m_pos = static_cast<pos_type>(basePos + offset);
+}
+
+pos_type CIsobmffPositionalFileInput::size() {
+  // Refresh the cached size when reading reached it, the file might have grown
+  if (m_size == unknownSize || m_pos >= m_size) {
+    m_size = m_file->fileSize();
+  }
+  return m_size;
+}
+
+bool CIsobmffPositionalFileInput::isEOI() {
+  return m_pos >= size();
+}
+
+#ifdef MMTISOBMFF_HAVE_IO_URING
+//! Submission and completion queue of an io_uring instance (mapped from the kernel)
+struct CIsobmffUringFileInput::SRing {
+  explicit SRing(uint32_t entries);
+  ~SRing();
+
+  SRing(const SRing&) = delete;
+  SRing& operator=(const SRing&) = delete;
+
+  //! Unmaps the queues and closes the ring, only releases what was set up successfully
+  void release();
+
+  int ringFd = -1;
+
+  void* sqRing = MAP_FAILED;
+  size_t sqRingSize = 0;
+  void* cqRing = MAP_FAILED;
+  size_t cqRingSize = 0;
+  io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+  size_t sqesSize = 0;
+
+  unsigned* sqHead = nullptr;
+  unsigned* sqTail = nullptr;
+  unsigned* sqMask = nullptr;
+  unsigned* sqArray = nullptr;
+  unsigned sqEntries = 0;
+
+  unsigned* cqHead = nullptr;
+  unsigned* cqTail = nullptr;
+  unsigned* cqMask = nullptr;
+  io_uring_cqe* cqes = nullptr;
+};
+
+CIsobmffUringFileInput::SRing::SRing(uint32_t entries) {
+  io_uring_params params;
+  std::memset(&params, 0, sizeof(params));
+
+  ringFd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+  ILO_ASSERT(ringFd >= 0, "Could not set up io_uring");
+
+  // The destructor does not run if the constructor throws, so clean up here
+  try {
+    sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMmap) {
+      sqRingSize = std::max(sqRingSize, cqRingSize);
+      cqRingSize = sqRingSize;
+    }
+
+    sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd,
+                  IORING_OFF_SQ_RING);
+    ILO_ASSERT(sqRing != MAP_FAILED, "Could not map io_uring submission queue");
+
+    if (singleMmap) {
+      cqRing = sqRing;
+    } else {
+      cqRing = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd,
+                    IORING_OFF_CQ_RING);
+      ILO_ASSERT(cqRing != MAP_FAILED, "Could not map io_uring completion queue");
+    }
+
+    sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    sqes = static_cast<io_uring_sqe*>(mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE,
+                                           MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES));
+    ILO_ASSERT(sqes != MAP_FAILED, "Could not map io_uring submission queue entries");
+  } catch (...) {
+    release();
+    throw;
+  }
+
+  auto sqBase = static_cast<uint8_t*>(sqRing);
+  sqHead = reinterpret_cast<unsigned*>(sqBase + params.sq_off.head);
+  sqTail = reinterpret_cast<unsigned*>(sqBase + params.sq_off.tail);
+  sqMask = reinterpret_cast<unsigned*>(sqBase + params.sq_off.ring_mask);
+  sqArray = reinterpret_cast<unsigned*>(sqBase + params.sq_off.array);
+  sqEntries = params.sq_entries;
+
+  auto cqBase = static_cast<uint8_t*>(cqRing);
+  cqHead = reinterpret_cast<unsigned*>(cqBase + params.cq_off.head);
+  cqTail = reinterpret_cast<unsigned*>(cqBase + params.cq_off.tail);
+  cqMask = reinterpret_cast<unsigned*>(cqBase + params.cq_off.ring_mask);
+  cqes = reinterpret_cast<io_uring_cqe*>(cqBase + params.cq_off.cqes);
+}
+
+CIsobmffUringFileInput::SRing::~SRing() {
+  release();
+}
+
+void CIsobmffUringFileInput::SRing::release() {
+  if (sqes != MAP_FAILED) {
+    munmap(sqes, sqesSize);
+  }
+  if (cqRing != MAP_FAILED && cqRing != sqRing) {
+    munmap(cqRing, cqRingSize);
+  }
+  if (sqRing != MAP_FAILED) {
+    munmap(sqRing, sqRingSize);
+  }
+  if (ringFd >= 0) {
+    close(ringFd);
+  }
+  sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+  cqRing = MAP_FAILED;
+  sqRing = MAP_FAILED;
+  ringFd = -1;
+}
+#else
+struct CIsobmffUringFileInput::SRing {};
+#endif
+
+CIsobmffUringFileInput::CIsobmffUringFileInput(const std::string& filename, uint32_t queueDepth)
+    : CIsobmffPositionalFileInput(filename), m_queueDepth(queueDepth), m_ringUnavailable(false) {
+  ILO_ASSERT(m_queueDepth > 0, "Queue depth must not be 0");
+}
+
+CIsobmffUringFileInput::CIsobmffUringFileInput(std::shared_ptr<const SFileHandle> file,
+                                               uint32_t queueDepth)
+    : CIsobmffPositionalFileInput(file), m_queueDepth(queueDepth), m_ringUnavailable(false) {}
+
+CIsobmffUringFileInput::~CIsobmffUringFileInput() = default;
+
+void CIsobmffUringFileInput::readBatch(std::vector<SInputReadRequest>& requests) {
+#ifdef MMTISOBMFF_HAVE_IO_URING
+  // The ring is only created for inputs that actually read batches
+  if (m_ring == nullptr && !m_ringUnavailable) {
+    try {
+      m_ring.reset(new SRing(m_queueDepth));
+    } catch (const std::exception&) {
+      ILO_LOG_WARNING("io_uring is not available, falling back to positional reads");
+      m_ringUnavailable = true;
+    }
+  }
+#else
+  m_ringUnavailable = true;
+#endif
+
+  if (m_ringUnavailable) {
+    for (auto& request : requests) {
+      request.bytesRead = request.begin == request.end
+                              ? 0
+                              : m_file->readAt(request.position, &(*request.begin),
+                                               static_cast<size_t>(request.end - request.begin));
+    }
+    return;
+  }
+
+#ifdef MMTISOBMFF_HAVE_IO_URING
+  SRing& ring = *m_ring;
+  size_t nextToSubmit = 0;
+  size_t completed = 0;
+  size_t inFlight = 0;
+
+  while (completed < requests.size()) {
+    // Queue as many requests as the ring allows
+    unsigned sqTail = *ring.sqTail;
+    while (nextToSubmit < requests.size() && inFlight < ring.sqEntries &&
+           sqTail - __atomic_load_n(ring.sqHead, __ATOMIC_ACQUIRE) < ring.sqEntries) {
+      auto& request = requests[nextToSubmit];
+      auto size = static_cast<size_t>(request.end - request.begin);
+      request.bytesRead = 0;
+
+      // Empty and huge reads (not representable in one sqe) are done synchronously
+      if (size == 0 || size > 0x40000000u) {
+        if (size > 0) {
+          request.bytesRead = m_file->readAt(request.position, &(*request.begin), size);
+        }
+        nextToSubmit++;
+        completed++;
+        continue;
+      }
+
+      unsigned index = sqTail & *ring.sqMask;
+      io_uring_sqe& sqe = ring.sqes[index];
+      std::memset(&sqe, 0, sizeof(sqe));
+      sqe.opcode = IORING_OP_READ;
+      sqe.fd = m_file->fd;
+      sqe.off = request.position;
+      sqe.addr = reinterpret_cast<uint64_t>(&(*request.begin));
+      sqe.len = static_cast<uint32_t>(size);
+      sqe.user_data = nextToSubmit;
+      ring.sqArray[index] = index;
+
+      sqTail++;
+      inFlight++;
+      nextToSubmit++;
+    }
+    __atomic_store_n(ring.sqTail, sqTail, __ATOMIC_RELEASE);
+
+    if (inFlight == 0) {
+      continue;
+    }
+
+    // Also covers entries that were not consumed by a previous (partial) submission
+    unsigned toSubmit = sqTail - __atomic_load_n(ring.sqHead, __ATOMIC_ACQUIRE);
+    int ret = 0;
+    do {
+      ret = static_cast<int>(syscall(__NR_io_uring_enter, ring.ringFd, toSubmit, 1,
+                                     IORING_ENTER_GETEVENTS, nullptr, 0));
+    } while (ret < 0 && errno == EINTR);
+    ILO_ASSERT(ret >= 0, "Could not submit reads to io_uring");
+
+    // Collect all available completions
+    unsigned cqHead = *ring.cqHead;
+    unsigned cqTail = __atomic_load_n(ring.cqTail, __ATOMIC_ACQUIRE);
+    while (cqHead != cqTail) {
+      const io_uring_cqe& cqe = ring.cqes[cqHead & *ring.cqMask];
+      auto& request = requests[static_cast<size_t>(cqe.user_data)];
+      auto size = static_cast<size_t>(request.end - request.begin);
+
+      if (cqe.res < 0 || static_cast<size_t>(cqe.res) < size) {
+        // Failed (e.g. IORING_OP_READ not supported by the kernel) or short read: complete the
+        // remainder with a positional read
+        auto alreadyRead = cqe.res < 0 ? 0 : static_cast<size_t>(cqe.res);
+        request.bytesRead =
+            alreadyRead + m_file->readAt(request.position + alreadyRead,
+                                         &(*request.begin) + alreadyRead, size - alreadyRead);
+      } else {
+        request.bytesRead = static_cast<size_t>(cqe.res);
+      }
+
+      cqHead++;
+      completed++;
+      inFlight--;
+    }
+    __atomic_store_n(ring.cqHead, cqHead, __ATOMIC_RELEASE);
+  }
+#endif
+}
+
 size_t CIsobmffMemoryInput::read(ilo::ByteBuffer::iterator inBegin,
                                  ilo::ByteBuffer::iterator inEnd) {
   auto copyCount = std::min(inEnd - inBegin, buffer->end() - ptr);
@@ -174,5 +596,318 @@ void CIsobmffMemoryInput::seek(offset_type offset, SeekingOrigin origin) {
       break;
   }
 }
+
+const uint8_t* CIsobmffMemoryInput::view(pos_type pos, size_t size) {
+  if (pos > buffer->size() || size > buffer->size() - pos) {
+    return nullptr;
+  }
+  return buffer->data() + pos;
+}
+
+//! Read-only mapping of a complete file. Shared by all clones of a CIsobmffMmapInput.
+struct CIsobmffMmapInput::SMapping {
+  explicit SMapping(const std::string& filename);
+  ~SMapping();
+
+  SMapping(const SMapping&) = delete;
+  SMapping& operator=(const SMapping&) = delete;
+
+  const uint8_t* data = nullptr;
+  uint64_t size = 0;
+
+#if defined(WIN32) || defined(_WIN32)
+  HANDLE fileHandle = INVALID_HANDLE_VALUE;
+  HANDLE mappingHandle = nullptr;
+#endif
+};
+
+#if defined(WIN32) || defined(_WIN32)
+CIsobmffMmapInput::SMapping::SMapping(const std::string& filename) {
+  fileHandle = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                           FILE_ATTRIBUTE_NORMAL, nullptr);
+  ILO_ASSERT(fileHandle != INVALID_HANDLE_VALUE, "Could not open file %s", filename.c_str());
+
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(fileHandle, &fileSize)) {
+    CloseHandle(fileHandle);
+    ILO_ASSERT(false, "Could not get size of file %s", filename.c_str());
+  }
+  size = static_cast<uint64_t>(fileSize.QuadPart);
+
+  // Empty files cannot be mapped, but are valid (empty) input
+  if (size == 0) {
+    return;
+  }
+
+  if (size > std::numeric_limits<size_t>::max()) {
+    CloseHandle(fileHandle);
+    ILO_ASSERT(false, "File %s is too big to be mapped", filename.c_str());
+  }
+
+  mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mappingHandle == nullptr) {
+    CloseHandle(fileHandle);
+    ILO_ASSERT(false, "Could not create file mapping for %s", filename.c_str());
+  }
+
+  data = static_cast<const uint8_t*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+  if (data == nullptr) {
+    CloseHandle(mappingHandle);
+    CloseHandle(fileHandle);
+    ILO_ASSERT(false, "Could not map file %s", filename.c_str());
+  }
+}
+
+CIsobmffMmapInput::SMapping::~SMapping() {
+  if (data != nullptr) {
+    UnmapViewOfFile(data);
+  }
+  if (mappingHandle != nullptr) {
+    CloseHandle(mappingHandle);
+  }
+  if (fileHandle != INVALID_HANDLE_VALUE) {
+    CloseHandle(fileHandle);
+  }
+}
+#else
+CIsobmffMmapInput::SMapping::SMapping(const std::string& filename) {
+  int fd = open(filename.c_str(), O_RDONLY);
+  ILO_ASSERT(fd >= 0, "Could not open file %s", filename.c_str());
+
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0) {
+    close(fd);
+    ILO_ASSERT(false, "Could not get size of file %s", filename.c_str());
+  }
+  size = static_cast<uint64_t>(fileStat.st_size);
+
+  // Empty files cannot be mapped, but are valid (empty) input
+  if (size == 0) {
+    close(fd);
+    return;
+  }
+
+  if (size > std::numeric_limits<size_t>::max()) {
+    close(fd);
+    ILO_ASSERT(false, "File %s is too big to be mapped", filename.c_str());
+  }
+
+  void* mapped = mmap(nullptr, static_cast<size_t>(size), PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps its own reference to the file, the descriptor is not needed anymore
+  close(fd);
+  ILO_ASSERT(mapped != MAP_FAILED, "Could not map file %s", filename.c_str());
+
+  data = static_cast<const uint8_t*>(mapped);
+}
+
+CIsobmffMmapInput::SMapping::~SMapping() {
+  if (data != nullptr) {
+    munmap(const_cast<uint8_t*>(data), static_cast<size_t>(size));
+  }
+}
+#endif
+
+CIsobmffMmapInput::CIsobmffMmapInput(const std::string& filename)
+    : m_mapping(std::make_shared<const SMapping>(filename)), m_pos(0) {}
+
+CIsobmffMmapInput::CIsobmffMmapInput(std::shared_ptr<const SMapping> mapping)
+    : m_mapping(mapping), m_pos(0) {}
+
+size_t CIsobmffMmapInput::read(ilo::ByteBuffer::iterator inBegin, ilo::ByteBuffer::iterator inEnd) {
+  if (m_pos >= m_mapping->size) {
+    return 0;
+  }
+
+  auto copyCount = std::min(static_cast<uint64_t>(inEnd - inBegin), m_mapping->size - m_pos);
+  std::copy(m_mapping->data + m_pos, m_mapping->data + m_pos + copyCount, inBegin);
+
+  m_pos += copyCount;
+  return static_cast<size_t>(copyCount);
+}
+
+void CIsobmffMmapInput::seek(pos_type pos) {
+  ILO_ASSERT_WITH(pos <= m_mapping->size, std::out_of_range, "Position to seek to is out of range");
+  m_pos = pos;
+}
+
+void CIsobmffMmapInput::seek(offset_type offset, SeekingOrigin origin) {
+  switch (origin) {
+    case SeekingOrigin::beg:
+      ILO_ASSERT_WITH(offset >= 0, std::out_of_range, "Position to seek to is out of range");
+      seek(static_cast<pos_type>(offset));
+      break;
+    case SeekingOrigin::end:
+      ILO_ASSERT_WITH(offset <= 0 && m_mapping->size >= static_cast<uint64_t>(std::abs(offset)),
+                      std::out_of_range, "Position to seek to is out of range");
+      m_pos = m_mapping->size - static_cast<uint64_t>(std::abs(offset));
+      break;
+    case SeekingOrigin::cur:
+      ILO_ASSERT_WITH((offset >= 0 && static_cast<uint64_t>(offset) <= m_mapping->size - m_pos) ||
+                          (offset < 0 && static_cast<uint64_t>(std::abs(offset)) <= m_pos),
+                      std::out_of_range, "Position to seek to is out of range");
+      m_pos = static_cast<pos_type>(static_cast<offset_type>(m_pos) + offset);
+      break;
+  }
+}
+
+pos_type CIsobmffMmapInput::size() {
+  return m_mapping->size;
+}
+
+bool CIsobmffMmapInput::isEOI() {
+  return m_pos >= m_mapping->size;
+}
+
+const uint8_t* CIsobmffMmapInput::view(pos_type pos, size_t size) {
+  if (pos > m_mapping->size || size > m_mapping->size - pos || m_mapping->data == nullptr) {
+    return nullptr;
+  }
+  return m_mapping->data + pos;
+}
+
+//! LRU cache of fixed size blocks of a CIsobmffCachedInput
+struct CIsobmffCachedInput::SBlockCache {
+  struct SBlock {
+    uint64_t index;
+    ilo::ByteBuffer data;
+  };
+
+  //! Most recently used block first
+  std::list<SBlock> blocks;
+  std::unordered_map<uint64_t, std::list<SBlock>::iterator> blockLookup;
+  //! Index of the block following the last fetched range (used to detect sequential access)
+  uint64_t nextSequentialIndex = 0;
+
+  const ilo::ByteBuffer* find(uint64_t index) {
+    auto it = blockLookup.find(index);
+    if (it == blockLookup.end()) {
+      return nullptr;
+    }
+    blocks.splice(blocks.begin(), blocks, it->second);
+    return &it->second->data;
+  }
+
+  const ilo::ByteBuffer& insert(uint64_t index, ilo::ByteBuffer::const_iterator begin,
+                                ilo::ByteBuffer::const_iterator end, size_t maxBlocks) {
+    auto it = blockLookup.find(index);
+    if (it != blockLookup.end()) {
+      blocks.erase(it->second);
+      blockLookup.erase(it);
+    }
+
+    blocks.push_front(SBlock{index, ilo::ByteBuffer(begin, end)});
+    blockLookup[index] = blocks.begin();
+
+    while (blocks.size() > maxBlocks) {
+      blockLookup.erase(blocks.back().index);
+      blocks.pop_back();
+    }
+    return blocks.front().data;
+  }
+};
+
+CIsobmffCachedInput::CIsobmffCachedInput(std::unique_ptr<IIsobmffInput>&& input,
+                                         const SCachedInputConfig& config)
+    : m_input(std::move(input)), m_config(config), m_cache(new SBlockCache()), m_pos(0) {
+  ILO_ASSERT(m_input != nullptr, "Input to cache must not be empty");
+  ILO_ASSERT(m_config.blockSize > 0, "Block size of cached input must not be 0");
+  ILO_ASSERT(m_config.maxCachedBlocks > 0, "Number of cached blocks must not be 0");
+  m_pos = m_input->tell();
+}
+
+CIsobmffCachedInput::~CIsobmffCachedInput() = default;
+
+size_t CIsobmffCachedInput::read(ilo::ByteBuffer::iterator inBegin,
+                                 ilo::ByteBuffer::iterator inEnd) {
+  auto len = static_cast<size_t>(inEnd - inBegin);
+
+  // Big reads do not benefit from caching, avoid the extra copy
+  if (len >= m_config.blockSize) {
+    m_input->seek(m_pos);
+    auto actuallyRead = m_input->read(inBegin, inEnd);
+    m_pos += actuallyRead;
+    return actuallyRead;
+  }
+
+  size_t copied = 0;
+  while (copied < len) {
+    uint64_t blockIndex = m_pos / m_config.blockSize;
+    auto offsetInBlock = static_cast<size_t>(m_pos - blockIndex * m_config.blockSize);
+
+    const ilo::ByteBuffer* block = m_cache->find(blockIndex);
+    if (block == nullptr) {
+      size_t blockCount = 1;
+      if (blockIndex == m_cache->nextSequentialIndex) {
+        blockCount += m_config.readAheadBlocks;
+      }
+
+      ilo::ByteBuffer fetched(blockCount * m_config.blockSize);
+      m_input->seek(blockIndex * m_config.blockSize);
+      fetched.resize(m_input->read(fetched.begin(), fetched.end()));
+      m_cache->nextSequentialIndex = blockIndex + blockCount;
+
+      // Insert the read-ahead blocks first, so the requested block is the most recently used one
+      for (size_t i = blockCount; i-- > 0;) {
+        size_t blockBegin = std::min(fetched.size(), i * m_config.blockSize);
+        size_t blockEnd = std::min(fetched.size(), blockBegin + m_config.blockSize);
+        if (blockBegin == blockEnd && i > 0) {
+          continue;
+        }
+        block = &m_cache->insert(blockIndex + i, fetched.begin() + blockBegin,
+                                 fetched.begin() + blockEnd, m_config.maxCachedBlocks);
+      }
+    }
+
+    if (offsetInBlock >= block->size()) {
+      break;
+    }
+
+    size_t copyCount = std::min(len - copied, block->size() - offsetInBlock);
+    std::copy(block->begin() + offsetInBlock, block->begin() + offsetInBlock + copyCount,
+              inBegin + copied);
+    copied += copyCount;
+    m_pos += copyCount;
+
+    // A short block marks the end of the input
+    if (block->size() < m_config.blockSize && copied < len) {
+      break;
+    }
+  }
+
+  return copied;
+}
+
+void CIsobmffCachedInput::seek(pos_type pos) {
+  m_pos = pos;
+}
+
+void CIsobmffCachedInput::seek(offset_type offset, SeekingOrigin origin) {
+  switch (origin) {
+    case SeekingOrigin::beg:
+      ILO_ASSERT_WITH(offset >= 0, std::out_of_range, "Position to seek to is out of range");
+      m_pos = static_cast<pos_type>(offset);
+      break;
+    case SeekingOrigin::end:
+      m_input->seek(offset, SeekingOrigin::end);
+      m_pos = m_input->tell();
+      break;
+    case SeekingOrigin::cur:
+      ILO_ASSERT_WITH(offset >= 0 || static_cast<uint64_t>(std::abs(offset)) <= m_pos,
+                      std::out_of_range, "Position to seek to is out of range");
+      m_pos = static_cast<pos_type>(static_cast<offset_type>(m_pos) + offset);
+      break;
+  }
+}
+
+bool CIsobmffCachedInput::isEOI() {
+  uint64_t blockIndex = m_pos / m_config.blockSize;
+  const ilo::ByteBuffer* block = m_cache->find(blockIndex);
+  if (block != nullptr && m_pos - blockIndex * m_config.blockSize < block->size()) {
+    return false;
+  }
+
+  m_input->seek(m_pos);
+  return m_input->isEOI();
+}
 }  // namespace isobmff
 }  // namespace mmt
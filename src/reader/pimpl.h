@@ -90,6 +90,9 @@ amm-info@iis.fraunhofer.de
 // System includes
 #include <memory>
 #include <algorithm>
+#include <mutex>
+#include <set>
+#include <string>
 
 // External includes
 #include "ilo/common_types.h"
@@ -105,11 +108,12 @@ amm-info@iis.fraunhofer.de
 #include "service/factory.h"
 
 #include "service/boxregistry.h"
-#include "service/servicesingleton.h"
+#include "service/parsercontext.h"
 #include "service/boxreader.h"
 #include "reader/sample_extractor.h"
 
 #include "reader/readerinfo.h"
+#include "reader/sampleindex.h"
 #include "tree/tree_parser.h"
 
 namespace mmt {
@@ -117,24 +121,172 @@ namespace isobmff {
 using BoxInfoVec = std::vector<std::shared_ptr<IBoxInfo>>;
 
 struct CIsobmffReader::Pimpl {
-  Pimpl(std::unique_ptr<IIsobmffInput>&& in) : m_input(std::move(in)) {
-    parseTree(m_tree, m_input);
-    auto sampleExtractor = CSampleExtractorFactory::create(m_tree);
-    m_trackIdToTrackSampleInfo = sampleExtractor->trackIdToTrackSampleInfo();
-    ILO_ASSERT(m_trackIdToTrackSampleInfo,
-               "Internal sample info struct is accessed before allocation.");
+  Pimpl(std::unique_ptr<IIsobmffInput>&& in, std::shared_ptr<IMemoryResource> memoryResource,
+        const std::string& sampleIndexFile, size_t sampleTableThreadCount)
+      : m_parserContext(std::move(memoryResource)),
+        m_input(std::move(in)),
+        m_sampleTableThreadCount(sampleTableThreadCount) {
+    if (sampleIndexFile.empty() || !loadSampleIndex(sampleIndexFile)) {
+      m_topLevelBoxes = scanTopLevelBoxes(m_input);
+    }
+    // Only the boxes up to ftyp and moov are needed for movie and track information. Everything
+    // behind them (mostly fragments) is parsed when sample information or the whole tree is needed.
+    m_movieBoxCount = movieBoxCount(m_topLevelBoxes);
+    m_hasFragments = std::any_of(
+        m_topLevelBoxes.begin(), m_topLevelBoxes.end(),
+        [](const STopLevelBoxInfo& info) { return info.type == "moof"_fcc; });
+    parseTopLevelBoxes(m_movieBoxCount);
+    m_movieTreeIndex = CBoxTreeIndex(m_tree);
   }
 
-  const BoxTree& tree() const { return m_tree; }
+  //! Fourcc index of the complete box tree
+  const CBoxTreeIndex& treeIndex() const {
+    std::lock_guard<std::mutex> lock(m_parseMutex);
+    parseTopLevelBoxes(m_topLevelBoxes.size());
+    if (!m_treeIndex) {
+      m_treeIndex = std::make_shared<CBoxTreeIndex>(m_tree);
+    }
+    return *m_treeIndex;
+  }
+
+  //! Fourcc index of all top-level boxes up to and including moov
+  const CBoxTreeIndex& movieTreeIndex() const { return m_movieTreeIndex; }
+
+  const TopLevelBoxIndex& topLevelBoxes() const { return m_topLevelBoxes; }
   const std::unique_ptr<IIsobmffInput>& input() const { return m_input; }
+
+  /*
+   * Sample table of a track, derived on first access. Null if the track has no sample data.
+   *
+   * All track readers of a track share the table. It keeps the table map alive, so it stays valid
+   * after the reader is gone.
+   */
+  std::shared_ptr<const CTrackSampleInfo> trackSampleInfo(uint32_t trackId) const {
+    std::lock_guard<std::mutex> lock(m_parseMutex);
+    extractTrackSampleInfo(trackId);
+    auto trackSampleInfoIter = m_trackIdToTrackSampleInfo->find(trackId);
+    if (trackSampleInfoIter == m_trackIdToTrackSampleInfo->end()) {
+      return nullptr;
+    }
+    return std::shared_ptr<const CTrackSampleInfo>(m_trackIdToTrackSampleInfo,
+                                                   &trackSampleInfoIter->second);
+  }
+
+  //! Sample tables of all tracks, derives the ones not accessed so far
   const TrackIdToTrackSampleInfo& trackIdToTrackSampleInfo() const {
+    std::lock_guard<std::mutex> lock(m_parseMutex);
+    if (!m_allTracksExtracted) {
+      parseSampleTableBoxes();
+      auto sampleExtractor = CSampleExtractorFactory::create(
+          m_tree, 0, m_sampleTableThreadCount, m_parserContext.memoryResource());
+      // Tables already handed out stay in place, emplace does not replace them
+      for (auto& track : *sampleExtractor->trackIdToTrackSampleInfo()) {
+        m_trackIdToTrackSampleInfo->emplace(track.first, std::move(track.second));
+      }
+      m_allTracksExtracted = true;
+    }
     return *m_trackIdToTrackSampleInfo;
   }
 
+  //! Sample count, largest sample size and duration of a track without deriving its sample table
+  STrackSampleSummary trackSampleSummary(uint32_t trackId) const {
+    std::lock_guard<std::mutex> lock(m_parseMutex);
+    auto trackSampleInfoIter = m_trackIdToTrackSampleInfo->find(trackId);
+    if (trackSampleInfoIter != m_trackIdToTrackSampleInfo->end()) {
+      return summarizeTrackSamples(trackSampleInfoIter->second);
+    }
+    parseSampleTableBoxes();
+    return summarizeTrackSamples(m_tree, trackId);
+  }
+
+  //! Writes the top-level box layout and the sample tables to a sample index file
+  void writeSampleIndex(const std::string& filename) const {
+    SSampleIndex index;
+    trackIdToTrackSampleInfo();  // derives the sample tables if not done yet
+    index.trackIdToTrackSampleInfo = m_trackIdToTrackSampleInfo;
+    index.topLevelBoxes = m_topLevelBoxes;
+
+    std::lock_guard<std::mutex> lock(m_parseMutex);
+    index.inputSize = m_input->size();
+    index.movieHash = movieHash(m_input, m_topLevelBoxes);
+    isobmff::writeSampleIndex(filename, index);
+  }
+
  private:
-  BoxTree m_tree;
-  std::unique_ptr<IIsobmffInput> m_input;
-  std::shared_ptr<TrackIdToTrackSampleInfo> m_trackIdToTrackSampleInfo;
+  //! Takes the top-level boxes and sample tables from the index file if it matches the input
+  bool loadSampleIndex(const std::string& filename) {
+    auto index = readSampleIndex(filename, m_parserContext.memoryResource());
+    if (index == nullptr) {
+      return false;
+    }
+
+    // Hashing moves the input, the boxes are scanned from the start position if it fails
+    const auto startPosition = m_input->tell();
+    bool matches = false;
+    try {
+      matches = index->inputSize == m_input->size() &&
+                index->movieHash == movieHash(m_input, index->topLevelBoxes);
+    } catch (const std::exception& e) {
+      ILO_LOG_WARNING("Could not hash the input for sample index %s: %s", filename.c_str(),
+                      e.what());
+    }
+    if (!matches) {
+      m_input->seek(startPosition);
+      ILO_LOG_WARNING("Sample index %s does not match the input - ignoring it", filename.c_str());
+      return false;
+    }
+
+    m_topLevelBoxes = std::move(index->topLevelBoxes);
+    m_trackIdToTrackSampleInfo = index->trackIdToTrackSampleInfo;
+    m_allTracksExtracted = true;
+    return true;
+  }
+
+  //! Parses all boxes the sample tables are derived from, must be called with m_parseMutex held
+  void parseSampleTableBoxes() const {
+    // Non-fragmented files carry all sample information in moov
+    if (m_hasFragments) {
+      parseTopLevelBoxes(m_topLevelBoxes.size());
+    }
+  }
+
+  //! Derives the sample table of a single track, must be called with m_parseMutex held
+  void extractTrackSampleInfo(uint32_t trackId) const {
+    if (m_allTracksExtracted || m_extractedTrackIds.count(trackId) != 0) {
+      return;
+    }
+    parseSampleTableBoxes();
+    auto sampleExtractor = CSampleExtractorFactory::create(
+        m_tree, trackId, m_sampleTableThreadCount, m_parserContext.memoryResource());
+    for (auto& track : *sampleExtractor->trackIdToTrackSampleInfo()) {
+      m_trackIdToTrackSampleInfo->emplace(track.first, std::move(track.second));
+    }
+    m_extractedTrackIds.insert(trackId);
+  }
+
+  //! Parses the top-level boxes up to (excluding) the given index, must be called in index order
+  void parseTopLevelBoxes(size_t last) const {
+    for (; m_parsedBoxCount < last; ++m_parsedBoxCount) {
+      parseTree(m_parserContext, m_tree, m_input, m_topLevelBoxes, m_parsedBoxCount,
+                m_parsedBoxCount + 1, true);
+    }
+  }
+
+  CParserContext m_parserContext;
+  mutable BoxTree m_tree;
+  mutable std::unique_ptr<IIsobmffInput> m_input;
+  size_t m_sampleTableThreadCount = 1;
+  TopLevelBoxIndex m_topLevelBoxes;
+  size_t m_movieBoxCount = 0;
+  bool m_hasFragments = false;
+  mutable size_t m_parsedBoxCount = 0;
+  mutable std::mutex m_parseMutex;
+  CBoxTreeIndex m_movieTreeIndex;
+  mutable std::shared_ptr<CBoxTreeIndex> m_treeIndex;
+  mutable std::shared_ptr<TrackIdToTrackSampleInfo> m_trackIdToTrackSampleInfo =
+      std::make_shared<TrackIdToTrackSampleInfo>();
+  mutable std::set<uint32_t> m_extractedTrackIds;
+  mutable bool m_allTracksExtracted = false;
 };
 }  // namespace isobmff
 }  // namespace mmt
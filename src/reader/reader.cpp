@@ -101,44 +101,12 @@ amm-info@iis.fraunhofer.de
 namespace mmt {
 namespace isobmff {
 
-bool checkIfTrackIdHasSampleData(CIsobmffReader::Pimpl& p, uint32_t trackId) {
-  bool hasSampleData = (p.trackIdToTrackSampleInfo().count(trackId) >= 1);
-  if (!hasSampleData) {
+STrackSampleSummary trackSampleSummary(CIsobmffReader::Pimpl& p, uint32_t trackId) {
+  auto summary = p.trackSampleSummary(trackId);
+  if (!summary.hasSampleData) {
     ILO_LOG_WARNING("Track with id %d does not have accessible sample data", trackId);
   }
-  return hasSampleData;
-}
-
-size_t maxSampleSize(CIsobmffReader::Pimpl& p, uint32_t trackId) {
-  if (!checkIfTrackIdHasSampleData(p, trackId)) {
-    return 0;
-  }
-  size_t maxSize = 0;
-  if (verboseLogLevel) {
-    ILO_LOG_SCOPE_RET(maxSize, "trackId: %u", trackId);
-  }
-  for (const auto& sz : p.trackIdToTrackSampleInfo().at(trackId)) {
-    maxSize = std::max(maxSize, static_cast<size_t>(sz.size));
-  }
-  return maxSize;
-}
-
-uint64_t sampleDurationSum(CIsobmffReader::Pimpl& p, uint32_t trackId) {
-  if (!checkIfTrackIdHasSampleData(p, trackId)) {
-    return 0;
-  }
-  uint64_t duration = 0;
-  for (const auto& sample : p.trackIdToTrackSampleInfo().at(trackId)) {
-    duration += sample.duration;
-  }
-  return duration;
-}
-
-size_t totalSampleCount(CIsobmffReader::Pimpl& p, uint32_t trackId) {
-  if (!checkIfTrackIdHasSampleData(p, trackId)) {
-    return 0;
-  }
-  return p.trackIdToTrackSampleInfo().at(trackId).size();
+  return summary;
 }
 
 CTrackInfo createTrackInfoFromTrack(CIsobmffReader::Pimpl& p, const BoxElement& t) {
@@ -148,36 +116,50 @@ CTrackInfo createTrackInfoFromTrack(CIsobmffReader::Pimpl& p, const BoxElement&
   CCodingNameExtractor::store(t, ti);
   CTrackIdExtractor::store(t, ti);
   CMediaTimeInfoExtractor::store(t, ti);
+  // Taken from the sample table boxes, the sample table itself is derived by the track readers
+  auto summary = trackSampleSummary(p, ti.trackId);
   if (ti.duration == 0) {
     if (verboseLogLevel) {
       ILO_LOG_INFO("duration is zero, summing up sample durations");
     }
-    ti.duration = sampleDurationSum(p, ti.trackId);
+    ti.duration = summary.durationSum;
   }
   CEditListExtractor::store(t, ti);
-  ti.maxSampleSize = maxSampleSize(p, ti.trackId);
-  ti.sampleCount = totalSampleCount(p, ti.trackId);
+  ti.maxSampleSize = static_cast<size_t>(summary.maxSampleSize);
+  ti.sampleCount = summary.sampleCount;
 
   CUserDataExtractor::store<CTrackInfo>(t, ti);
 
   return ti;
 }
 
-CIsobmffReader::CIsobmffReader(std::unique_ptr<IIsobmffInput>&& input) {
-  setupServicesOnce();
-  p = std::make_shared<Pimpl>(std::move(input));
+CIsobmffReader::CIsobmffReader(std::unique_ptr<IIsobmffInput>&& input)
+    : CIsobmffReader(std::move(input), SReaderConfig()) {}
+
+CIsobmffReader::CIsobmffReader(std::unique_ptr<IIsobmffInput>&& input,
+                               const SReaderConfig& config) {
+  std::shared_ptr<IMemoryResource> memoryResource = config.memoryResource;
+  if (memoryResource == nullptr) {
+    memoryResource = std::make_shared<CMonotonicMemoryResource>();
+  }
+  p = std::make_shared<Pimpl>(std::move(input), memoryResource, config.sampleIndexFile,
+                              config.sampleTableThreadCount);
+}
+
+void CIsobmffReader::writeSampleIndex(const std::string& filename) const {
+  p->writeSampleIndex(filename);
 }
 
 CMovieInfo CIsobmffReader::movieInfo() const {
   CMovieInfo result;
-  auto mvhd = findFirstBoxWithFourccAndType<box::CMovieHeaderBox>(p->tree(), ilo::toFcc("mvhd"));
+  auto mvhd = findFirstBoxWithFourccAndType<box::CMovieHeaderBox>(p->movieTreeIndex(), "mvhd"_fcc);
   ILO_ASSERT(mvhd != nullptr, "no mvhd box found");
   result.creationTime = mvhd->creationTime();
   result.modificationTime = mvhd->modificationTime();
   result.timeScale = static_cast<uint32_t>(mvhd->timescale());
   result.duration = mvhd->duration();
 
-  auto ftype = findFirstBoxWithFourccAndType<box::CFileTypeBox>(p->tree(), ilo::toFcc("ftyp"));
+  auto ftype = findFirstBoxWithFourccAndType<box::CFileTypeBox>(p->movieTreeIndex(), "ftyp"_fcc);
   if (ftype) {
     result.majorBrand = ftype->majorBrand();
     result.compatibleBrands = ftype->compatibleBrands();
@@ -186,7 +168,7 @@ CMovieInfo CIsobmffReader::movieInfo() const {
   }
 
   auto moov =
-      findFirstElementWithFourccAndBoxType<box::CContainerBox>(p->tree(), ilo::toFcc("moov"));
+      findFirstElementWithFourccAndBoxType<box::CContainerBox>(p->movieTreeIndex(), "moov"_fcc);
 
   CUserDataExtractor::store<CMovieInfo>(moov, result);
 
@@ -196,7 +178,7 @@ CMovieInfo CIsobmffReader::movieInfo() const {
 CTrackInfoVec CIsobmffReader::trackInfos() const {
   CTrackInfoVec result;
   auto traks =
-      findAllElementsWithFourccAndBoxType<box::CContainerBox>(p->tree(), ilo::toFcc("trak"));
+      findAllElementsWithFourccAndBoxType<box::CContainerBox>(p->movieTreeIndex(), "trak"_fcc);
   uint32_t index = 0;
   for (const auto& t : traks) {
     auto ti = createTrackInfoFromTrack(*p, t.get());
@@ -208,7 +190,7 @@ CTrackInfoVec CIsobmffReader::trackInfos() const {
 
 size_t CIsobmffReader::trackCount() const {
   return static_cast<size_t>(
-      findAllBoxesWithFourccAndType<box::IBox>(p->tree(), ilo::toFcc("trak")).size());
+      findAllBoxesWithFourccAndType<box::IBox>(p->movieTreeIndex(), "trak"_fcc).size());
 }
 }  // namespace isobmff
 }  // namespace mmt
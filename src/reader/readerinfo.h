@@ -107,22 +107,22 @@ namespace mmt {
 namespace isobmff {
 struct CReaderMaps {
   CReaderMaps() {
-    handlerToType.insert({{(ilo::toFcc("soun")), TrackType::audio},
-                          {(ilo::toFcc("vide")), TrackType::video},
-                          {(ilo::toFcc("hint")), TrackType::hint}});
-
-    codingNameToCodec.insert({{ilo::toFcc("mp4a"), Codec::mp4a},
-                              {ilo::toFcc("mha1"), Codec::mpegh_mha},
-                              {ilo::toFcc("mha2"), Codec::mpegh_mha},
-                              {ilo::toFcc("mhm1"), Codec::mpegh_mhm},
-                              {ilo::toFcc("mhm2"), Codec::mpegh_mhm},
-                              {ilo::toFcc("hvc1"), Codec::hevc},
-                              {ilo::toFcc("hev1"), Codec::hevc},
-                              {ilo::toFcc("avc1"), Codec::avc},
-                              {ilo::toFcc("avc3"), Codec::avc},
-                              {ilo::toFcc("jxsm"), Codec::jxs},
-                              {ilo::toFcc("vvc1"), Codec::vvc},
-                              {ilo::toFcc("vvi1"), Codec::vvc}});
+    handlerToType.insert({{"soun"_fcc, TrackType::audio},
+                          {"vide"_fcc, TrackType::video},
+                          {"hint"_fcc, TrackType::hint}});
+
+    codingNameToCodec.insert({{"mp4a"_fcc, Codec::mp4a},
+                              {"mha1"_fcc, Codec::mpegh_mha},
+                              {"mha2"_fcc, Codec::mpegh_mha},
+                              {"mhm1"_fcc, Codec::mpegh_mhm},
+                              {"mhm2"_fcc, Codec::mpegh_mhm},
+                              {"hvc1"_fcc, Codec::hevc},
+                              {"hev1"_fcc, Codec::hevc},
+                              {"avc1"_fcc, Codec::avc},
+                              {"avc3"_fcc, Codec::avc},
+                              {"jxsm"_fcc, Codec::jxs},
+                              {"vvc1"_fcc, Codec::vvc},
+                              {"vvi1"_fcc, Codec::vvc}});
   }
 
   std::map<ilo::Fourcc, TrackType> handlerToType;
@@ -133,7 +133,7 @@ struct CReaderMaps {
 
 struct CEditListExtractor {
   static void store(const BoxElement& t, CTrackInfo& ti) {
-    auto elst = findFirstBoxWithFourccAndType<box::CEditListBox>(t, ilo::toFcc("elst"));
+    auto elst = findFirstBoxWithFourccAndType<box::CEditListBox>(t, "elst"_fcc);
     if (elst == nullptr) {
       return;
     }
@@ -161,8 +161,7 @@ struct CUserDataExtractor {
     static_assert(std::is_same<T, CTrackInfo>::value || std::is_same<T, CMovieInfo>::value,
                   "User data can only be in movie info or track info");
 
-    auto udtaElements =
-        findAllElementsWithFourccAndBoxType<box::CContainerBox>(t, ilo::toFcc("udta"), 1);
+    auto udtaElements = findAllElementsWithFourccAndBoxType<box::CContainerBox>(t, "udta"_fcc, 1);
     if (udtaElements.empty()) {
       return;
     }
@@ -194,7 +193,8 @@ struct CUserDataExtractor {
 
 struct CMediaTimeInfoExtractor {
   static void store(const BoxElement& t, CTrackInfo& ti) {
-    auto mdhd = findFirstBoxWithPathAndType<box::CMediaHeaderBox>(t, "mdia/mdhd");
+    static const BoxPath mdhdPath = {"mdia"_fcc, "mdhd"_fcc};
+    auto mdhd = findFirstBoxWithPathAndType<box::CMediaHeaderBox>(t, mdhdPath);
     ILO_ASSERT(mdhd.get() != nullptr, "mdhd not found");
     ti.timescale = mdhd->timescale();
     ti.language = mdhd->language();
@@ -216,7 +216,7 @@ struct CMediaTimeInfoExtractor {
 
 struct CTrackIdExtractor {
   static void store(const BoxElement& t, CTrackInfo& ti) {
-    auto tkhd = findFirstBoxWithFourccAndType<box::CTrackHeaderBox>(t, ilo::toFcc("tkhd"));
+    auto tkhd = findFirstBoxWithFourccAndType<box::CTrackHeaderBox>(t, "tkhd"_fcc);
     ILO_ASSERT(tkhd.get() != nullptr, "tkhd box not found");
     ti.trackId = tkhd->trackID();
   }
@@ -238,7 +238,8 @@ struct CCodingNameExtractor {
 
 struct CHandlerExtractor {
   static void store(const BoxElement& t, CTrackInfo& ti) {
-    auto hdlrbox = findFirstBoxWithPathAndType<box::CHandlerReferenceBox>(t, "mdia/hdlr");
+    static const BoxPath hdlrPath = {"mdia"_fcc, "hdlr"_fcc};
+    auto hdlrbox = findFirstBoxWithPathAndType<box::CHandlerReferenceBox>(t, hdlrPath);
     ILO_ASSERT(hdlrbox.get() != nullptr, "handler box not found");
     ti.handler = hdlrbox->handlerType();
 
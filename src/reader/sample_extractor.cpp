@@ -87,6 +87,7 @@ amm-info@iis.fraunhofer.de
 
 #include "reader/sample_extractor.h"
 #include "common/restrictions.h"
+#include "common/parallel.h"
 
 #include "box/sttsbox.h"
 #include "box/stszbox.h"
@@ -102,122 +103,139 @@ amm-info@iis.fraunhofer.de
 namespace mmt {
 namespace isobmff {
 
-void ISampleExtractor::fillDefaultSampleGroupInfo(SampleToSampleGroupInfoMap& infoMap,
-                                                  const SDefaultConfig& config) const {
-  for (uint32_t i = config.startIndex; i < config.nrOfSamples; ++i) {
-    // Version >= 2 has a default descr. index. Otherwise signal "no group"
-    if (config.sgpd->version() >= 2) {
-      infoMap[i].push_back(CSampleGroupInfo{config.sgpd->groupingType(),
-                                            config.sgpd->defaultSampleDescriptionIndex()});
-    } else {
-      infoMap[i].push_back(CSampleGroupInfo{config.sgpd->groupingType(), 0});
-    }
+namespace {
+SSampleGroupInterval resolveSampleGroupInterval(box::CSampleGroupDescriptionBox& sgpd,
+                                                uint32_t groupDescIndex) {
+  SSampleGroupInterval interval;
+  interval.groupDescIndex = groupDescIndex;
+  // Desc. index of 0 or 0x10000 means "no sample group"
+  if (groupDescIndex == 0 || groupDescIndex == 0x10000u) {
+    return interval;
+  }
+
+  uint32_t groupDescIndexOffset = 1;
+  if (groupDescIndex > 0x10000u) {
+    groupDescIndexOffset = 0x10001u;
+  }
+
+  if (sgpd.groupingType() == "roll"_fcc) {
+    interval.sampleGroupInfo.type = SampleGroupType::roll;
+    auto sampleGroupEntries = sgpd.downCastSampleGroupEntries<CAudioRollRecoveryEntry>();
+    auto sampleGroupEntry = sampleGroupEntries.at(groupDescIndex - groupDescIndexOffset);
+    interval.sampleGroupInfo.rollDistance = sampleGroupEntry->rollDistance();
+  } else if (sgpd.groupingType() == "prol"_fcc) {
+    interval.sampleGroupInfo.type = SampleGroupType::prol;
+    auto sampleGroupEntries = sgpd.downCastSampleGroupEntries<CAudioPreRollEntry>();
+    auto sampleGroupEntry = sampleGroupEntries.at(groupDescIndex - groupDescIndexOffset);
+    interval.sampleGroupInfo.rollDistance = sampleGroupEntry->rollDistance();
+  } else if (sgpd.groupingType() == "sap "_fcc) {
+    interval.sampleGroupInfo.type = SampleGroupType::sap;
+    auto sampleGroupEntries = sgpd.downCastSampleGroupEntries<CSAPEntry>();
+    auto sampleGroupEntry = sampleGroupEntries.at(groupDescIndex - groupDescIndexOffset);
+    interval.sampleGroupInfo.sapType = sampleGroupEntry->sapType();
+  } else {
+    interval.isUnknownGroupingType = true;
   }
+  return interval;
+}
+
+bool isSampleGroup(const SSampleGroupInterval& interval) {
+  return interval.groupDescIndex != 0 && interval.groupDescIndex != 0x10000u;
 }
+}  // namespace
 
-void ISampleExtractor::createSampleToSampleGroupInfoMap(const size_t nrOfSamples) {
-  m_SampleGroupSampleMap.clear();
-  m_groupingTypeMap.clear();
-  std::vector<SDefaultConfig> defConfigs;
+SampleGroupMappings ISampleExtractor::createSampleGroupMappings(
+    const std::vector<std::shared_ptr<box::CSampleGroupDescriptionBox>>& sgpdBoxes,
+    const std::vector<std::shared_ptr<box::CSampleToGroupBox>>& sbgpBoxes,
+    const size_t nrOfSamples) {
+  SampleGroupMappings mappings;
 
-  for (const auto& sgpd : m_currentSgpdBoxes) {
-    if (m_groupingTypeMap.size() != 0) {
-      ILO_ASSERT(m_groupingTypeMap.find(sgpd->groupingType()) == m_groupingTypeMap.end(),
+  for (const auto& sgpd : sgpdBoxes) {
+    for (const auto& mapping : mappings) {
+      ILO_ASSERT(mapping.groupingType != sgpd->groupingType(),
                  "Grouping types in sgpd box are not unique");
     }
-    // Zero based sample group type index
-    auto nrOfGroups = m_groupingTypeMap.size();
-    m_groupingTypeMap[sgpd->groupingType()] = nrOfGroups;
 
-    const auto sbgpIter = std::find_if(m_currentSbgpBoxes.begin(), m_currentSbgpBoxes.end(),
+    SSampleGroupMapping mapping;
+    mapping.groupingType = sgpd->groupingType();
+    mapping.sgpd = sgpd;
+
+    const auto sbgpIter = std::find_if(sbgpBoxes.begin(), sbgpBoxes.end(),
                                        [&](const std::shared_ptr<box::CSampleToGroupBox>& sbgp) {
                                          return sbgp->groupingType() == sgpd->groupingType();
                                        });
 
-    SDefaultConfig config;
-    config.nrOfSamples = nrOfSamples;
-    config.sgpd = sgpd;
-
-    if (sbgpIter != m_currentSbgpBoxes.end()) {
-      // sbgp box found. Apply index from box.
+    if (sbgpIter != sbgpBoxes.end()) {
+      // sbgp box found. Every entry becomes one interval.
       ILO_ASSERT(*sbgpIter != nullptr, "Sbgp Box was found but parsing returned a zero pointer");
-      auto entries = (*sbgpIter)->sampleGroupEntries();
-
-      uint32_t currSample = 0;
-      for (const auto& entry : entries) {
-        // Fail fast to not run out-of-memory before running into the final size check below
-        ILO_ASSERT((m_SampleGroupSampleMap.size() + entry.sampleCount) <= nrOfSamples,
+      for (const auto& entry : (*sbgpIter)->sampleGroupEntries()) {
+        ILO_ASSERT(entry.sampleCount <= nrOfSamples - mapping.mappedSampleCount,
                    "Nr of samples from sample group is bigger than total nr of samples");
-        for (uint32_t i = 0; i < entry.sampleCount; ++i) {
-          m_SampleGroupSampleMap[currSample++].push_back(
-              CSampleGroupInfo{(*sbgpIter)->groupingType(), entry.groupDescriptionIndex});
+        if (entry.sampleCount == 0) {
+          continue;
         }
+        auto interval = resolveSampleGroupInterval(*sgpd, entry.groupDescriptionIndex);
+        interval.firstSample = mapping.mappedSampleCount;
+        mapping.intervals.push_back(interval);
+        mapping.mappedSampleCount += entry.sampleCount;
       }
-      // Handle left over samples with default index.
-      config.startIndex = currSample;
-      defConfigs.push_back(config);
-    } else {
-      // No sbgp box found for this sample group type. Use default index.
-      config.startIndex = 0;
-      defConfigs.push_back(config);
     }
-  }
 
-  // Handle samples with default values
-  for (auto& config : defConfigs) {
-    fillDefaultSampleGroupInfo(m_SampleGroupSampleMap, config);
-  }
+    // Samples not covered by an sbgp box use the default index. Version >= 2 has a default
+    // descr. index. Otherwise signal "no group"
+    if (mapping.mappedSampleCount < nrOfSamples) {
+      uint32_t defaultIndex = sgpd->version() >= 2 ? sgpd->defaultSampleDescriptionIndex() : 0;
+      mapping.defaultInterval = resolveSampleGroupInterval(*sgpd, defaultIndex);
+      mapping.defaultInterval.firstSample = mapping.mappedSampleCount;
+    }
 
-  ILO_ASSERT(m_SampleGroupSampleMap.size() <= nrOfSamples,
-             "Nr of samples from sample group is bigger than total nr of samples");
+    mappings.push_back(std::move(mapping));
+  }
+  return mappings;
 }
 
-void ISampleExtractor::setSampleSampleGroupInfo(
-    const std::vector<CSampleGroupInfo>& sampleGroupInfos, CMetaSample& metaSample) {
-  for (const auto& sgi : sampleGroupInfos) {
-    // Desc. index of 0 or 0x10000 means "no sample group"
-    if (sgi.groupDescIndex == 0 || sgi.groupDescIndex == 0x10000u) {
-      continue;
-    }
+void ISampleExtractor::setSampleSampleGroupInfo(const SampleGroupMappings& mappings,
+                                                const size_t sampleIndex,
+                                                SSampleGroupInfo& sampleGroupInfo) {
+  // Groups signaled in sbgp boxes are applied before the defaults of the other grouping types
+  for (int pass = 0; pass < 2; ++pass) {
+    for (const auto& mapping : mappings) {
+      bool isMapped = sampleIndex < mapping.mappedSampleCount;
+      if (isMapped != (pass == 0)) {
+        continue;
+      }
+
+      const SSampleGroupInterval* interval = &mapping.defaultInterval;
+      if (isMapped) {
+        auto next = std::upper_bound(mapping.intervals.begin(), mapping.intervals.end(),
+                                     sampleIndex,
+                                     [](size_t index, const SSampleGroupInterval& candidate) {
+                                       return index < candidate.firstSample;
+                                     });
+        interval = &*(next - 1);
+      }
 
-    ILO_ASSERT(metaSample.sampleGroupInfo.type == SampleGroupType::none,
-               "Having multiple SampleGroups in one file is currently not supported");
+      if (!isSampleGroup(*interval)) {
+        continue;
+      }
 
-    uint32_t groupDescIndexOffset = 1;
-    if (sgi.groupDescIndex > 0x10000u) {
-      groupDescIndexOffset = 0x10001u;
-    }
+      ILO_ASSERT(sampleGroupInfo.type == SampleGroupType::none,
+                 "Having multiple SampleGroups in one file is currently not supported");
 
-    auto sgpdBox = m_currentSgpdBoxes.at(m_groupingTypeMap.at(sgi.groupingType));
-
-    if (sgi.groupingType == ilo::toFcc("roll")) {
-      metaSample.sampleGroupInfo.type = SampleGroupType::roll;
-      auto sampleGroupEntries = sgpdBox->downCastSampleGroupEntries<CAudioRollRecoveryEntry>();
-      auto sampleGroupEntry = sampleGroupEntries.at(sgi.groupDescIndex - groupDescIndexOffset);
-      metaSample.sampleGroupInfo.rollDistance = sampleGroupEntry->rollDistance();
-    } else if (sgi.groupingType == ilo::toFcc("prol")) {
-      metaSample.sampleGroupInfo.type = SampleGroupType::prol;
-      auto sampleGroupEntries = sgpdBox->downCastSampleGroupEntries<CAudioPreRollEntry>();
-      auto sampleGroupEntry = sampleGroupEntries.at(sgi.groupDescIndex - groupDescIndexOffset);
-      metaSample.sampleGroupInfo.rollDistance = sampleGroupEntry->rollDistance();
-    } else if (sgi.groupingType == ilo::toFcc("sap ")) {
-      metaSample.sampleGroupInfo.type = SampleGroupType::sap;
-      auto sampleGroupEntries = sgpdBox->downCastSampleGroupEntries<CSAPEntry>();
-      auto sampleGroupEntry = sampleGroupEntries.at(sgi.groupDescIndex - groupDescIndexOffset);
-      metaSample.sampleGroupInfo.sapType = sampleGroupEntry->sapType();
-    } else {
-      // Do not throw here. Just log error and handle as no sample group
-      ILO_LOG_ERROR("Unknown SampleGroupType found: %s", ilo::toString(sgi.groupingType).c_str());
-      return;
+      if (interval->isUnknownGroupingType) {
+        // Do not throw here. Just log error and handle as no sample group
+        ILO_LOG_ERROR("Unknown SampleGroupType found: %s",
+                      ilo::toString(mapping.groupingType).c_str());
+        return;
+      }
+      sampleGroupInfo = interval->sampleGroupInfo;
     }
   }
 }
 
-CFragmentedSampleExtractor::CFragmentedSampleExtractor(const BoxTree& tree) {
-  m_currentTfhdBox = nullptr;
-  m_currentTrunBox = nullptr;
-  m_currentTrexBox = nullptr;
-  m_currentMdhdBox = nullptr;
+CFragmentedSampleExtractor::CFragmentedSampleExtractor(
+    const BoxTree& tree, uint32_t trackId, size_t threadCount,
+    const std::shared_ptr<IMemoryResource>& memoryResource) {
   m_sampleInfoTable = std::make_shared<TrackIdToTrackSampleInfo>();
 
   uint64_t totalDataOffset = 0;
@@ -225,79 +243,95 @@ CFragmentedSampleExtractor::CFragmentedSampleExtractor(const BoxTree& tree) {
   std::vector<std::shared_ptr<box::CTrackHeaderBox>> tkhdBoxes;
   std::vector<std::shared_ptr<box::CMediaHeaderBox>> mhdhBoxes;
   std::vector<std::shared_ptr<box::CSampleGroupDescriptionBox>> sgpdTrakBoxes;
+  // All track fragments are collected first, so their samples can be extracted independently
+  std::vector<STrackFragment> fragments;
 
   for (size_t i = 0; i < tree.childCount(); ++i) {
-    if (tree[i].item->type() == ilo::toFcc("moov")) {
-      trexBoxes = findAllBoxesWithFourccAndType<box::CTrackExtendsBox>(tree[i], ilo::toFcc("trex"));
-      tkhdBoxes = findAllBoxesWithFourccAndType<box::CTrackHeaderBox>(tree[i], ilo::toFcc("tkhd"));
-      mhdhBoxes = findAllBoxesWithFourccAndType<box::CMediaHeaderBox>(tree[i], ilo::toFcc("mdhd"));
-      sgpdTrakBoxes = findAllBoxesWithFourccAndType<box::CSampleGroupDescriptionBox>(
-          tree[i], ilo::toFcc("sgpd"));
+    if (tree[i].item->type() == "moov"_fcc) {
+      trexBoxes = findAllBoxesWithFourccAndType<box::CTrackExtendsBox>(tree[i], "trex"_fcc);
+      tkhdBoxes = findAllBoxesWithFourccAndType<box::CTrackHeaderBox>(tree[i], "tkhd"_fcc);
+      mhdhBoxes = findAllBoxesWithFourccAndType<box::CMediaHeaderBox>(tree[i], "mdhd"_fcc);
+      sgpdTrakBoxes =
+          findAllBoxesWithFourccAndType<box::CSampleGroupDescriptionBox>(tree[i], "sgpd"_fcc);
 
       ILO_ASSERT(
           tkhdBoxes.size() == mhdhBoxes.size(),
           "Malformed tree found. There is at least one Trak with one TKHD or MDHD boxes missing");
-    } else if (tree[i].item->type() == ilo::toFcc("moof")) {
-      m_currentMfhdBox =
-          findFirstBoxWithFourccAndType<box::CMovieFragmentHeaderBox>(tree[i], ilo::toFcc("mfhd"));
-      ILO_ASSERT(m_currentMfhdBox != nullptr,
-                 "MFHD box is required for fragmented mp4, but it was not found");
+    } else if (tree[i].item->type() == "moof"_fcc) {
+      auto mfhd = findFirstBoxWithFourccAndType<box::CMovieFragmentHeaderBox>(tree[i], "mfhd"_fcc);
+      ILO_ASSERT(mfhd != nullptr, "MFHD box is required for fragmented mp4, but it was not found");
 
-      auto trafs =
-          findAllElementsWithFourccAndBoxType<box::CContainerBox>(tree[i], ilo::toFcc("traf"));
+      auto trafs = findAllElementsWithFourccAndBoxType<box::CContainerBox>(tree[i], "traf"_fcc);
 
       for (const auto& traf : trafs) {
-        m_currentTfhdBox = findFirstBoxWithFourccAndType<box::CTrackFragmentHeaderBox>(
-            traf.get(), ilo::toFcc("tfhd"));
-        ILO_ASSERT(m_currentTfhdBox != nullptr,
+        STrackFragment fragment;
+        fragment.mfhd = mfhd;
+        fragment.tfhd =
+            findFirstBoxWithFourccAndType<box::CTrackFragmentHeaderBox>(traf.get(), "tfhd"_fcc);
+        ILO_ASSERT(fragment.tfhd != nullptr,
                    "TFHD box is required for fragmented mp4, but it was not found");
+        if (trackId != 0 && fragment.tfhd->trackId() != trackId) {
+          continue;
+        }
 
         // Hint, tfdt is optional. So no asserts here.
-        m_currentTfdtBox = findFirstBoxWithFourccAndType<box::CTrackFragmentMDTBox>(
-            traf.get(), ilo::toFcc("tfdt"));
+        fragment.tfdt =
+            findFirstBoxWithFourccAndType<box::CTrackFragmentMDTBox>(traf.get(), "tfdt"_fcc);
 
-        m_currentTrunBox =
-            findFirstBoxWithFourccAndType<box::CTrackRunBox>(traf.get(), ilo::toFcc("trun"));
-        ILO_ASSERT(m_currentTrunBox != nullptr,
+        fragment.trun = findFirstBoxWithFourccAndType<box::CTrackRunBox>(traf.get(), "trun"_fcc);
+        ILO_ASSERT(fragment.trun != nullptr,
                    "TRUN box is required for fragmented mp4, but it was not found");
 
-        m_currentSgpdBoxes = findAllBoxesWithFourccAndType<box::CSampleGroupDescriptionBox>(
-            tree[i], ilo::toFcc("sgpd"));
-        m_currentSgpdBoxes.insert(m_currentSgpdBoxes.begin(), sgpdTrakBoxes.begin(),
+        // Sample groups of the traf apply to this traf only, the ones of moov to all
+        fragment.sgpdBoxes =
+            findAllBoxesWithFourccAndType<box::CSampleGroupDescriptionBox>(traf.get(), "sgpd"_fcc);
+        fragment.sgpdBoxes.insert(fragment.sgpdBoxes.begin(), sgpdTrakBoxes.begin(),
                                   sgpdTrakBoxes.end());
-        m_currentSbgpBoxes =
-            findAllBoxesWithFourccAndType<box::CSampleToGroupBox>(tree[i], ilo::toFcc("sbgp"));
+        fragment.sbgpBoxes =
+            findAllBoxesWithFourccAndType<box::CSampleToGroupBox>(traf.get(), "sbgp"_fcc);
         ILO_ASSERT(
-            m_currentSbgpBoxes.size() <= m_currentSgpdBoxes.size(),
+            fragment.sbgpBoxes.size() <= fragment.sgpdBoxes.size(),
             "Malformed tree found. At least one track has a sbgp box without having a sgpd box");
 
         for (auto& trex : trexBoxes) {
-          if (trex->trackID() == m_currentTfhdBox->trackId()) {
-            m_currentTrexBox = trex;
+          if (trex->trackID() == fragment.tfhd->trackId()) {
+            fragment.trex = trex;
           }
         }
 
         for (size_t j = 0; j < tkhdBoxes.size(); ++j) {
-          if (tkhdBoxes[j]->trackID() == m_currentTfhdBox->trackId()) {
-            m_currentMdhdBox = mhdhBoxes[j];
+          if (tkhdBoxes[j]->trackID() == fragment.tfhd->trackId()) {
+            fragment.mdhd = mhdhBoxes[j];
           }
         }
 
-        uint64_t dataOffset = calculateDataOffset(totalDataOffset);
-
-        fillSampleInfoTable(dataOffset);
+        fragment.dataOffset = calculateDataOffset(fragment, totalDataOffset);
+        fragments.push_back(std::move(fragment));
       }
     }
     totalDataOffset += tree[i].item->size();
   }
+
+  tools::parallelFor(fragments.size(), threadCount,
+                     [&fragments](size_t i) { fillSampleInfoTable(fragments[i]); });
+
+  // Stitching has to follow the fragment order, it determines the decoding times
+  for (auto& fragment : fragments) {
+    appendTrackFragment(fragment);
+    fragment.samples = CTrackSampleInfo();
+  }
+  for (auto& track : *m_sampleInfoTable) {
+    track.second.shrinkToFit(memoryResource);
+  }
 }
 
-uint64_t CFragmentedSampleExtractor::calculateDataOffset(uint64_t totalDataOffset) {
+uint64_t CFragmentedSampleExtractor::calculateDataOffset(const STrackFragment& fragment,
+                                                         uint64_t totalDataOffset) {
   uint64_t dataOffset = 0;
 
-  if (m_currentTfhdBox->baseDataOffsetPresent()) {
-    dataOffset = m_currentTfhdBox->baseDataOffset();
-  } else if (m_currentTfhdBox->defaultBaseIsMoof()) {
+  if (fragment.tfhd->baseDataOffsetPresent()) {
+    dataOffset = fragment.tfhd->baseDataOffset();
+  } else if (fragment.tfhd->defaultBaseIsMoof()) {
     dataOffset = totalDataOffset;
   } else {
     ILO_ASSERT(false, "Data offset mode not implemented");
@@ -305,46 +339,75 @@ uint64_t CFragmentedSampleExtractor::calculateDataOffset(uint64_t totalDataOffse
   return dataOffset;
 }
 
-void CFragmentedSampleExtractor::fillSampleInfoTable(uint64_t dataOffset) {
-  auto trunEntries = m_currentTrunBox->trunEntries();
+void CFragmentedSampleExtractor::fillSampleInfoTable(STrackFragment& fragment) {
+  const auto& trunEntries = fragment.trun->trunEntries();
 
   uint64_t currentSampleOffset = 0;
-  uint64_t currentDtsValue = 0;
-  if (m_currentTfdtBox) {
-    currentDtsValue = m_currentTfdtBox->baseMediaDecodeTime();
-  } else {
+  int64_t currentDtsValue = 0;
+  if (!fragment.tfdt) {
     ILO_LOG_INFO("Fragment does not contain tfdt box (optional).");
   }
 
-  createSampleToSampleGroupInfoMap(trunEntries.size());
+  if (trunEntries.empty()) {
+    return;
+  }
+
+  // Sample group mappings are reset for every track fragment
+  auto sampleGroupMappings =
+      createSampleGroupMappings(fragment.sgpdBoxes, fragment.sbgpBoxes, trunEntries.size());
 
   for (size_t index = 0; index < trunEntries.size(); index++) {
     CMetaSample metaSample;
 
-    setSampleSize(trunEntries[index], metaSample);
-    setSampleDuration(trunEntries[index], metaSample);
-    setSampleCtsOffset(trunEntries[index], metaSample);
-    setSampleOffset(dataOffset, currentSampleOffset, metaSample);
-    setSampleFragmentNumber(metaSample);
-    setSyncSampleFlag(index, trunEntries[index], metaSample);
-    setTimeScale(metaSample);
-    setSampleSampleGroupInfoFrag(index, metaSample);
+    setSampleSize(fragment, trunEntries[index], metaSample);
+    setSampleDuration(fragment, trunEntries[index], metaSample);
+    setSampleCtsOffset(fragment, trunEntries[index], metaSample);
+    setSampleOffset(fragment, currentSampleOffset, metaSample);
+    setSampleFragmentNumber(fragment, metaSample);
+    setSyncSampleFlag(fragment, index, trunEntries[index], metaSample);
+    setSampleSampleGroupInfo(sampleGroupMappings, index, metaSample.sampleGroupInfo);
 
     currentSampleOffset += metaSample.size;
-    metaSample.dtsValue = static_cast<int64_t>(currentDtsValue);
-    currentDtsValue += metaSample.duration;
-    (*m_sampleInfoTable)[m_currentTfhdBox->trackId()].push_back(metaSample);
+    metaSample.dtsValue = currentDtsValue;
+    currentDtsValue += static_cast<int64_t>(metaSample.duration);
+    fragment.samples.push_back(metaSample);
   }
 }
 
-void CFragmentedSampleExtractor::setSampleSize(const box::CTrunEntry& trunEntry,
+void CFragmentedSampleExtractor::appendTrackFragment(const STrackFragment& fragment) {
+  if (fragment.samples.empty()) {
+    return;
+  }
+
+  auto trackId = fragment.tfhd->trackId();
+  auto trackSampleInfoIter = m_sampleInfoTable->find(trackId);
+  if (trackSampleInfoIter == m_sampleInfoTable->end()) {
+    trackSampleInfoIter = m_sampleInfoTable->emplace(trackId, CTrackSampleInfo(trackId)).first;
+  }
+  auto& trackSampleInfo = trackSampleInfoIter->second;
+  setTimeScale(fragment, trackSampleInfo);
+
+  // Without tfdt the fragment starts where the previous fragment of the track ended
+  int64_t dtsOffset = 0;
+  if (fragment.tfdt) {
+    dtsOffset = static_cast<int64_t>(fragment.tfdt->baseMediaDecodeTime());
+  } else if (!trackSampleInfo.empty()) {
+    auto lastSample = trackSampleInfo.size() - 1;
+    dtsOffset = trackSampleInfo.dtsValue(lastSample) +
+                static_cast<int64_t>(trackSampleInfo.sampleDuration(lastSample));
+  }
+  trackSampleInfo.appendSamples(fragment.samples, dtsOffset);
+}
+
+void CFragmentedSampleExtractor::setSampleSize(const STrackFragment& fragment,
+                                               const box::CTrunEntry& trunEntry,
                                                CMetaSample& metaSample) {
-  if (m_currentTrunBox->sampleSizePresent()) {
+  if (fragment.trun->sampleSizePresent()) {
     metaSample.size = trunEntry.sampleSize();
-  } else if (m_currentTfhdBox->defaultSampleSizePresent()) {
-    metaSample.size = m_currentTfhdBox->defaultSampleSize();
-  } else if (m_currentTrexBox) {
-    metaSample.size = m_currentTrexBox->defaultSampleSize();
+  } else if (fragment.tfhd->defaultSampleSizePresent()) {
+    metaSample.size = fragment.tfhd->defaultSampleSize();
+  } else if (fragment.trex) {
+    metaSample.size = fragment.trex->defaultSampleSize();
   } else {
     ILO_LOG_ERROR("Sample with size zero found");
   }
@@ -355,119 +418,139 @@ void CFragmentedSampleExtractor::setSampleSize(const box::CTrunEntry& trunEntry,
                   metaSample.size, limits::MAX_SAMPLE_SIZE);
 }
 
-void CFragmentedSampleExtractor::setSampleDuration(const box::CTrunEntry& trunEntry,
+void CFragmentedSampleExtractor::setSampleDuration(const STrackFragment& fragment,
+                                                   const box::CTrunEntry& trunEntry,
                                                    CMetaSample& metaSample) {
-  if (m_currentTrunBox->sampleDurationPresent()) {
+  if (fragment.trun->sampleDurationPresent()) {
     metaSample.duration = trunEntry.sampleDuration();
-  } else if (m_currentTfhdBox->defaultSampleDurationPresent()) {
-    metaSample.duration = m_currentTfhdBox->defaultSampleDuration();
-  } else if (m_currentTrexBox) {
-    metaSample.duration = m_currentTrexBox->defaultSampleDuration();
+  } else if (fragment.tfhd->defaultSampleDurationPresent()) {
+    metaSample.duration = fragment.tfhd->defaultSampleDuration();
+  } else if (fragment.trex) {
+    metaSample.duration = fragment.trex->defaultSampleDuration();
   } else {
     ILO_LOG_ERROR("No sample duration present");
   }
 }
 
-void CFragmentedSampleExtractor::setSampleCtsOffset(const box::CTrunEntry& trunEntry,
+void CFragmentedSampleExtractor::setSampleCtsOffset(const STrackFragment& fragment,
+                                                    const box::CTrunEntry& trunEntry,
                                                     CMetaSample& metaSample) {
-  if (m_currentTrunBox->sampleCtsOffsetPresent()) {
+  if (fragment.trun->sampleCtsOffsetPresent()) {
     metaSample.ctsOffset = trunEntry.sampleCtsOffset();
   } else {
     metaSample.ctsOffset = 0;
   }
 }
 
-void CFragmentedSampleExtractor::setSampleOffset(uint64_t dataOffset, uint64_t currentSampleOffset,
+void CFragmentedSampleExtractor::setSampleOffset(const STrackFragment& fragment,
+                                                 uint64_t currentSampleOffset,
                                                  CMetaSample& metaSample) {
-  metaSample.offset = dataOffset + currentSampleOffset;
+  metaSample.offset = fragment.dataOffset + currentSampleOffset;
 
-  if (m_currentTrunBox->dataOffsetPresent()) {
-    metaSample.offset += static_cast<uint64_t>(m_currentTrunBox->dataOffset());
+  if (fragment.trun->dataOffsetPresent()) {
+    metaSample.offset += static_cast<uint64_t>(fragment.trun->dataOffset());
   }
 }
 
-void CFragmentedSampleExtractor::setSampleFragmentNumber(CMetaSample& metaSample) {
-  metaSample.fragmentNumber = m_currentMfhdBox->sequenceNumber();
+void CFragmentedSampleExtractor::setSampleFragmentNumber(const STrackFragment& fragment,
+                                                         CMetaSample& metaSample) {
+  metaSample.fragmentNumber = fragment.mfhd->sequenceNumber();
 }
 
-void CFragmentedSampleExtractor::setSyncSampleFlag(const size_t index,
+void CFragmentedSampleExtractor::setSyncSampleFlag(const STrackFragment& fragment,
+                                                   const size_t index,
                                                    const box::CTrunEntry& trunEntry,
                                                    CMetaSample& metaSample) {
-  if (index == 0 && m_currentTrunBox->sampleFlagsPresent() &&
-      m_currentTrunBox->firstSampleFlagsPresent()) {
+  if (index == 0 && fragment.trun->sampleFlagsPresent() &&
+      fragment.trun->firstSampleFlagsPresent()) {
     ILO_LOG_WARNING("Both sample and first sample flags found. Using first sample flags");
   }
 
-  if (index == 0 && m_currentTrunBox->firstSampleFlagsPresent()) {
+  if (index == 0 && fragment.trun->firstSampleFlagsPresent()) {
     metaSample.isSyncSample =
-        ((m_currentTrunBox->firstSampleFlags() & 0x10000) >> 16 == 1) ? false : true;
-  } else if (m_currentTrunBox->sampleFlagsPresent()) {
+        ((fragment.trun->firstSampleFlags() & 0x10000) >> 16 == 1) ? false : true;
+  } else if (fragment.trun->sampleFlagsPresent()) {
     metaSample.isSyncSample = ((trunEntry.sampleFlags() & 0x10000) >> 16 == 1) ? false : true;
-  } else if (m_currentTfhdBox->defaultSampleFlagsPresent()) {
+  } else if (fragment.tfhd->defaultSampleFlagsPresent()) {
     metaSample.isSyncSample =
-        ((m_currentTfhdBox->defaultSampleFlags() & 0x10000) >> 16 == 1) ? false : true;
-  } else if (m_currentTrexBox) {
+        ((fragment.tfhd->defaultSampleFlags() & 0x10000) >> 16 == 1) ? false : true;
+  } else if (fragment.trex) {
     metaSample.isSyncSample =
-        ((m_currentTrexBox->defaultSampleFlags() & 0x10000) >> 16 == 1) ? false : true;
+        ((fragment.trex->defaultSampleFlags() & 0x10000) >> 16 == 1) ? false : true;
   } else {
     metaSample.isSyncSample = true;
   }
 }
 
-void CFragmentedSampleExtractor::setTimeScale(CMetaSample& metaSample) {
-  if (m_currentMdhdBox) {
-    metaSample.timeScale = m_currentMdhdBox->timescale();
+void CFragmentedSampleExtractor::setTimeScale(const STrackFragment& fragment,
+                                              CTrackSampleInfo& trackSampleInfo) {
+  if (fragment.mdhd) {
+    trackSampleInfo.setTimeScale(fragment.mdhd->timescale());
   } else {
     ILO_LOG_ERROR(
         "No mdhd box found to get timescale from. "
         "Timescale value on sampleMetadata will be 0");
-    metaSample.timeScale = 0;
+    trackSampleInfo.setTimeScale(0);
   }
 }
 
-void CFragmentedSampleExtractor::setSampleSampleGroupInfoFrag(const size_t& metaSampleIndex,
-                                                              CMetaSample& metaSample) {
-  if (m_SampleGroupSampleMap.size() == 0) {
-    // No sample group info. Leave default
-    return;
-  }
-  setSampleSampleGroupInfo(m_SampleGroupSampleMap.at(metaSampleIndex), metaSample);
-}
-
 std::shared_ptr<TrackIdToTrackSampleInfo> CFragmentedSampleExtractor::trackIdToTrackSampleInfo()
     const {
   return m_sampleInfoTable;
 }
 
-CRegularSampleExtractor::CRegularSampleExtractor(const BoxTree& tree) {
+CRegularSampleExtractor::CRegularSampleExtractor(
+    const BoxTree& tree, uint32_t trackId, size_t threadCount,
+    const std::shared_ptr<IMemoryResource>& memoryResource) {
   m_sampleInfoTable = std::make_shared<TrackIdToTrackSampleInfo>();
 
-  auto moovNode = findFirstElementWithFourccAndBoxType<box::IBox>(tree, ilo::toFcc("moov"));
-  auto traks =
-      findAllElementsWithFourccAndBoxType<box::CContainerBox>(moovNode, ilo::toFcc("trak"));
+  auto moovNode = findFirstElementWithFourccAndBoxType<box::IBox>(tree, "moov"_fcc);
+  auto traks = findAllElementsWithFourccAndBoxType<box::CContainerBox>(moovNode, "trak"_fcc);
 
+  decltype(traks) selectedTraks;
+  std::vector<CTrackSampleInfo> trackSampleInfos;
   for (auto trak : traks) {
-    m_currentSgpdBoxes =
-        findAllBoxesWithFourccAndType<box::CSampleGroupDescriptionBox>(trak, ilo::toFcc("sgpd"));
-    m_currentSbgpBoxes =
-        findAllBoxesWithFourccAndType<box::CSampleToGroupBox>(trak, ilo::toFcc("sbgp"));
-
-    auto trakBox = findFirstBoxWithType<box::CTrackHeaderBox>(trak);
-    ILO_ASSERT(trakBox, "No trak box found");
-    auto trackId = trakBox->trackID();
-    setSampleSizes(trackId, trak.get());  // has to come first since it populates the vector
-    setSampleDurations(trackId, trak.get());
-    setSampleOffsets(trackId, trak.get());
-    setSampleCtsOffsets(trackId, trak.get());
-    setSyncSampleFlag(trackId, trak.get());
-    setTimeScale(trackId, trak.get());
-    // order is important here
-    createSampleToSampleGroupInfoMap((*m_sampleInfoTable)[trackId].size());
-    setSampleSampleGroupInfoRegular(trackId);
-  }
-}
-
-void CRegularSampleExtractor::setSampleSizes(const uint32_t& trackId, const BoxElement& node) {
+    auto tkhd = findFirstBoxWithType<box::CTrackHeaderBox>(trak);
+    ILO_ASSERT(tkhd, "No trak box found");
+    if (trackId != 0 && tkhd->trackID() != trackId) {
+      continue;
+    }
+    selectedTraks.push_back(trak);
+    trackSampleInfos.emplace_back(tkhd->trackID());
+  }
+
+  // Tracks do not share any state, so they are extracted independently
+  tools::parallelFor(selectedTraks.size(), threadCount, [&](size_t i) {
+    fillSampleInfoTable(trackSampleInfos[i], selectedTraks[i].get());
+  });
+
+  for (auto& trackSampleInfo : trackSampleInfos) {
+    trackSampleInfo.shrinkToFit(memoryResource);
+    (*m_sampleInfoTable)[trackSampleInfo.trackId()] = std::move(trackSampleInfo);
+  }
+}
+
+void CRegularSampleExtractor::fillSampleInfoTable(CTrackSampleInfo& trackSampleInfo,
+                                                  const BoxElement& trak) {
+  auto sgpdBoxes = findAllBoxesWithFourccAndType<box::CSampleGroupDescriptionBox>(trak, "sgpd"_fcc);
+  auto sbgpBoxes = findAllBoxesWithFourccAndType<box::CSampleToGroupBox>(trak, "sbgp"_fcc);
+
+  setSampleSizes(trackSampleInfo, trak);  // has to come first since it populates the vector
+  setSampleDurations(trackSampleInfo, trak);
+  setSampleOffsets(trackSampleInfo, trak);
+  setSampleCtsOffsets(trackSampleInfo, trak);
+  setSyncSampleFlag(trackSampleInfo, trak);
+  setTimeScale(trackSampleInfo, trak);
+  // order is important here
+  auto sampleGroupMappings =
+      createSampleGroupMappings(sgpdBoxes, sbgpBoxes, trackSampleInfo.size());
+  setSampleSampleGroupInfoRegular(trackSampleInfo, sampleGroupMappings);
+  // Regular files have no fragments
+  trackSampleInfo.appendFragmentNumber(0, trackSampleInfo.size());
+}
+
+void CRegularSampleExtractor::setSampleSizes(CTrackSampleInfo& trackSampleInfo,
+                                             const BoxElement& node) {
   auto stsz = findFirstBoxWithType<box::CSampleSizeBox>(node);
   auto stz2 = findFirstBoxWithType<box::CCompactSampleSizeBox>(node);
 
@@ -475,55 +558,52 @@ void CRegularSampleExtractor::setSampleSizes(const uint32_t& trackId, const BoxE
   ILO_ASSERT(stsz == nullptr || stz2 == nullptr,
              "stsz and stz2 boxes can't exist at the same time.");
 
-  m_sampleCount = stsz != nullptr ? stsz->sampleCount() : stz2->sampleCount();
-  uint64_t defaultSampleSize = stsz == nullptr ? 0 : stsz->sampleSize();
-  const auto sizeEntriesStsz = stsz != nullptr ? stsz->entrySize() : std::vector<uint32_t>();
-  const auto sizeEntriesStz2 = stz2 != nullptr ? stz2->entrySizes() : std::vector<uint16_t>();
-  auto sizeEntriesStszSize = sizeEntriesStsz.size();
-  auto sizeEntriesStz2Size = sizeEntriesStz2.size();
+  const uint32_t sampleCount = stsz != nullptr ? stsz->sampleCount() : stz2->sampleCount();
+  uint32_t defaultSampleSize = stsz == nullptr ? 0 : stsz->sampleSize();
 
-  ILO_ASSERT_WITH(m_sampleCount <= limits::MAX_NUM_SAMPLES, std::length_error,
-                  "Number of samples of %u exceed the limit of %u", m_sampleCount,
+  ILO_ASSERT_WITH(sampleCount <= limits::MAX_NUM_SAMPLES, std::length_error,
+                  "Number of samples of %u exceed the limit of %u", sampleCount,
                   limits::MAX_NUM_SAMPLES);
 
-  auto& currentSampleInfos = (*m_sampleInfoTable)[trackId];
-  currentSampleInfos.resize(m_sampleCount);
-
-  for (auto i = 0U; i < m_sampleCount; ++i) {
-    if (defaultSampleSize) {
-      currentSampleInfos[i].size = defaultSampleSize;
-    } else if (sizeEntriesStszSize) {
-      currentSampleInfos[i].size = sizeEntriesStsz[i];
-    } else if (sizeEntriesStz2Size) {
-      currentSampleInfos[i].size = sizeEntriesStz2[i];
-    }
-
-    ILO_ASSERT_WITH(currentSampleInfos[i].size <= limits::MAX_SAMPLE_SIZE, std::length_error,
-                    "Sample size of %zu found that exceeds maximum allowed size of %zu",
-                    currentSampleInfos[i].size, limits::MAX_SAMPLE_SIZE);
+  // Validated once for the whole table instead of per sample
+  if (defaultSampleSize) {
+    trackSampleInfo.appendSize(defaultSampleSize, sampleCount);
+  } else if (stsz != nullptr && !stsz->entrySize().empty()) {
+    ILO_ASSERT(stsz->entrySize().size() >= sampleCount, "stsz does not have enough entries");
+    trackSampleInfo.appendSizes(stsz->entrySize().data(), sampleCount);
+  } else if (stz2 != nullptr && !stz2->entrySizes().empty()) {
+    ILO_ASSERT(stz2->entrySizes().size() >= sampleCount, "stz2 does not have enough entries");
+    trackSampleInfo.appendSizes(stz2->entrySizes().data(), sampleCount);
+  } else {
+    trackSampleInfo.appendSize(0, sampleCount);
   }
+
+  ILO_ASSERT_WITH(trackSampleInfo.maxSampleSize() <= limits::MAX_SAMPLE_SIZE, std::length_error,
+                  "Sample size of %zu found that exceeds maximum allowed size of %zu",
+                  static_cast<size_t>(trackSampleInfo.maxSampleSize()),
+                  limits::MAX_SAMPLE_SIZE);
 }
 
-void CRegularSampleExtractor::setSampleDurations(const uint32_t& trackId, const BoxElement& node) {
+void CRegularSampleExtractor::setSampleDurations(CTrackSampleInfo& trackSampleInfo,
+                                                 const BoxElement& node) {
   auto stts = findFirstBoxWithType<box::CDecodingTimeToSampleBox>(node);
   ILO_ASSERT(stts != nullptr, "no stts box found");
   size_t totalSampleCount = 0;
   int64_t currentDtsValue = 0;
-  const size_t sampleInfoEntries = (*m_sampleInfoTable)[trackId].size();
+  const size_t sampleInfoEntries = trackSampleInfo.size();
   const auto& sttsEntries = stts->entries();
   const auto nrOfSttsEntries = sttsEntries.size();
-  auto& currentTrackSampleInfos = (*m_sampleInfoTable)[trackId];
   for (auto i = 0U; i < nrOfSttsEntries; ++i) {
-    for (auto n = 0U; n < sttsEntries[i].sampleCount; ++n) {
-      ILO_ASSERT(totalSampleCount < sampleInfoEntries, "stts: sample duration count too high");
-      currentTrackSampleInfos[totalSampleCount].duration = sttsEntries[i].sampleDelta;
-      currentTrackSampleInfos[totalSampleCount].dtsValue = currentDtsValue;
-      currentDtsValue += sttsEntries[i].sampleDelta;
-      totalSampleCount++;
-    }
+    const auto sampleCount = sttsEntries[i].sampleCount;
+    ILO_ASSERT(sampleCount <= sampleInfoEntries - totalSampleCount,
+               "stts: sample duration count too high");
+    // An stts entry maps to a single run of the table
+    trackSampleInfo.appendTiming(sttsEntries[i].sampleDelta, currentDtsValue, sampleCount);
+    currentDtsValue += static_cast<int64_t>(static_cast<uint64_t>(sttsEntries[i].sampleDelta) *
+                                            sampleCount);
+    totalSampleCount += sampleCount;
   }
-  ILO_ASSERT(totalSampleCount == (*m_sampleInfoTable)[trackId].size(),
-             "stts does not have enough entries");
+  ILO_ASSERT(totalSampleCount == trackSampleInfo.size(), "stts does not have enough entries");
 }
 
 std::vector<uint32_t> getChunkCountPerEntry(const box::CSampleToChunkBox::CVectorEntry& entry_list,
@@ -548,15 +628,20 @@ uint32_t totalChunkCount(const stco_type& stco, const co64_type& co64) {
   return static_cast<uint32_t>(co64->chunkOffsets().size());
 }
 
-template <class stco_type, class co64_type>
-uint64_t getChunkOffsetByIndex(const stco_type& stco, const co64_type& co64, uint32_t index) {
-  if (stco != nullptr) {
-    return stco->chunkOffsets().at(index);
+template <class offset_type>
+void appendChunks(CTrackSampleInfo& trackSampleInfo, const std::vector<offset_type>& chunkOffsets,
+                  const box::CSampleToChunkBox::CVectorEntry& sampleToChunkEntries,
+                  const std::vector<uint32_t>& chunkCountPerEntry) {
+  for (size_t i = 0; i < sampleToChunkEntries.size(); ++i) {
+    const offset_type* chunkOffset = &chunkOffsets[sampleToChunkEntries[i].first_chunk - 1];
+    for (uint32_t c = 0; c < chunkCountPerEntry[i]; ++c) {
+      trackSampleInfo.appendChunk(chunkOffset[c], sampleToChunkEntries[i].samples_per_chunk);
+    }
   }
-  return co64->chunkOffsets().at(index);
 }
 
-void CRegularSampleExtractor::setSampleOffsets(const uint32_t& trackId, const BoxElement& node) {
+void CRegularSampleExtractor::setSampleOffsets(CTrackSampleInfo& trackSampleInfo,
+                                               const BoxElement& node) {
   auto stco = findFirstBoxWithType<box::CChunkOffsetBox>(node);
   auto co64 = findFirstBoxWithType<box::CChunkOffset64Box>(node);
   ILO_ASSERT(((stco == nullptr && co64 != nullptr) || (co64 == nullptr && stco != nullptr)),
@@ -568,101 +653,93 @@ void CRegularSampleExtractor::setSampleOffsets(const uint32_t& trackId, const Bo
   auto sampleToChunkEntries = stsc->entries();
 
   if (!sampleToChunkEntries.size()) {
-    ILO_ASSERT(!(*m_sampleInfoTable)[trackId].size(), "stsc does not have enough entries");
+    ILO_ASSERT(!trackSampleInfo.size(), "stsc does not have enough entries");
     return;
   }
 
   ILO_ASSERT(sampleToChunkEntries.size() && sampleToChunkEntries.front().first_chunk == 1,
              "first chunk of first record in stsc must be 1");
 
-  auto chunkCountPerEntry =
-      getChunkCountPerEntry(sampleToChunkEntries, totalChunkCount(stco, co64));
+  const uint32_t chunkCount = totalChunkCount(stco, co64);
+  auto chunkCountPerEntry = getChunkCountPerEntry(sampleToChunkEntries, chunkCount);
 
-  size_t totalSampleCount = 0;
-  uint64_t sampleOffset = 0;
+  const size_t nrOfSampleInfos = trackSampleInfo.size();
 
-  auto& currentSampleInfos = (*m_sampleInfoTable)[trackId];
-  const size_t nrOfSampleInfos = currentSampleInfos.size();
-
-  for (auto i = 0U; i < sampleToChunkEntries.size(); ++i) {
-    auto chunk_index = sampleToChunkEntries[i].first_chunk - 1;
-
-    for (auto c = 0U; c < chunkCountPerEntry[i]; ++c) {
-      sampleOffset = getChunkOffsetByIndex(stco, co64, chunk_index);
-      for (auto s = 0U; s < sampleToChunkEntries[i].samples_per_chunk; ++s) {
-        ILO_ASSERT(totalSampleCount < nrOfSampleInfos, "stsc: sample chunk offset count too high");
-        currentSampleInfos[totalSampleCount].offset = sampleOffset;
-
-        const auto currSize = currentSampleInfos[totalSampleCount].size;
-        ILO_ASSERT(sampleOffset + currSize <= std::numeric_limits<uint64_t>::max(),
-                   "sample offset exceeds the maximum length!");
-
-        sampleOffset += currSize;
-        totalSampleCount++;
-      }
-      ++chunk_index;
-    }
+  // Validate the chunk layout once, so the expansion below needs no per sample checks
+  uint64_t totalSampleCount = 0;
+  for (size_t i = 0; i < sampleToChunkEntries.size(); ++i) {
+    const auto& entry = sampleToChunkEntries[i];
+    ILO_ASSERT(i == 0 || entry.first_chunk > sampleToChunkEntries[i - 1].first_chunk,
+               "stsc: first chunks are not increasing");
+    ILO_ASSERT(entry.first_chunk - 1 + uint64_t{chunkCountPerEntry[i]} <= chunkCount,
+               "stsc: chunk index exceeds the number of chunk offsets");
+    totalSampleCount += uint64_t{chunkCountPerEntry[i]} * entry.samples_per_chunk;
   }
+  ILO_ASSERT(totalSampleCount <= nrOfSampleInfos, "stsc: sample chunk offset count too high");
+  ILO_ASSERT(totalSampleCount == nrOfSampleInfos, "stsc does not have enough entries");
 
-  ILO_ASSERT(totalSampleCount == (*m_sampleInfoTable)[trackId].size(),
-             "stsc does not have enough entries");
+  if (stco != nullptr) {
+    appendChunks(trackSampleInfo, stco->chunkOffsets(), sampleToChunkEntries,
+                 chunkCountPerEntry);
+  } else {
+    appendChunks(trackSampleInfo, co64->chunkOffsets(), sampleToChunkEntries,
+                 chunkCountPerEntry);
+  }
 }
 
-void CRegularSampleExtractor::setSampleCtsOffsets(const uint32_t& trackId, const BoxElement& node) {
+void CRegularSampleExtractor::setSampleCtsOffsets(CTrackSampleInfo& trackSampleInfo,
+                                                  const BoxElement& node) {
   auto ctts = findFirstBoxWithType<box::CCompositionTimeToSampleBox>(node);
   if (ctts == nullptr) {
+    trackSampleInfo.appendCtsOffset(0, trackSampleInfo.size());
     return;
   }
 
-  uint32_t totalSampleCount = 0;
+  size_t totalSampleCount = 0;
 
   for (const auto& entry : ctts->entries()) {
-    for (auto i = 0U; i < entry.sampleCount; ++i) {
-      ILO_ASSERT(totalSampleCount < (*m_sampleInfoTable)[trackId].size(),
-                 "ctts: entry count too high");
-      (*m_sampleInfoTable)[trackId].at(totalSampleCount++).ctsOffset = entry.sampleOffset;
-    }
+    ILO_ASSERT(entry.sampleCount <= trackSampleInfo.size() - totalSampleCount,
+               "ctts: entry count too high");
+    trackSampleInfo.appendCtsOffset(entry.sampleOffset, entry.sampleCount);
+    totalSampleCount += entry.sampleCount;
   }
-  ILO_ASSERT(totalSampleCount == (*m_sampleInfoTable)[trackId].size(),
-             "ctts does not have enough entries");
+  ILO_ASSERT(totalSampleCount == trackSampleInfo.size(), "ctts does not have enough entries");
 }
 
-void CRegularSampleExtractor::setSyncSampleFlag(const uint32_t& trackId, const BoxElement& node) {
+void CRegularSampleExtractor::setSyncSampleFlag(CTrackSampleInfo& trackSampleInfo,
+                                                const BoxElement& node) {
   auto stss = findFirstBoxWithType<box::CSyncSampleTableBox>(node);
-  if (stss == nullptr) {
-    for (auto& entry : (*m_sampleInfoTable)[trackId]) {
-      entry.isSyncSample = true;
-    }
-  } else {
+  // Without stss box every sample is a sync sample
+  trackSampleInfo.appendSyncSamples(stss == nullptr, trackSampleInfo.size());
+  if (stss != nullptr) {
     for (const auto& entry : stss->entries()) {
       ILO_ASSERT(entry.sampleNumber > 0,
                  "Sample Number 0 is not defined in Sync Sample Box stss. Box is not zero-indexed");
-      (*m_sampleInfoTable)[trackId].at(entry.sampleNumber - 1).isSyncSample = true;
+      trackSampleInfo.setSyncSample(entry.sampleNumber - 1);
     }
   }
 }
 
-void CRegularSampleExtractor::setTimeScale(const uint32_t& trackId, const BoxElement& node) {
+void CRegularSampleExtractor::setTimeScale(CTrackSampleInfo& trackSampleInfo,
+                                           const BoxElement& node) {
   auto mdhd = findFirstBoxWithType<box::CMediaHeaderBox>(node);
   ILO_ASSERT(mdhd != nullptr, "No mdhd box found to get timescale from");
 
-  for (auto& sampleInfo : (*m_sampleInfoTable)[trackId]) {
-    sampleInfo.timeScale = mdhd->timescale();
-  }
+  trackSampleInfo.setTimeScale(mdhd->timescale());
 }
 
-void CRegularSampleExtractor::setSampleSampleGroupInfoRegular(const uint32_t& trackId) {
-  if (m_SampleGroupSampleMap.size() == 0) {
+void CRegularSampleExtractor::setSampleSampleGroupInfoRegular(
+    CTrackSampleInfo& trackSampleInfo, const SampleGroupMappings& mappings) {
+  if (mappings.empty()) {
     // No sample group info. Leave default
+    trackSampleInfo.appendSampleGroupInfo(SSampleGroupInfo(), trackSampleInfo.size());
     return;
   }
 
-  auto& currentSampleInfos = (*m_sampleInfoTable)[trackId];
-  ILO_ASSERT(currentSampleInfos.size() == m_SampleGroupSampleMap.size(),
-             "SampleInfo table and SampleGroupInfo table are of different size.");
-
-  for (size_t i = 0; i < currentSampleInfos.size(); ++i) {
-    setSampleSampleGroupInfo(m_SampleGroupSampleMap[i], currentSampleInfos[i]);
+  for (size_t i = 0; i < trackSampleInfo.size(); ++i) {
+    SSampleGroupInfo sampleGroupInfo;
+    setSampleSampleGroupInfo(mappings, i, sampleGroupInfo);
+    trackSampleInfo.appendSampleGroupInfo(sampleGroupInfo);
   }
 }
 
@@ -671,12 +748,123 @@ std::shared_ptr<TrackIdToTrackSampleInfo> CRegularSampleExtractor::trackIdToTrac
   return m_sampleInfoTable;
 }
 
-std::unique_ptr<ISampleExtractor> CSampleExtractorFactory::create(const BoxTree& tree) {
-  auto moofBox = findFirstBoxWithFourccAndType<box::CContainerBox>(tree, ilo::toFcc("moof"));
+std::unique_ptr<ISampleExtractor> CSampleExtractorFactory::create(
+    const BoxTree& tree, uint32_t trackId, size_t threadCount,
+    const std::shared_ptr<IMemoryResource>& memoryResource) {
+  auto moofBox = findFirstBoxWithFourccAndType<box::CContainerBox>(tree, "moof"_fcc);
   if (moofBox != nullptr) {
-    return std::unique_ptr<ISampleExtractor>(new CFragmentedSampleExtractor(tree));
+    return std::unique_ptr<ISampleExtractor>(
+        new CFragmentedSampleExtractor(tree, trackId, threadCount, memoryResource));
   }
-  return std::unique_ptr<ISampleExtractor>(new CRegularSampleExtractor(tree));
+  return std::unique_ptr<ISampleExtractor>(
+      new CRegularSampleExtractor(tree, trackId, threadCount, memoryResource));
+}
+
+namespace {
+STrackSampleSummary summarizeRegularTrackSamples(const BoxTree& tree, uint32_t trackId) {
+  STrackSampleSummary summary;
+  auto traks = findAllElementsWithFourccAndBoxType<box::CContainerBox>(tree, "trak"_fcc);
+  for (const auto& trak : traks) {
+    auto tkhd = findFirstBoxWithType<box::CTrackHeaderBox>(trak);
+    if (tkhd == nullptr || tkhd->trackID() != trackId) {
+      continue;
+    }
+
+    summary.hasSampleData = true;
+    auto stsz = findFirstBoxWithType<box::CSampleSizeBox>(trak);
+    auto stz2 = findFirstBoxWithType<box::CCompactSampleSizeBox>(trak);
+    if (stsz != nullptr) {
+      summary.sampleCount = stsz->sampleCount();
+      summary.maxSampleSize = stsz->sampleSize();
+      for (auto size : stsz->entrySize()) {
+        summary.maxSampleSize = std::max<uint64_t>(summary.maxSampleSize, size);
+      }
+    } else if (stz2 != nullptr) {
+      summary.sampleCount = stz2->sampleCount();
+      for (auto size : stz2->entrySizes()) {
+        summary.maxSampleSize = std::max<uint64_t>(summary.maxSampleSize, size);
+      }
+    }
+
+    auto stts = findFirstBoxWithType<box::CDecodingTimeToSampleBox>(trak);
+    if (stts != nullptr) {
+      for (const auto& entry : stts->entries()) {
+        summary.durationSum += static_cast<uint64_t>(entry.sampleCount) * entry.sampleDelta;
+      }
+    }
+  }
+  return summary;
+}
+
+STrackSampleSummary summarizeFragmentedTrackSamples(const BoxTree& tree, uint32_t trackId) {
+  STrackSampleSummary summary;
+
+  std::shared_ptr<box::CTrackExtendsBox> trex;
+  auto trexBoxes = findAllBoxesWithFourccAndType<box::CTrackExtendsBox>(tree, "trex"_fcc);
+  for (const auto& trexBox : trexBoxes) {
+    if (trexBox->trackID() == trackId) {
+      trex = trexBox;
+    }
+  }
+
+  // Same default order as used by CFragmentedSampleExtractor: trun, tfhd, trex
+  auto trafs = findAllElementsWithFourccAndBoxType<box::CContainerBox>(tree, "traf"_fcc);
+  for (const auto& traf : trafs) {
+    auto tfhd =
+        findFirstBoxWithFourccAndType<box::CTrackFragmentHeaderBox>(traf.get(), "tfhd"_fcc);
+    auto trun = findFirstBoxWithFourccAndType<box::CTrackRunBox>(traf.get(), "trun"_fcc);
+    if (tfhd == nullptr || trun == nullptr || tfhd->trackId() != trackId) {
+      continue;
+    }
+
+    const auto& trunEntries = trun->trunEntries();
+    if (trunEntries.empty()) {
+      continue;
+    }
+    summary.hasSampleData = true;
+    summary.sampleCount += trunEntries.size();
+
+    if (trun->sampleSizePresent()) {
+      for (const auto& entry : trunEntries) {
+        summary.maxSampleSize = std::max<uint64_t>(summary.maxSampleSize, entry.sampleSize());
+      }
+    } else if (tfhd->defaultSampleSizePresent()) {
+      summary.maxSampleSize = std::max<uint64_t>(summary.maxSampleSize, tfhd->defaultSampleSize());
+    } else if (trex) {
+      summary.maxSampleSize = std::max<uint64_t>(summary.maxSampleSize, trex->defaultSampleSize());
+    }
+
+    if (trun->sampleDurationPresent()) {
+      for (const auto& entry : trunEntries) {
+        summary.durationSum += entry.sampleDuration();
+      }
+    } else if (tfhd->defaultSampleDurationPresent()) {
+      summary.durationSum += static_cast<uint64_t>(tfhd->defaultSampleDuration()) *
+                             trunEntries.size();
+    } else if (trex) {
+      summary.durationSum += static_cast<uint64_t>(trex->defaultSampleDuration()) *
+                             trunEntries.size();
+    }
+  }
+  return summary;
+}
+}  // namespace
+
+STrackSampleSummary summarizeTrackSamples(const BoxTree& tree, uint32_t trackId) {
+  auto moofBox = findFirstBoxWithFourccAndType<box::CContainerBox>(tree, "moof"_fcc);
+  if (moofBox != nullptr) {
+    return summarizeFragmentedTrackSamples(tree, trackId);
+  }
+  return summarizeRegularTrackSamples(tree, trackId);
+}
+
+STrackSampleSummary summarizeTrackSamples(const CTrackSampleInfo& trackSampleInfo) {
+  STrackSampleSummary summary;
+  summary.hasSampleData = true;
+  summary.sampleCount = trackSampleInfo.size();
+  summary.maxSampleSize = trackSampleInfo.maxSampleSize();
+  summary.durationSum = trackSampleInfo.durationSum();
+  return summary;
 }
 }  // namespace isobmff
 }  // namespace mmt
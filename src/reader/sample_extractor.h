@@ -95,6 +95,7 @@ amm-info@iis.fraunhofer.de
 
 // Internal includes
 #include "common/tracksampleinfo.h"
+#include "mmtisobmff/memoryresource.h"
 #include "tree/boxtree.h"
 
 #include "box/containerbox.h"
@@ -111,88 +112,133 @@ amm-info@iis.fraunhofer.de
 
 namespace mmt {
 namespace isobmff {
-struct CSampleGroupInfo {
-  CSampleGroupInfo(const ilo::Fourcc& sGroupingType, const uint32_t& sGroupDescIndex)
-      : groupingType(sGroupingType), groupDescIndex(sGroupDescIndex) {}
-
-  ilo::Fourcc groupingType = ilo::toFcc("0000");
+//! Sample group of one grouping type assigned to consecutive samples
+struct SSampleGroupInterval {
+  size_t firstSample = 0;
+  //! Group description index of the samples, 0 or 0x10000 if they are not part of a group
   uint32_t groupDescIndex = 0;
+  //! Resolved sample group of the samples
+  SSampleGroupInfo sampleGroupInfo;
+  //! Grouping type is not supported and handled as "no sample group"
+  bool isUnknownGroupingType = false;
 };
 
-struct SDefaultConfig {
-  uint32_t startIndex = 0;
-  size_t nrOfSamples = 0;
+//! Sample to group mapping of one grouping type in the current track or track fragment
+struct SSampleGroupMapping {
+  ilo::Fourcc groupingType;
   std::shared_ptr<box::CSampleGroupDescriptionBox> sgpd = nullptr;
+  //! Intervals signaled in the sbgp box, sorted by their first sample
+  std::vector<SSampleGroupInterval> intervals;
+  //! Number of samples covered by the sbgp box, the remaining ones use the default interval
+  size_t mappedSampleCount = 0;
+  SSampleGroupInterval defaultInterval;
 };
 
-using SampleToSampleGroupInfoMap = std::map<size_t, std::vector<CSampleGroupInfo>>;
-using GroupingTypeToVectorIndexMap = std::map<ilo::Fourcc, size_t>;
+//! Sample group mappings of a track or track fragment, one per grouping type in sgpd box order
+using SampleGroupMappings = std::vector<SSampleGroupMapping>;
 
 struct ISampleExtractor {
   virtual ~ISampleExtractor() {}
   virtual std::shared_ptr<TrackIdToTrackSampleInfo> trackIdToTrackSampleInfo() const = 0;
 
  protected:
-  void createSampleToSampleGroupInfoMap(const size_t nrOfSamples);
-  void fillDefaultSampleGroupInfo(SampleToSampleGroupInfoMap& indexMap,
-                                  const SDefaultConfig& config) const;
-  void setSampleSampleGroupInfo(const std::vector<CSampleGroupInfo>& sampleGroupInfos,
-                                CMetaSample& metaSample);
+  //! Builds the sample group mappings of the given sgpd and sbgp boxes
+  static SampleGroupMappings createSampleGroupMappings(
+      const std::vector<std::shared_ptr<box::CSampleGroupDescriptionBox>>& sgpdBoxes,
+      const std::vector<std::shared_ptr<box::CSampleToGroupBox>>& sbgpBoxes,
+      const size_t nrOfSamples);
+  static void setSampleSampleGroupInfo(const SampleGroupMappings& mappings,
+                                       const size_t sampleIndex, SSampleGroupInfo& sampleGroupInfo);
 
   std::shared_ptr<TrackIdToTrackSampleInfo> m_sampleInfoTable = nullptr;
-  std::vector<std::shared_ptr<box::CSampleGroupDescriptionBox>> m_currentSgpdBoxes;
-  std::vector<std::shared_ptr<box::CSampleToGroupBox>> m_currentSbgpBoxes;
-  SampleToSampleGroupInfoMap m_SampleGroupSampleMap;
-  GroupingTypeToVectorIndexMap m_groupingTypeMap;
 };
 
+//! Sample count, largest sample size and duration of a track
+struct STrackSampleSummary {
+  bool hasSampleData = false;
+  size_t sampleCount = 0;
+  uint64_t maxSampleSize = 0;
+  uint64_t durationSum = 0;
+};
+
+//! Summary of the samples of a track, taken from the sample table boxes without building the table
+STrackSampleSummary summarizeTrackSamples(const BoxTree& tree, uint32_t trackId);
+
+//! Summary of an already extracted sample table
+STrackSampleSummary summarizeTrackSamples(const CTrackSampleInfo& trackSampleInfo);
+
 struct CSampleExtractorFactory {
-  static std::unique_ptr<ISampleExtractor> create(const BoxTree& tree);
+  /*!
+   * Extracts the sample tables of the track with the given id, or of all tracks for id 0. Tracks
+   * (regular files) or track fragments (fragmented files) are extracted on up to threadCount
+   * threads. The finished tables are allocated from memoryResource, or from the heap if it is null.
+   */
+  static std::unique_ptr<ISampleExtractor> create(
+      const BoxTree& tree, uint32_t trackId = 0, size_t threadCount = 1,
+      const std::shared_ptr<IMemoryResource>& memoryResource = nullptr);
+};
+
+//! Boxes of one track fragment and the samples extracted from them
+struct STrackFragment {
+  std::shared_ptr<box::CMovieFragmentHeaderBox> mfhd;
+  std::shared_ptr<box::CTrackFragmentHeaderBox> tfhd;
+  std::shared_ptr<box::CTrackFragmentMDTBox> tfdt;
+  std::shared_ptr<box::CTrackRunBox> trun;
+  std::shared_ptr<box::CTrackExtendsBox> trex;
+  std::shared_ptr<box::CMediaHeaderBox> mdhd;
+  std::vector<std::shared_ptr<box::CSampleGroupDescriptionBox>> sgpdBoxes;
+  std::vector<std::shared_ptr<box::CSampleToGroupBox>> sbgpBoxes;
+  uint64_t dataOffset = 0;
+  //! Samples of the fragment, decoding times relative to the first sample of the fragment
+  CTrackSampleInfo samples;
 };
 
 struct CFragmentedSampleExtractor : public ISampleExtractor {
-  CFragmentedSampleExtractor(const BoxTree& tree);
+  CFragmentedSampleExtractor(const BoxTree& tree, uint32_t trackId = 0, size_t threadCount = 1,
+                             const std::shared_ptr<IMemoryResource>& memoryResource = nullptr);
 
   std::shared_ptr<TrackIdToTrackSampleInfo> trackIdToTrackSampleInfo() const;
 
  private:
-  uint64_t calculateDataOffset(uint64_t totalDataOffset);
-
-  void fillSampleInfoTable(uint64_t dataOffset);
-
-  void setSampleSize(const box::CTrunEntry& trunEntry, CMetaSample& metaSample);
-  void setSampleDuration(const box::CTrunEntry& trunEntry, CMetaSample& metaSample);
-  void setSampleCtsOffset(const box::CTrunEntry& trunEntry, CMetaSample& metaSample);
-  void setSampleOffset(uint64_t dataOffset, uint64_t currentSampleOffset, CMetaSample& metaSample);
-  void setSampleFragmentNumber(CMetaSample& metaSample);
-  void setSyncSampleFlag(const size_t index, const box::CTrunEntry& trunEntry,
-                         CMetaSample& metaSample);
-  void setTimeScale(CMetaSample& metaSample);
-  void setSampleSampleGroupInfoFrag(const size_t& metaSampleIndex, CMetaSample& metaSample);
-
-  std::shared_ptr<box::CTrackRunBox> m_currentTrunBox;
-  std::shared_ptr<box::CTrackFragmentHeaderBox> m_currentTfhdBox;
-  std::shared_ptr<box::CMovieFragmentHeaderBox> m_currentMfhdBox;
-  std::shared_ptr<box::CTrackExtendsBox> m_currentTrexBox;
-  std::shared_ptr<box::CMediaHeaderBox> m_currentMdhdBox;
-  std::shared_ptr<box::CTrackFragmentMDTBox> m_currentTfdtBox;
+  static uint64_t calculateDataOffset(const STrackFragment& fragment, uint64_t totalDataOffset);
+
+  //! Extracts the samples of a track fragment, independent of all other fragments
+  static void fillSampleInfoTable(STrackFragment& fragment);
+  //! Appends the samples of a track fragment to the table of its track
+  void appendTrackFragment(const STrackFragment& fragment);
+
+  static void setSampleSize(const STrackFragment& fragment, const box::CTrunEntry& trunEntry,
+                            CMetaSample& metaSample);
+  static void setSampleDuration(const STrackFragment& fragment, const box::CTrunEntry& trunEntry,
+                                CMetaSample& metaSample);
+  static void setSampleCtsOffset(const STrackFragment& fragment, const box::CTrunEntry& trunEntry,
+                                 CMetaSample& metaSample);
+  static void setSampleOffset(const STrackFragment& fragment, uint64_t currentSampleOffset,
+                              CMetaSample& metaSample);
+  static void setSampleFragmentNumber(const STrackFragment& fragment, CMetaSample& metaSample);
+  static void setSyncSampleFlag(const STrackFragment& fragment, const size_t index,
+                                const box::CTrunEntry& trunEntry, CMetaSample& metaSample);
+  static void setTimeScale(const STrackFragment& fragment, CTrackSampleInfo& trackSampleInfo);
 };
 
 struct CRegularSampleExtractor : public ISampleExtractor {
-  CRegularSampleExtractor(const BoxTree& tree);
+  CRegularSampleExtractor(const BoxTree& tree, uint32_t trackId = 0, size_t threadCount = 1,
+                          const std::shared_ptr<IMemoryResource>& memoryResource = nullptr);
 
   std::shared_ptr<TrackIdToTrackSampleInfo> trackIdToTrackSampleInfo() const;
 
  private:
-  void setSampleSizes(const uint32_t& trackId, const BoxElement& node);
-  void setSampleDurations(const uint32_t& trackId, const BoxElement& node);
-  void setSampleOffsets(const uint32_t& trackId, const BoxElement& node);
-  void setSampleCtsOffsets(const uint32_t& trackId, const BoxElement& node);
-  void setSyncSampleFlag(const uint32_t& trackId, const BoxElement& node);
-  void setTimeScale(const uint32_t& trackId, const BoxElement& node);
-  void setSampleSampleGroupInfoRegular(const uint32_t& trackId);
-
-  uint32_t m_sampleCount;
+  //! Extracts the sample table of a track, independent of all other tracks
+  static void fillSampleInfoTable(CTrackSampleInfo& trackSampleInfo, const BoxElement& trak);
+
+  static void setSampleSizes(CTrackSampleInfo& trackSampleInfo, const BoxElement& node);
+  static void setSampleDurations(CTrackSampleInfo& trackSampleInfo, const BoxElement& node);
+  static void setSampleOffsets(CTrackSampleInfo& trackSampleInfo, const BoxElement& node);
+  static void setSampleCtsOffsets(CTrackSampleInfo& trackSampleInfo, const BoxElement& node);
+  static void setSyncSampleFlag(CTrackSampleInfo& trackSampleInfo, const BoxElement& node);
+  static void setTimeScale(CTrackSampleInfo& trackSampleInfo, const BoxElement& node);
+  static void setSampleSampleGroupInfoRegular(CTrackSampleInfo& trackSampleInfo,
+                                              const SampleGroupMappings& mappings);
 };
 }  // namespace isobmff
 }  // namespace mmt
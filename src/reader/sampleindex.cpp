@@ -0,0 +1,606 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2025 - 2026 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+/*
+ * Project: MPEG-4 ISO Base Media File Format (ISO BMFF) library
+ * Content: sidecar file storing the top-level box layout and sample tables of an input
+ */
+
+// System includes
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+
+#if defined(WIN32) || defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+// External includes
+#include "ilo/fileio.h"
+
+// Internal includes
+#include "sampleindex.h"
+#include "common/logging.h"
+
+namespace mmt {
+namespace isobmff {
+namespace {
+const char indexMagic[8] = {'M', 'M', 'T', 'S', 'I', 'D', 'X', '\0'};
+//! Has to be increased whenever the layout of the records changes
+const uint32_t indexVersion = 3;
+//! Written in native byte order to detect indices written on a machine with another byte order
+const uint32_t indexByteOrderMark = 0x01020304;
+
+struct SIndexHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t byteOrderMark;
+  uint64_t inputSize;
+  uint64_t movieHash;
+  uint64_t topLevelBoxCount;
+  uint64_t trackCount;
+};
+
+struct SIndexTopLevelBox {
+  uint64_t offset;
+  uint64_t size;
+  uint32_t headerSize;
+  char type[4];
+};
+
+//! Followed by the columns of the track in the order of the counts
+struct SIndexTrack {
+  uint32_t trackId;
+  uint32_t timeScale;
+  uint64_t sampleCount;
+  uint64_t offsetRunCount;
+  uint64_t timingRunCount;
+  uint64_t ctsOffsetRunCount;
+  uint64_t fragmentNumberRunCount;
+  uint64_t sampleGroupRunCount;
+  uint64_t syncSampleIndexCount;
+  uint32_t allSyncSamples;
+  uint32_t reserved;
+};
+
+//! Sample sizes and offsets in the run follow as uint32_t arrays of sampleCount entries
+struct SIndexOffsetRun {
+  uint64_t sampleCount;
+  uint64_t baseOffset;
+};
+
+struct SIndexTimingRun {
+  uint64_t sampleCount;
+  uint64_t duration;
+  int64_t dtsValue;
+};
+
+struct SIndexCtsOffsetRun {
+  uint64_t sampleCount;
+  int64_t ctsOffset;
+};
+
+struct SIndexFragmentNumberRun {
+  uint64_t sampleCount;
+  uint32_t fragmentNumber;
+  uint32_t reserved;
+};
+
+struct SIndexSampleGroupRun {
+  uint64_t sampleCount;
+  int16_t rollDistance;
+  uint8_t sampleGroupType;
+  uint8_t sapType;
+  uint8_t reserved[4];
+};
+
+static_assert(sizeof(SIndexHeader) == 48, "Unexpected padding in sample index header");
+static_assert(sizeof(SIndexTopLevelBox) == 24, "Unexpected padding in sample index box record");
+static_assert(sizeof(SIndexTrack) == 72, "Unexpected padding in sample index track record");
+static_assert(sizeof(SIndexOffsetRun) == 16, "Unexpected padding in sample index offset run");
+static_assert(sizeof(SIndexTimingRun) == 24, "Unexpected padding in sample index timing run");
+static_assert(sizeof(SIndexCtsOffsetRun) == 16, "Unexpected padding in sample index cts run");
+static_assert(sizeof(SIndexFragmentNumberRun) == 16,
+              "Unexpected padding in sample index fragment run");
+static_assert(sizeof(SIndexSampleGroupRun) == 16,
+              "Unexpected padding in sample index sample group run");
+
+const uint64_t fnvOffsetBasis = 0xcbf29ce484222325ULL;
+const uint64_t fnvPrime = 0x100000001b3ULL;
+
+uint64_t fnv1a(uint64_t hash, const uint8_t* data, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    hash = (hash ^ data[i]) * fnvPrime;
+  }
+  return hash;
+}
+
+template <class T>
+void writeRecord(FILE* file, const T& record) {
+  ILO_ASSERT(fwrite(&record, sizeof(T), 1, file) == 1, "Could not write sample index");
+}
+
+//! Writes the values padded to a multiple of 8 bytes, so all records stay 8 byte aligned
+template <class T>
+void writeArray(FILE* file, const T* values, size_t count) {
+  ILO_ASSERT(fwrite(values, sizeof(T), count, file) == count, "Could not write sample index");
+  const uint8_t padding[8] = {};
+  const size_t paddingSize = (8 - count * sizeof(T) % 8) % 8;
+  ILO_ASSERT(fwrite(padding, 1, paddingSize, file) == paddingSize, "Could not write sample index");
+}
+
+//! Reads records and arrays from the mapped index file, checking every access against its size
+class CIndexReader {
+ public:
+  CIndexReader(const uint8_t* data, uint64_t size) : m_data(data), m_remaining(size) {}
+
+  //! False if the file ends before the record
+  template <class T>
+  bool readRecord(T& record) {
+    if (m_remaining < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(&record, m_data, sizeof(T));
+    m_data += sizeof(T);
+    m_remaining -= sizeof(T);
+    return true;
+  }
+
+  //! Array of count values written by writeArray, nullptr if the file ends before its end
+  template <class T>
+  const T* readArray(uint64_t count) {
+    // the count is checked first, so a corrupt count cannot overflow the size
+    if (count > m_remaining / sizeof(T)) {
+      return nullptr;
+    }
+    const uint64_t size = (count * sizeof(T) + 7) / 8 * 8;
+    if (size > m_remaining) {
+      return nullptr;
+    }
+    const T* values = reinterpret_cast<const T*>(m_data);
+    m_data += size;
+    m_remaining -= size;
+    return values;
+  }
+
+  bool atEnd() const { return m_remaining == 0; }
+
+ private:
+  const uint8_t* m_data;
+  uint64_t m_remaining;
+};
+
+//! Writes the columns of a table, see SIndexTrack
+void writeTrack(FILE* file, const CTrackSampleInfo& samples) {
+  SIndexTrack record;
+  std::memset(&record, 0, sizeof(record));
+  record.trackId = samples.trackId();
+  record.timeScale = samples.timeScale();
+  record.sampleCount = samples.size();
+  record.offsetRunCount = samples.offsetRuns().runs().size();
+  record.timingRunCount = samples.timingRuns().runs().size();
+  record.ctsOffsetRunCount = samples.ctsOffsetRuns().runs().size();
+  record.fragmentNumberRunCount = samples.fragmentNumberRuns().runs().size();
+  record.sampleGroupRunCount = samples.sampleGroupInfoRuns().runs().size();
+  record.syncSampleIndexCount = samples.syncSampleIndices().size();
+  record.allSyncSamples = samples.allSyncSamples() ? 1 : 0;
+  writeRecord(file, record);
+
+  writeArray(file, samples.sizes().data(), samples.size());
+
+  const auto& offsetRuns = samples.offsetRuns();
+  for (size_t i = 0; i < offsetRuns.runs().size(); ++i) {
+    writeRecord(file, SIndexOffsetRun{offsetRuns.runLength(i), offsetRuns.runs()[i].value});
+  }
+  writeArray(file, samples.offsetsInRun().data(), samples.offsetsInRun().size());
+
+  const auto& timingRuns = samples.timingRuns();
+  for (size_t i = 0; i < timingRuns.runs().size(); ++i) {
+    const auto& timing = timingRuns.runs()[i].value;
+    writeRecord(file, SIndexTimingRun{timingRuns.runLength(i), timing.duration, timing.dtsValue});
+  }
+
+  const auto& ctsOffsetRuns = samples.ctsOffsetRuns();
+  for (size_t i = 0; i < ctsOffsetRuns.runs().size(); ++i) {
+    writeRecord(file,
+                SIndexCtsOffsetRun{ctsOffsetRuns.runLength(i), ctsOffsetRuns.runs()[i].value});
+  }
+
+  const auto& fragmentNumberRuns = samples.fragmentNumberRuns();
+  for (size_t i = 0; i < fragmentNumberRuns.runs().size(); ++i) {
+    writeRecord(file, SIndexFragmentNumberRun{fragmentNumberRuns.runLength(i),
+                                              fragmentNumberRuns.runs()[i].value, 0});
+  }
+
+  const auto& sampleGroupRuns = samples.sampleGroupInfoRuns();
+  for (size_t i = 0; i < sampleGroupRuns.runs().size(); ++i) {
+    const auto& sampleGroupInfo = sampleGroupRuns.runs()[i].value;
+    SIndexSampleGroupRun run;
+    std::memset(&run, 0, sizeof(run));
+    run.sampleCount = sampleGroupRuns.runLength(i);
+    run.rollDistance = sampleGroupInfo.rollDistance;
+    run.sampleGroupType = static_cast<uint8_t>(sampleGroupInfo.type);
+    run.sapType = sampleGroupInfo.sapType;
+    writeRecord(file, run);
+  }
+
+  writeArray(file, samples.syncSampleIndices().data(), samples.syncSampleIndices().size());
+}
+
+/*!
+ * Reads runs of type T written by writeTrack and passes their values and lengths to append
+ *
+ * False if the file ends before the last run or the runs do not cover exactly sampleCount samples.
+ */
+template <class T, class AppendFunction>
+bool readRuns(CIndexReader& reader, uint64_t runCount, uint64_t sampleCount,
+              AppendFunction append) {
+  const T* runs = reader.readArray<T>(runCount);
+  if (runs == nullptr) {
+    return false;
+  }
+  uint64_t covered = 0;
+  for (uint64_t i = 0; i < runCount; ++i) {
+    if (runs[i].sampleCount > sampleCount - covered) {
+      return false;
+    }
+    append(runs[i]);
+    covered += runs[i].sampleCount;
+  }
+  return covered == sampleCount;
+}
+
+//! Loads the columns of a table written by writeTrack, false if they are truncated or corrupt
+bool readTrack(CIndexReader& reader, const SIndexTrack& record, CTrackSampleInfo& samples) {
+  const uint64_t sampleCount = record.sampleCount;
+  if (sampleCount > std::numeric_limits<uint32_t>::max()) {
+    return false;
+  }
+
+  const uint32_t* sizes = reader.readArray<uint32_t>(sampleCount);
+  if (sizes == nullptr) {
+    return false;
+  }
+  samples.appendSizes(sizes, static_cast<size_t>(sampleCount));
+
+  const SIndexOffsetRun* offsetRuns = reader.readArray<SIndexOffsetRun>(record.offsetRunCount);
+  const uint32_t* offsetsInRun = reader.readArray<uint32_t>(sampleCount);
+  if (offsetRuns == nullptr || offsetsInRun == nullptr) {
+    return false;
+  }
+  uint64_t covered = 0;
+  for (uint64_t i = 0; i < record.offsetRunCount; ++i) {
+    if (offsetRuns[i].sampleCount > sampleCount - covered) {
+      return false;
+    }
+    samples.appendOffsetRun(offsetRuns[i].baseOffset, offsetsInRun + covered,
+                            static_cast<size_t>(offsetRuns[i].sampleCount));
+    covered += offsetRuns[i].sampleCount;
+  }
+  if (covered != sampleCount) {
+    return false;
+  }
+
+  bool valid = readRuns<SIndexTimingRun>(
+      reader, record.timingRunCount, sampleCount, [&samples](const SIndexTimingRun& run) {
+        samples.appendTiming(run.duration, run.dtsValue, static_cast<size_t>(run.sampleCount));
+      });
+  valid = valid && readRuns<SIndexCtsOffsetRun>(
+                       reader, record.ctsOffsetRunCount, sampleCount,
+                       [&samples](const SIndexCtsOffsetRun& run) {
+                         samples.appendCtsOffset(run.ctsOffset,
+                                                 static_cast<size_t>(run.sampleCount));
+                       });
+  valid = valid && readRuns<SIndexFragmentNumberRun>(
+                       reader, record.fragmentNumberRunCount, sampleCount,
+                       [&samples](const SIndexFragmentNumberRun& run) {
+                         samples.appendFragmentNumber(run.fragmentNumber,
+                                                      static_cast<size_t>(run.sampleCount));
+                       });
+  valid = valid && readRuns<SIndexSampleGroupRun>(
+                       reader, record.sampleGroupRunCount, sampleCount,
+                       [&samples](const SIndexSampleGroupRun& run) {
+                         samples.appendSampleGroupInfo(
+                             SSampleGroupInfo(static_cast<SampleGroupType>(run.sampleGroupType),
+                                              run.rollDistance, run.sapType),
+                             static_cast<size_t>(run.sampleCount));
+                       });
+  if (!valid) {
+    return false;
+  }
+
+  const uint32_t* syncSampleIndices = reader.readArray<uint32_t>(record.syncSampleIndexCount);
+  if (syncSampleIndices == nullptr) {
+    return false;
+  }
+  if (record.allSyncSamples != 0) {
+    samples.appendSyncSamples(true, static_cast<size_t>(sampleCount));
+    return record.syncSampleIndexCount == 0;
+  }
+  // The samples between two sync samples are appended as one run of non-sync samples
+  uint64_t nextSample = 0;
+  for (uint64_t i = 0; i < record.syncSampleIndexCount; ++i) {
+    if (syncSampleIndices[i] < nextSample || syncSampleIndices[i] >= sampleCount) {
+      return false;
+    }
+    samples.appendSyncSamples(false, static_cast<size_t>(syncSampleIndices[i] - nextSample));
+    samples.appendSyncSamples(true);
+    nextSample = syncSampleIndices[i] + 1;
+  }
+  samples.appendSyncSamples(false, static_cast<size_t>(sampleCount - nextSample));
+  return true;
+}
+
+//! Id of the calling process, makes temporary file names unique between processes
+unsigned long processId() {
+#if defined(WIN32) || defined(_WIN32)
+  return static_cast<unsigned long>(GetCurrentProcessId());
+#else
+  return static_cast<unsigned long>(getpid());
+#endif
+}
+
+//! Replaces target by source in one step, so readers see either the old or the new file
+bool replaceFile(const std::string& source, const std::string& target) {
+#if defined(WIN32) || defined(_WIN32)
+  return MoveFileExA(source.c_str(), target.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+  return std::rename(source.c_str(), target.c_str()) == 0;
+#endif
+}
+
+//! Writes header, top-level boxes and sample tables of the index
+void writeIndex(FILE* file, const SSampleIndex& index) {
+  ILO_ASSERT(index.trackIdToTrackSampleInfo != nullptr, "Sample index without sample tables");
+  const TrackIdToTrackSampleInfo& trackIdToTrackSampleInfo = *index.trackIdToTrackSampleInfo;
+
+  SIndexHeader header;
+  std::memcpy(header.magic, indexMagic, sizeof(indexMagic));
+  header.version = indexVersion;
+  header.byteOrderMark = indexByteOrderMark;
+  header.inputSize = index.inputSize;
+  header.movieHash = index.movieHash;
+  header.topLevelBoxCount = index.topLevelBoxes.size();
+  header.trackCount = trackIdToTrackSampleInfo.size();
+  writeRecord(file, header);
+
+  for (const auto& box : index.topLevelBoxes) {
+    SIndexTopLevelBox record;
+    record.offset = box.offset;
+    record.size = box.size;
+    record.headerSize = box.headerSize;
+    std::copy(box.type.begin(), box.type.end(), record.type);
+    writeRecord(file, record);
+  }
+
+  for (const auto& track : trackIdToTrackSampleInfo) {
+    writeTrack(file, track.second);
+  }
+}
+}  // namespace
+
+size_t movieBoxCount(const TopLevelBoxIndex& topLevelBoxes) {
+  size_t count = 0;
+  bool hasMovieBox = false;
+  for (size_t i = 0; i < topLevelBoxes.size(); ++i) {
+    if (topLevelBoxes[i].type == "moov"_fcc || topLevelBoxes[i].type == "ftyp"_fcc) {
+      hasMovieBox = hasMovieBox || topLevelBoxes[i].type == "moov"_fcc;
+      count = i + 1;
+    }
+  }
+  return hasMovieBox ? count : topLevelBoxes.size();
+}
+
+uint64_t movieHash(std::unique_ptr<IIsobmffInput>& input, const TopLevelBoxIndex& topLevelBoxes) {
+  uint64_t hash = fnvOffsetBasis;
+  uint64_t inputSize = input->size();
+  ilo::ByteBuffer chunk;
+
+  for (const auto& box : topLevelBoxes) {
+    // Sample tables are derived from moov and moof only, media data is never hashed
+    const bool hashBody = box.type == "moov"_fcc || box.type == "moof"_fcc;
+    uint64_t position = box.offset;
+    uint64_t end = position + (hashBody ? box.size : box.headerSize);
+    if (inputSize != IIsobmffInput::unknownSize) {
+      end = std::min(end, inputSize);
+    }
+    if (position >= end) {
+      continue;
+    }
+
+    const uint8_t* view = input->view(position, static_cast<size_t>(end - position));
+    if (view != nullptr) {
+      hash = fnv1a(hash, view, static_cast<size_t>(end - position));
+      continue;
+    }
+
+    input->seek(position);
+    while (position < end) {
+      chunk.resize(static_cast<size_t>(std::min<uint64_t>(end - position, 64 * 1024)));
+      size_t bytesRead = input->read(chunk.begin(), chunk.end());
+      ILO_ASSERT(bytesRead == chunk.size(), "Failed to read box for hashing");
+      hash = fnv1a(hash, chunk.data(), bytesRead);
+      position += bytesRead;
+    }
+  }
+  return hash;
+}
+
+void writeSampleIndex(const std::string& filename, const SSampleIndex& index) {
+  // Other processes may have the index mapped, so it is written next to it and replaced at once
+  static std::atomic<unsigned> tempFileCount(0);
+  const std::string tempFilename = filename + ".tmp." + std::to_string(processId()) + "." +
+                                   std::to_string(tempFileCount++);
+  try {
+    {
+      ilo::CFileWrapper file(tempFilename, ilo::CFileWrapper::OpenMode::write);
+      writeIndex(file.get(), index);
+      ILO_ASSERT(fflush(file.get()) == 0, "Could not write sample index");
+    }
+    ILO_ASSERT(replaceFile(tempFilename, filename), "Could not replace sample index %s",
+               filename.c_str());
+  } catch (...) {
+    std::remove(tempFilename.c_str());
+    throw;
+  }
+}
+
+std::unique_ptr<SSampleIndex> readSampleIndex(
+    const std::string& filename, const std::shared_ptr<IMemoryResource>& memoryResource) {
+  std::unique_ptr<CIsobmffMmapInput> input;
+  try {
+    input = ilo::make_unique<CIsobmffMmapInput>(filename);
+  } catch (const std::exception&) {
+    return nullptr;
+  }
+
+  uint64_t fileSize = input->size();
+  const uint8_t* data = input->view(0, static_cast<size_t>(fileSize));
+  if (data == nullptr) {
+    ILO_LOG_WARNING("Sample index %s is too small", filename.c_str());
+    return nullptr;
+  }
+
+  CIndexReader reader(data, fileSize);
+  SIndexHeader header;
+  if (!reader.readRecord(header)) {
+    ILO_LOG_WARNING("Sample index %s is too small", filename.c_str());
+    return nullptr;
+  }
+  if (std::memcmp(header.magic, indexMagic, sizeof(indexMagic)) != 0 ||
+      header.version != indexVersion || header.byteOrderMark != indexByteOrderMark) {
+    ILO_LOG_WARNING("Sample index %s has an unsupported format", filename.c_str());
+    return nullptr;
+  }
+
+  auto index = ilo::make_unique<SSampleIndex>();
+  index->inputSize = header.inputSize;
+  index->movieHash = header.movieHash;
+  index->trackIdToTrackSampleInfo = std::make_shared<TrackIdToTrackSampleInfo>();
+
+  const SIndexTopLevelBox* boxes = reader.readArray<SIndexTopLevelBox>(header.topLevelBoxCount);
+  bool valid = boxes != nullptr;
+  if (valid) {
+    index->topLevelBoxes.resize(static_cast<size_t>(header.topLevelBoxCount));
+    for (size_t i = 0; valid && i < index->topLevelBoxes.size(); ++i) {
+      // Boxes follow each other without gaps, so they never reach beyond the 64 bit range
+      valid = boxes[i].headerSize <= boxes[i].size &&
+              boxes[i].size <= std::numeric_limits<uint64_t>::max() - boxes[i].offset &&
+              (i == 0 || boxes[i].offset == boxes[i - 1].offset + boxes[i - 1].size);
+      auto& box = index->topLevelBoxes[i];
+      box.offset = boxes[i].offset;
+      box.size = boxes[i].size;
+      box.headerSize = boxes[i].headerSize;
+      std::copy(boxes[i].type, boxes[i].type + 4, box.type.begin());
+    }
+  }
+
+  for (uint64_t i = 0; valid && i < header.trackCount; ++i) {
+    SIndexTrack record;
+    if (!reader.readRecord(record)) {
+      valid = false;
+      break;
+    }
+    CTrackSampleInfo samples(record.trackId, record.timeScale);
+    valid = readTrack(reader, record, samples);
+    if (valid) {
+      samples.shrinkToFit(memoryResource);
+      valid = index->trackIdToTrackSampleInfo->emplace(record.trackId, std::move(samples)).second;
+    }
+  }
+
+  if (!valid || !reader.atEnd()) {
+    ILO_LOG_WARNING("Sample index %s is truncated or corrupt", filename.c_str());
+    return nullptr;
+  }
+  return index;
+}
+}  // namespace isobmff
+}  // namespace mmt
@@ -0,0 +1,144 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2025 - 2026 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+/*
+ * Project: MPEG-4 ISO Base Media File Format (ISO BMFF) library
+ * Content: sidecar file storing the top-level box layout and sample tables of an input
+ */
+
+#pragma once
+
+// System includes
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// Internal includes
+#include "mmtisobmff/reader/input.h"
+#include "common/tracksampleinfo.h"
+#include "tree/tree_parser.h"
+
+namespace mmt {
+namespace isobmff {
+/*!
+ * Everything a reader derives from an input before it can read samples
+ *
+ * inputSize and movieHash identify the input the index was created for.
+ */
+struct SSampleIndex {
+  uint64_t inputSize = 0;
+  uint64_t movieHash = 0;
+  TopLevelBoxIndex topLevelBoxes;
+  std::shared_ptr<TrackIdToTrackSampleInfo> trackIdToTrackSampleInfo;
+};
+
+//! Number of top-level boxes up to and including the last ftyp/moov box
+size_t movieBoxCount(const TopLevelBoxIndex& topLevelBoxes);
+
+/*!
+ * Hash (64 bit FNV-1a) over the headers of all top-level boxes and the complete moov and moof boxes
+ *
+ * Covers the box layout of the input and every box the sample tables are derived from, but none
+ * of the media data, so hashing does not read the mdat payloads.
+ */
+uint64_t movieHash(std::unique_ptr<IIsobmffInput>& input, const TopLevelBoxIndex& topLevelBoxes);
+
+/*!
+ * Writes the index to a file
+ *
+ * The file consists of a header, the top-level box records and the columns of every sample table
+ * (see CTrackSampleInfo) in native byte order. All records are 8 byte aligned, so the columns can
+ * be used directly from a memory mapping.
+ */
+void writeSampleIndex(const std::string& filename, const SSampleIndex& index);
+
+/*!
+ * Reads an index written by writeSampleIndex
+ *
+ * Returns nullptr if the file does not exist, was written by another version or with another byte
+ * order, or is corrupt. Checking that the index belongs to the input is up to the caller. The
+ * sample tables are allocated from memoryResource, or from the heap if it is null.
+ */
+std::unique_ptr<SSampleIndex> readSampleIndex(
+    const std::string& filename, const std::shared_ptr<IMemoryResource>& memoryResource = nullptr);
+}  // namespace isobmff
+}  // namespace mmt
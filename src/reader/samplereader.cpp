@@ -86,8 +86,10 @@ amm-info@iis.fraunhofer.de
  */
 
 // System includes
+#include <algorithm>
 #include <cinttypes>
 #include <cmath>
+#include <limits>
 
 // External includes
 #include "ilo/string_utils.h"
@@ -101,29 +103,60 @@ amm-info@iis.fraunhofer.de
 
 namespace mmt {
 namespace isobmff {
+namespace {
+/*
+ * Converts a time to the given time scale, rounded up to the next tick. Returns false if the result
+ * does not fit into 64 bit.
+ *
+ * The product of duration and time scale can exceed 64 bit, so it is split at 32 bit. That way
+ * every partial product and remainder fits into 64 bit and the result is exact.
+ */
+bool toTrackTime(const CTimeDuration& time, uint32_t timeScale, uint64_t& trackTime) {
+  const uint64_t divisor = time.timescale();
+  if (divisor == timeScale) {
+    trackTime = time.duration();
+    return true;
+  }
+
+  const uint64_t highProduct = (time.duration() >> 32) * timeScale;
+  const uint64_t lowProduct = (time.duration() & 0xFFFFFFFFu) * timeScale;
+  const uint64_t highQuotient = highProduct / divisor;
+  if (highQuotient > 0xFFFFFFFFu) {
+    return false;
+  }
+  const uint64_t highRemainder = (highProduct % divisor) << 32;
+  const uint64_t remainder = highRemainder % divisor + lowProduct % divisor;
+  const uint64_t lowQuotient = highRemainder / divisor + lowProduct / divisor +
+                               remainder / divisor + (remainder % divisor != 0 ? 1 : 0);
+
+  const uint64_t quotient = highQuotient << 32;
+  if (lowQuotient > std::numeric_limits<uint64_t>::max() - quotient) {
+    return false;
+  }
+  trackTime = quotient + lowQuotient;
+  return true;
+}
+}  // namespace
+
 CSampleReader::CSampleReader(std::unique_ptr<IIsobmffInput>&& input,
-                             const CTrackSampleInfo& trackSampleInfo)
+                             std::shared_ptr<const CTrackSampleInfo> trackSampleInfo)
     : m_input(std::move(input)),
-      m_trackSampleInfo(trackSampleInfo),
-      m_currentSampleNrToRead(0),
-      m_maxSampleSize(0) {
-  for (const auto& metaSample : m_trackSampleInfo) {
-    m_maxSampleSize = std::max(metaSample.size, m_maxSampleSize);
-  }
+      m_trackSampleInfo(std::move(trackSampleInfo)),
+      m_currentSampleNrToRead(0) {
+  ILO_ASSERT(m_trackSampleInfo != nullptr, "Sample reader requires a sample table");
 }
 
 uint64_t CSampleReader::maxSampleSize() {
-  return m_maxSampleSize;
+  return m_trackSampleInfo->maxSampleSize();
 }
 
 SSampleExtraInfo CSampleReader::nextSample(CSample& sample, bool preallocate) {
-  SSampleExtraInfo sExtraInfo;
   sample.clear();
-  if (m_currentSampleNrToRead >= m_trackSampleInfo.size()) {
-    return sExtraInfo;
+  if (m_currentSampleNrToRead >= m_trackSampleInfo->size()) {
+    return SSampleExtraInfo();
   }
 
-  CMetaSample currentMetadataSample = m_trackSampleInfo[m_currentSampleNrToRead];
+  CMetaSample currentMetadataSample = (*m_trackSampleInfo)[m_currentSampleNrToRead];
 
   sample.duration = currentMetadataSample.duration;
   sample.ctsOffset = currentMetadataSample.ctsOffset;
@@ -146,18 +179,7 @@ SSampleExtraInfo CSampleReader::nextSample(CSample& sample, bool preallocate) {
 
   m_currentSampleNrToRead++;
 
-  if (currentMetadataSample.dtsValue + currentMetadataSample.ctsOffset < 0) {
-    sExtraInfo.timestamp = CIsoTimestamp();
-    ILO_LOG_ERROR("PTS issue. CTS offset of %" PRId64 " and DTS value of %" PRId64
-                  " result in negative PTS.",
-                  currentMetadataSample.ctsOffset, currentMetadataSample.dtsValue);
-  } else {
-    sExtraInfo.timestamp = CIsoTimestamp(
-        currentMetadataSample.timeScale,
-        static_cast<uint64_t>(currentMetadataSample.dtsValue + currentMetadataSample.ctsOffset),
-        currentMetadataSample.dtsValue);
-  }
-  return sExtraInfo;
+  return sampleExtraInfo(currentMetadataSample);
 }
 
 SSampleExtraInfo CSampleReader::sampleByIndex(size_t sampleIndex, CSample& sample,
@@ -166,6 +188,88 @@ SSampleExtraInfo CSampleReader::sampleByIndex(size_t sampleIndex, CSample& sampl
   return nextSample(sample, preallocate);
 }
 
+SSampleExtraInfo CSampleReader::nextSampleView(CSampleView& sampleView) {
+  sampleView.clear();
+  if (m_currentSampleNrToRead >= m_trackSampleInfo->size()) {
+    return SSampleExtraInfo();
+  }
+
+  const CMetaSample currentMetadataSample = (*m_trackSampleInfo)[m_currentSampleNrToRead];
+  ILO_ASSERT(currentMetadataSample.size > 0, "Metadata sample has a size of 0");
+  auto sampleSize = static_cast<size_t>(currentMetadataSample.size);
+
+  const uint8_t* data = m_input->view(currentMetadataSample.offset, sampleSize);
+  if (data == nullptr) {
+    // Input does not support direct access, fall back to the reader owned buffer
+    m_viewBuffer.resize(sampleSize);
+    m_input->seek(static_cast<offset_type>(currentMetadataSample.offset), SeekingOrigin::beg);
+    auto readCount = m_input->read(m_viewBuffer.begin(), m_viewBuffer.end());
+    ILO_ASSERT_WITH(readCount == sampleSize, std::length_error, "sample truncated");
+    data = m_viewBuffer.data();
+  }
+
+  sampleView.data = data;
+  sampleView.size = sampleSize;
+  sampleView.duration = currentMetadataSample.duration;
+  sampleView.ctsOffset = currentMetadataSample.ctsOffset;
+  sampleView.isSyncSample = currentMetadataSample.isSyncSample;
+  sampleView.fragmentNumber = currentMetadataSample.fragmentNumber;
+  sampleView.sampleGroupInfo = currentMetadataSample.sampleGroupInfo;
+
+  m_currentSampleNrToRead++;
+
+  return sampleExtraInfo(currentMetadataSample);
+}
+
+std::vector<SSampleExtraInfo> CSampleReader::nextSamples(std::vector<CSample>& samples,
+                                                         size_t sampleCount) {
+  size_t remainingSamples = m_currentSampleNrToRead < m_trackSampleInfo->size()
+                                ? m_trackSampleInfo->size() - m_currentSampleNrToRead
+                                : 0;
+  sampleCount = std::min(sampleCount, remainingSamples);
+  samples.resize(sampleCount);
+
+  std::vector<SInputReadRequest> requests(sampleCount);
+  std::vector<SSampleExtraInfo> extraInfos;
+  extraInfos.reserve(sampleCount);
+
+  for (size_t i = 0; i < sampleCount; ++i) {
+    const CMetaSample metaSample = (*m_trackSampleInfo)[m_currentSampleNrToRead + i];
+    ILO_ASSERT(metaSample.size > 0, "Metadata sample has a size of 0");
+
+    CSample& sample = samples[i];
+    sample.clear();
+    sample.duration = metaSample.duration;
+    sample.ctsOffset = metaSample.ctsOffset;
+    sample.isSyncSample = metaSample.isSyncSample;
+    sample.fragmentNumber = metaSample.fragmentNumber;
+    sample.sampleGroupInfo = metaSample.sampleGroupInfo;
+    sample.rawData.resize(static_cast<size_t>(metaSample.size));
+
+    requests[i].position = metaSample.offset;
+    requests[i].begin = sample.rawData.begin();
+    requests[i].end = sample.rawData.end();
+
+    extraInfos.push_back(sampleExtraInfo(metaSample));
+  }
+
+  // All sample reads of the batch are handed to the input at once
+  m_input->readBatch(requests);
+
+  for (size_t i = 0; i < sampleCount; ++i) {
+    ILO_ASSERT_WITH(requests[i].bytesRead == samples[i].rawData.size(), std::length_error,
+                    "sample truncated");
+  }
+
+  m_currentSampleNrToRead += sampleCount;
+  return extraInfos;
+}
+
+SSampleExtraInfo CSampleReader::sampleViewByIndex(size_t sampleIndex, CSampleView& sampleView) {
+  m_currentSampleNrToRead = sampleIndex;
+  return nextSampleView(sampleView);
+}
+
 SSampleExtraInfo CSampleReader::sampleByTimestamp(const SSeekConfig& seekConfig, CSample& sample,
                                                   bool preallocate) {
   m_currentSampleNrToRead = sampleIndexForTimestamp(seekConfig);
@@ -173,22 +277,71 @@ SSampleExtraInfo CSampleReader::sampleByTimestamp(const SSeekConfig& seekConfig,
 }
 
 SSampleExtraInfo CSampleReader::resolveTimestamp(const SSeekConfig& seekConfig) const {
-  SSampleExtraInfo sExtraInfo;
   auto targetFrameIndex = sampleIndexForTimestamp(seekConfig);
-  if (targetFrameIndex >= m_trackSampleInfo.size()) {
-    return sExtraInfo;
+  if (targetFrameIndex >= m_trackSampleInfo->size()) {
+    return SSampleExtraInfo();
+  }
+  return sampleExtraInfo((*m_trackSampleInfo)[targetFrameIndex]);
+}
+
+std::vector<size_t> CSampleReader::syncSampleIndices() const {
+  std::vector<size_t> indices(m_trackSampleInfo->syncSampleCount());
+  for (size_t i = 0; i < indices.size(); ++i) {
+    indices[i] = m_trackSampleInfo->syncSampleIndex(i);
+  }
+  return indices;
+}
+
+size_t CSampleReader::syncSampleIndex(size_t syncSampleNumber) const {
+  ILO_ASSERT_WITH(syncSampleNumber < m_trackSampleInfo->syncSampleCount(), std::out_of_range,
+                  "Sync sample number is out of range");
+  return m_trackSampleInfo->syncSampleIndex(syncSampleNumber);
+}
+
+std::vector<SGopInfo> CSampleReader::gopBoundaries() const {
+  const size_t syncSampleCount = m_trackSampleInfo->syncSampleCount();
+  std::vector<SGopInfo> gops(syncSampleCount);
+  for (size_t i = 0; i < syncSampleCount; ++i) {
+    const size_t nextGop = i + 1 < syncSampleCount ? m_trackSampleInfo->syncSampleIndex(i + 1)
+                                                   : m_trackSampleInfo->size();
+    gops[i].firstSampleIndex = m_trackSampleInfo->syncSampleIndex(i);
+    gops[i].sampleCount = nextGop - gops[i].firstSampleIndex;
+    gops[i].timestamp = sampleExtraInfo((*m_trackSampleInfo)[gops[i].firstSampleIndex]).timestamp;
   }
-  CMetaSample currentMetadataSample = m_trackSampleInfo[targetFrameIndex];
-  if (currentMetadataSample.dtsValue + currentMetadataSample.ctsOffset < 0) {
+  return gops;
+}
+
+size_t CSampleReader::nearestSyncSample(size_t sampleIndex) const {
+  ILO_ASSERT_WITH(sampleIndex < m_trackSampleInfo->size(), std::out_of_range,
+                  "Sample index is out of range");
+  const size_t syncSampleCount = m_trackSampleInfo->syncSampleCount();
+  ILO_ASSERT(syncSampleCount > 0, "Track does not contain any sync sample");
+
+  // Number of sync samples up to the sample, the next one follows it
+  const size_t precedingCount = m_trackSampleInfo->syncSampleCountUpTo(sampleIndex);
+  if (precedingCount == 0) {
+    return m_trackSampleInfo->syncSampleIndex(0);
+  }
+  const size_t previous = m_trackSampleInfo->syncSampleIndex(precedingCount - 1);
+  if (precedingCount == syncSampleCount) {
+    return previous;
+  }
+  const size_t next = m_trackSampleInfo->syncSampleIndex(precedingCount);
+  return sampleIndex - previous <= next - sampleIndex ? previous : next;
+}
+
+SSampleExtraInfo CSampleReader::sampleExtraInfo(const CMetaSample& metaSample) {
+  SSampleExtraInfo sExtraInfo;
+  if (metaSample.dtsValue + metaSample.ctsOffset < 0) {
     sExtraInfo.timestamp = CIsoTimestamp();
     ILO_LOG_ERROR("PTS issue. CTS offset of %" PRId64 " and DTS value of %" PRId64
                   " result in negative PTS.",
-                  currentMetadataSample.ctsOffset, currentMetadataSample.dtsValue);
+                  metaSample.ctsOffset, metaSample.dtsValue);
   } else {
-    sExtraInfo.timestamp = CIsoTimestamp(
-        currentMetadataSample.timeScale,
-        static_cast<uint64_t>(currentMetadataSample.dtsValue + currentMetadataSample.ctsOffset),
-        currentMetadataSample.dtsValue);
+    sExtraInfo.timestamp =
+        CIsoTimestamp(metaSample.timeScale,
+                      static_cast<uint64_t>(metaSample.dtsValue + metaSample.ctsOffset),
+                      metaSample.dtsValue);
   }
   return sExtraInfo;
 }
@@ -198,43 +351,23 @@ std::size_t CSampleReader::sampleIndexForTimestamp(const SSeekConfig& seekConfig
              "Invalid seek mode specified by user");
   ILO_ASSERT(seekConfig.seekPoint.isValid(), "Invalid (empty) seekpoint found.");
 
-  uint64_t accDuration = 0;
-  size_t frameIndex = 0;
-
-  size_t syncSampleIndex = 0;
-  size_t syncSampleIndexNMinusOne = 0;
-
-  bool foundUserSeekPosition = false;
-  size_t userSeekPositionIndex = 0;
-
-  double userSeekTime = static_cast<double>(seekConfig.seekPoint.duration()) /
-                        static_cast<double>(seekConfig.seekPoint.timescale());
-  double currentTime = 0;
-
-  for (const auto& metaSample : m_trackSampleInfo) {
-    if (metaSample.isSyncSample) {
-      syncSampleIndexNMinusOne = syncSampleIndex;
-      syncSampleIndex = frameIndex;
-      if (foundUserSeekPosition) {
-        break;
-      }
-    }
-
-    // Check if we reached user time
-    currentTime = static_cast<double>(accDuration) / static_cast<double>(metaSample.timeScale);
-    if (currentTime >= userSeekTime && !foundUserSeekPosition) {
-      userSeekPositionIndex = frameIndex;
-      foundUserSeekPosition = true;
-    }
-
-    accDuration += metaSample.duration;
-    frameIndex++;
+  // First sample starting at or after the seek point, all samples start earlier if there is none
+  size_t userSeekPositionIndex = m_trackSampleInfo->size();
+  uint64_t trackTime = 0;
+  if (toTrackTime(seekConfig.seekPoint, m_trackSampleInfo->timeScale(), trackTime)) {
+    userSeekPositionIndex = m_trackSampleInfo->firstSampleStartingAt(trackTime);
   }
 
-  // Position not found. Try to use what we have (first or last position)
-  if (!foundUserSeekPosition) {
-    userSeekPositionIndex = frameIndex;
+  // First sync sample behind the seek position (the last one up to it if there is none) and the
+  // sync sample preceding it. Both fall back to the first sample.
+  size_t syncSampleCount = m_trackSampleInfo->syncSampleCountUpTo(userSeekPositionIndex);
+  if (syncSampleCount < m_trackSampleInfo->syncSampleCount()) {
+    syncSampleCount++;
   }
+  const size_t syncSampleIndex =
+      syncSampleCount > 0 ? m_trackSampleInfo->syncSampleIndex(syncSampleCount - 1) : 0;
+  const size_t syncSampleIndexNMinusOne =
+      syncSampleCount > 1 ? m_trackSampleInfo->syncSampleIndex(syncSampleCount - 2) : 0;
 
   // Evaluate the mode and what fits better
 
@@ -100,22 +100,35 @@ namespace mmt {
 namespace isobmff {
 class CSampleReader {
  public:
-  CSampleReader(std::unique_ptr<IIsobmffInput>&& input, const CTrackSampleInfo& trackSampleInfo);
+  CSampleReader(std::unique_ptr<IIsobmffInput>&& input,
+                std::shared_ptr<const CTrackSampleInfo> trackSampleInfo);
 
   uint64_t maxSampleSize();
 
   SSampleExtraInfo nextSample(CSample& sample, bool preallocate = true);
   SSampleExtraInfo sampleByIndex(size_t sampleIndex, CSample& sample, bool preallocate = true);
+  SSampleExtraInfo nextSampleView(CSampleView& sampleView);
+  std::vector<SSampleExtraInfo> nextSamples(std::vector<CSample>& samples, size_t sampleCount);
+  SSampleExtraInfo sampleViewByIndex(size_t sampleIndex, CSampleView& sampleView);
   SSampleExtraInfo sampleByTimestamp(const SSeekConfig& seekConfig, CSample& sample,
                                      bool preallocate = true);
   SSampleExtraInfo resolveTimestamp(const SSeekConfig& seekConfig) const;
   std::size_t sampleIndexForTimestamp(const SSeekConfig& seekConfig) const;
+  std::vector<size_t> syncSampleIndices() const;
+  size_t syncSampleCount() const { return m_trackSampleInfo->syncSampleCount(); }
+  size_t syncSampleIndex(size_t syncSampleNumber) const;
+  std::vector<SGopInfo> gopBoundaries() const;
+  size_t nearestSyncSample(size_t sampleIndex) const;
 
  private:
+  static SSampleExtraInfo sampleExtraInfo(const CMetaSample& metaSample);
+
   std::unique_ptr<IIsobmffInput> m_input;
-  CTrackSampleInfo m_trackSampleInfo;
+  //! Shared with all other readers of the track
+  std::shared_ptr<const CTrackSampleInfo> m_trackSampleInfo;
   size_t m_currentSampleNrToRead;
-  uint64_t m_maxSampleSize;
+  //! Holds the payload of sample views if the input does not support direct access
+  ilo::ByteBuffer m_viewBuffer;
 };
 }  // namespace isobmff
 }  // namespace mmt
@@ -110,14 +110,14 @@ namespace isobmff {
 SDashInfo::SDashInfo(std::weak_ptr<CIsobmffReader::Pimpl> reader_pimpl) {
   auto p = reader_pimpl.lock();
   ILO_ASSERT(p != nullptr, "reader expired");
-  const BoxTree& tree(p->tree());
+  const CBoxTreeIndex& treeIndex(p->treeIndex());
 
   // Extract sidx information
-  auto boxlist = findAllBoxesWithFourccAndType<box::IBox>(tree, ilo::toFcc("sidx"));
+  auto boxlist = findAllBoxesWithFourccAndType<box::IBox>(treeIndex, "sidx"_fcc);
 
   if (!boxlist.empty()) {
     ILO_ASSERT(boxlist.size() <= 1, "Only a single sidx box is supported.");
-    auto sidxBox = std::dynamic_pointer_cast<box::CSegmentIndexBox>(boxlist.at(0));
+    auto sidxBox = box::boxCast<box::CSegmentIndexBox>(boxlist.at(0));
     ILO_ASSERT(sidxBox != nullptr, "sidx box could not be accessed.");
 
     m_sidxInfo = ilo::make_unique<SSidxInfo>();
@@ -142,13 +142,13 @@ SDashInfo::SDashInfo(std::weak_ptr<CIsobmffReader::Pimpl> reader_pimpl) {
   }
 
   // Extract tfdt information
-  boxlist = findAllBoxesWithFourccAndType<box::IBox>(tree, ilo::toFcc("tfdt"));
+  boxlist = findAllBoxesWithFourccAndType<box::IBox>(treeIndex, "tfdt"_fcc);
 
   if (!boxlist.empty()) {
     m_tfdtInfo = ilo::make_unique<STfdtInfo>();
 
     for (const auto& box : boxlist) {
-      auto tdftBox = std::dynamic_pointer_cast<box::CTrackFragmentMDTBox>(box);
+      auto tdftBox = box::boxCast<box::CTrackFragmentMDTBox>(box);
       ILO_ASSERT(tdftBox != nullptr, "TFDT box could not be accessed.");
 
       m_tfdtInfo->m_baseMediaDecodeTimes.push_back(tdftBox->baseMediaDecodeTime());
@@ -159,24 +159,25 @@ SDashInfo::SDashInfo(std::weak_ptr<CIsobmffReader::Pimpl> reader_pimpl) {
 SMmtpInfo::SMmtpInfo(std::weak_ptr<CIsobmffReader::Pimpl> reader_pimpl) {
   auto p = reader_pimpl.lock();
   ILO_ASSERT(p != nullptr, "reader expired");
-  const BoxTree& tree(p->tree());
+  const CBoxTreeIndex& treeIndex(p->treeIndex());
 
-  auto mfhdBoxes = findAllBoxesWithFourccAndType<box::IBox>(tree, ilo::toFcc("mfhd"));
+  auto mfhdBoxes = findAllBoxesWithFourccAndType<box::IBox>(treeIndex, "mfhd"_fcc);
   ILO_ASSERT(mfhdBoxes.size() == 1, "Requested mfhd box info is not unique or not available.");
 
-  auto mfhdBox = std::dynamic_pointer_cast<box::CMovieFragmentHeaderBox>(mfhdBoxes.at(0));
+  auto mfhdBox = box::boxCast<box::CMovieFragmentHeaderBox>(mfhdBoxes.at(0));
   ILO_ASSERT(mfhdBox != nullptr, "MFHD box could not be accessed.");
 
-  auto mdatBoxes = findAllBoxesWithFourccAndType<box::IBox>(tree, ilo::toFcc("mdat"));
+  auto mdatBoxes = findAllBoxesWithFourccAndType<box::IBox>(treeIndex, "mdat"_fcc);
   ILO_ASSERT(mdatBoxes.size() == 1, "Requested mdat box info is not unique or not available.");
 
-  auto mdatBox = std::dynamic_pointer_cast<box::CBox>(mdatBoxes.at(0));
+  auto mdatBox = box::boxCast<box::CBox>(mdatBoxes.at(0));
   ILO_ASSERT(mdatBox != nullptr, "MDAT box could not be accessed.");
 
-  auto trunBoxes = findAllBoxesWithType<box::CTrackRunBox>(tree);
+  auto trunBoxes = findAllBoxesWithFourccAndType<box::CTrackRunBox>(treeIndex, "trun"_fcc);
   ILO_ASSERT(trunBoxes.size() >= 1, "At least 1 trun box shall be present.");
 
-  auto tfhdBoxes = findAllBoxesWithType<box::CTrackFragmentHeaderBox>(tree);
+  auto tfhdBoxes =
+      findAllBoxesWithFourccAndType<box::CTrackFragmentHeaderBox>(treeIndex, "tfhd"_fcc);
   // This is a known limitation because the spec would allow it.
   // If we encounter MPUs where we have multiple 'trun' within a single 'traf' we will address this.
   ILO_ASSERT(tfhdBoxes.size() == trunBoxes.size(),
@@ -217,12 +218,12 @@ struct SDrcInfo::SPimpl {
   void handleMoov() {
     auto p = m_readerPimpl.lock();
     ILO_ASSERT(p != nullptr, "reader expired");
-    const BoxTree& tree(p->tree());
+    const CBoxTreeIndex& treeIndex(p->treeIndex());
 
     auto moovElement =
-        findFirstElementWithFourccAndBoxType<box::CContainerBox>(tree, ilo::toFcc("moov"));
+        findFirstElementWithFourccAndBoxType<box::CContainerBox>(treeIndex, "moov"_fcc);
     auto trakElements =
-        findAllElementsWithFourccAndBoxType<box::CContainerBox>(moovElement, ilo::toFcc("trak"));
+        findAllElementsWithFourccAndBoxType<box::CContainerBox>(moovElement, "trak"_fcc);
 
     for (uint32_t index = 0; index < trakElements.size(); ++index) {
       mapTrackIdToIndex(trakElements.at(index), index);
@@ -236,21 +237,21 @@ struct SDrcInfo::SPimpl {
   void handleMoof() {
     auto p = m_readerPimpl.lock();
     ILO_ASSERT(p != nullptr, "reader expired");
-    const BoxTree& tree(p->tree());
+    const CBoxTreeIndex& treeIndex(p->treeIndex());
 
     auto moofElements =
-        findAllElementsWithFourccAndBoxType<box::CContainerBox>(tree, ilo::toFcc("moof"));
+        findAllElementsWithFourccAndBoxType<box::CContainerBox>(treeIndex, "moof"_fcc);
     for (const auto& moofElement : moofElements) {
-      auto mfhd = findFirstBoxWithFourccAndType<box::CMovieFragmentHeaderBox>(moofElement,
-                                                                              ilo::toFcc("mfhd"));
+      auto mfhd =
+          findFirstBoxWithFourccAndType<box::CMovieFragmentHeaderBox>(moofElement, "mfhd"_fcc);
       ILO_ASSERT(mfhd != nullptr,
                  "no mfhd box found when looking sequence number of the current fragment");
 
       auto trafElements =
-          findAllElementsWithFourccAndBoxType<box::CContainerBox>(moofElement, ilo::toFcc("traf"));
+          findAllElementsWithFourccAndBoxType<box::CContainerBox>(moofElement, "traf"_fcc);
       for (const auto& trafElement : trafElements) {
-        auto tfhd = findFirstBoxWithFourccAndType<box::CTrackFragmentHeaderBox>(trafElement,
-                                                                                ilo::toFcc("tfhd"));
+        auto tfhd =
+            findFirstBoxWithFourccAndType<box::CTrackFragmentHeaderBox>(trafElement, "tfhd"_fcc);
         ILO_ASSERT(tfhd != nullptr, "no tfhd box found when looking for udta of the traf box");
 
         auto ludInfo = findUdta(trafElement);
@@ -263,7 +264,7 @@ struct SDrcInfo::SPimpl {
 
   SLudtInfo findUdta(std::reference_wrapper<const BoxElement> nodeElement) {
     auto udtaElements =
-        findAllElementsWithFourccAndBoxType<box::CContainerBox>(nodeElement, ilo::toFcc("udta"), 1);
+        findAllElementsWithFourccAndBoxType<box::CContainerBox>(nodeElement, "udta"_fcc, 1);
     if (udtaElements.size() > 1) {
       ILO_LOG_WARNING(
           "Multiple udta boxes found on node element %s which violates the standard. Only using "
@@ -281,16 +282,16 @@ struct SDrcInfo::SPimpl {
     SLudtInfo ludtInfo;
 
     auto ludtElements =
-        findAllElementsWithFourccAndBoxType<box::CContainerBox>(udataELement, ilo::toFcc("ludt"));
+        findAllElementsWithFourccAndBoxType<box::CContainerBox>(udataELement, "ludt"_fcc);
     for (auto ludtElement : ludtElements) {
       auto tlouBoxes =
-          findAllBoxesWithFourccAndType<box::CLoudnessBaseBox>(ludtElement, ilo::toFcc("tlou"));
+          findAllBoxesWithFourccAndType<box::CLoudnessBaseBox>(ludtElement, "tlou"_fcc);
       for (const auto& tlouBox : tlouBoxes) {
         ludtInfo.m_tlouData.push_back(*tlouBox);
       }
 
       auto alouBoxes =
-          findAllBoxesWithFourccAndType<box::CLoudnessBaseBox>(ludtElement, ilo::toFcc("alou"));
+          findAllBoxesWithFourccAndType<box::CLoudnessBaseBox>(ludtElement, "alou"_fcc);
       for (const auto& alouBox : alouBoxes) {
         ludtInfo.m_alouData.push_back(*alouBox);
       }
@@ -319,8 +320,7 @@ struct SDrcInfo::SPimpl {
 
   void mapTrackIdToIndex(std::reference_wrapper<const BoxElement> trakElement,
                          const uint32_t index) {
-    auto tkhd =
-        findFirstBoxWithFourccAndType<box::CTrackHeaderBox>(trakElement, ilo::toFcc("tkhd"));
+    auto tkhd = findFirstBoxWithFourccAndType<box::CTrackHeaderBox>(trakElement, "tkhd"_fcc);
     ILO_ASSERT(tkhd != nullptr, "no tkhd box found when looking for the trackId of the traf box");
     m_trackIdToIndex[tkhd->trackID()] = index;
   }
@@ -493,9 +493,9 @@ std::vector<SDrcExtendedInfo::SLoudnessBaseInfo> SDrcExtendedInfo::fragmentLudtD
 SIodsInfo::SIodsInfo(std::weak_ptr<CIsobmffReader::Pimpl> reader_pimpl) {
   auto p = reader_pimpl.lock();
   ILO_ASSERT(p != nullptr, "reader expired");
-  const BoxTree& tree(p->tree());
+  const CBoxTreeIndex& treeIndex(p->treeIndex());
 
-  auto iods = findFirstBoxWithFourccAndType<box::CObjectDescriptorBox>(tree, ilo::toFcc("iods"));
+  auto iods = findFirstBoxWithFourccAndType<box::CObjectDescriptorBox>(treeIndex, "iods"_fcc);
   if (iods) {
     auto iodsInfo = ilo::make_unique<SIodsInfo::SIodsEntry>();
     iodsInfo->audioProfileLevelIndication = iods->audioProfileLevelIndication();
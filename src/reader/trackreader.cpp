@@ -128,29 +128,30 @@ struct CGenericTrackReader::Pimpl {
 static std::shared_ptr<box::CBox> getSampleEntry(const BoxElement& currentTrackElement) {
   std::reference_wrapper<const BoxElement> stsdElement =
       findFirstElementWithFourccAndBoxType<box::CSampleDescriptionBox>(currentTrackElement,
-                                                                       ilo::toFcc("stsd"));
+                                                                       "stsd"_fcc);
   ILO_ASSERT(stsdElement.get().childCount() == 1, "Only a single sample entry is supported");
-  return std::dynamic_pointer_cast<box::CBox>(stsdElement.get()[0].item);
+  return box::boxCast<box::CBox>(stsdElement.get()[0].item);
 }
 
-const BoxElement& getCurrentTrackElement(const BoxTree& tree, size_t tracknumber) {
-  auto traks = findAllElementsWithFourccAndBoxType<box::CContainerBox>(tree, ilo::toFcc("trak"));
+const BoxElement& getCurrentTrackElement(const CBoxTreeIndex& treeIndex, size_t tracknumber) {
+  auto traks = findAllElementsWithFourccAndBoxType<box::CContainerBox>(treeIndex, "trak"_fcc);
   return traks.at(tracknumber).get();
 }
 
 std::unique_ptr<CSampleReader> createSampleReader(const BoxElement& currentTrackElement,
                                                   std::shared_ptr<CIsobmffReader::Pimpl> rpimpl) {
-  auto tkhd =
-      findFirstBoxWithFourccAndType<box::CTrackHeaderBox>(currentTrackElement, ilo::toFcc("tkhd"));
+  auto tkhd = findFirstBoxWithFourccAndType<box::CTrackHeaderBox>(currentTrackElement, "tkhd"_fcc);
   ILO_ASSERT(tkhd != nullptr, "no track header found in iso container");
   uint32_t currentTrackID = tkhd->trackID();
 
-  ILO_ASSERT(rpimpl->trackIdToTrackSampleInfo().count(currentTrackID) >= 1,
+  // Only the sample table of this track is derived
+  auto trackSampleInfo = rpimpl->trackSampleInfo(currentTrackID);
+  ILO_ASSERT(trackSampleInfo != nullptr,
              "Selected track with id %d does not contain any samples.", currentTrackID);
 
   std::unique_ptr<CSampleReader> sampleReader;
-  sampleReader = std::unique_ptr<CSampleReader>(new CSampleReader(
-      rpimpl->input()->clone(), rpimpl->trackIdToTrackSampleInfo().at(currentTrackID)));
+  sampleReader = std::unique_ptr<CSampleReader>(
+      new CSampleReader(rpimpl->input()->clone(), trackSampleInfo));
   ILO_ASSERT(sampleReader != nullptr, "Error: Sample reader could not be initialized!");
   return sampleReader;
 }
@@ -160,7 +161,8 @@ CGenericTrackReader::CGenericTrackReader(std::weak_ptr<CIsobmffReader::Pimpl> re
   auto rpimpl = reader_pimpl.lock();
   ILO_ASSERT(rpimpl != nullptr, "Error: Reader expired");
 
-  const BoxElement& currentTrackElement = getCurrentTrackElement(rpimpl->tree(), tracknumber);
+  const BoxElement& currentTrackElement =
+      getCurrentTrackElement(rpimpl->movieTreeIndex(), tracknumber);
   auto sampleReader = createSampleReader(currentTrackElement, rpimpl);
   auto genericSampleEntry = getSampleEntry(currentTrackElement);
   ILO_ASSERT(genericSampleEntry != nullptr, "Failed to get the generic sample entry");
@@ -187,6 +189,20 @@ SSampleExtraInfo CGenericTrackReader::sampleByIndex(size_t sampleIndex, CSample&
   return p->m_sampleReader->sampleByIndex(sampleIndex, sample, preallocate);
 }
 
+SSampleExtraInfo CGenericTrackReader::nextSampleView(CSampleView& sampleView) const {
+  return p->m_sampleReader->nextSampleView(sampleView);
+}
+
+SSampleExtraInfo CGenericTrackReader::sampleViewByIndex(size_t sampleIndex,
+                                                        CSampleView& sampleView) const {
+  return p->m_sampleReader->sampleViewByIndex(sampleIndex, sampleView);
+}
+
+std::vector<SSampleExtraInfo> CGenericTrackReader::nextSamples(std::vector<CSample>& samples,
+                                                               size_t sampleCount) const {
+  return p->m_sampleReader->nextSamples(samples, sampleCount);
+}
+
 SSampleExtraInfo CGenericTrackReader::sampleByTimestamp(const SSeekConfig& seekConfig,
                                                         CSample& sample, bool preallocate) const {
   return p->m_sampleReader->sampleByTimestamp(seekConfig, sample, preallocate);
@@ -196,6 +212,26 @@ SSampleExtraInfo CGenericTrackReader::resolveTimestamp(const SSeekConfig& seekCo
   return p->m_sampleReader->resolveTimestamp(seekConfig);
 }
 
+std::vector<size_t> CGenericTrackReader::syncSampleIndices() const {
+  return p->m_sampleReader->syncSampleIndices();
+}
+
+size_t CGenericTrackReader::syncSampleCount() const {
+  return p->m_sampleReader->syncSampleCount();
+}
+
+size_t CGenericTrackReader::syncSampleIndex(size_t syncSampleNumber) const {
+  return p->m_sampleReader->syncSampleIndex(syncSampleNumber);
+}
+
+std::vector<SGopInfo> CGenericTrackReader::gopBoundaries() const {
+  return p->m_sampleReader->gopBoundaries();
+}
+
+size_t CGenericTrackReader::nearestSyncSample(size_t sampleIndex) const {
+  return p->m_sampleReader->nearestSyncSample(sampleIndex);
+}
+
 ilo::Fourcc CGenericTrackReader::codingName() const {
   return p->m_genericSampleEntry->type();
 }
@@ -213,7 +249,7 @@ CGenericAudioTrackReader::CGenericAudioTrackReader(
     std::weak_ptr<CIsobmffReader::Pimpl> reader_pimpl, size_t tracknumber)
     : CGenericTrackReader(reader_pimpl, tracknumber) {
   auto audioSampleEntry =
-      std::dynamic_pointer_cast<box::CAudioSampleEntry>(p->m_genericSampleEntry);
+      box::boxCast<box::CAudioSampleEntry>(p->m_genericSampleEntry);
   ILO_ASSERT(audioSampleEntry != nullptr,
              "Error: Generic Audio Track reader could not access audio sample entry!");
 
@@ -248,7 +284,7 @@ CGenericVideoTrackReader::CGenericVideoTrackReader(
     std::weak_ptr<CIsobmffReader::Pimpl> reader_pimpl, size_t tracknumber)
     : CGenericTrackReader(reader_pimpl, tracknumber) {
   auto visualSampleEntry =
-      std::dynamic_pointer_cast<box::CVisualSampleEntry>(p->m_genericSampleEntry);
+      box::boxCast<box::CVisualSampleEntry>(p->m_genericSampleEntry);
   ILO_ASSERT(visualSampleEntry != nullptr,
              "Generic video track reader could not access visual sample entry!");
 
@@ -302,9 +338,10 @@ CMpeghTrackReader::CMpeghTrackReader(std::weak_ptr<CIsobmffReader::Pimpl> reader
       new CMpeghTrackReader::PimplMpegh(reader_pimpl, tracknumber));
 
   auto rpimpl = reader_pimpl.lock();
-  const BoxElement& currentTrackElement = getCurrentTrackElement(rpimpl->tree(), tracknumber);
+  const BoxElement& currentTrackElement =
+      getCurrentTrackElement(rpimpl->movieTreeIndex(), tracknumber);
   auto mhaPbox = findAllBoxesWithFourccAndType<box::CMhaProfileLevelCompatibilitySetBox>(
-      currentTrackElement, ilo::toFcc("mhaP"));
+      currentTrackElement, "mhaP"_fcc);
 
   if (!mhaPbox.empty()) {
     pmpegh->m_profileAndLevelCompatibleSets = mhaPbox[0]->profileAndLevelCompatibleSets();
@@ -322,6 +359,20 @@ SSampleExtraInfo CMpeghTrackReader::sampleByIndex(size_t sampleIndex, CSample& s
   return pmpegh->m_genericAudioTrackReader.sampleByIndex(sampleIndex, sample, preallocate);
 }
 
+SSampleExtraInfo CMpeghTrackReader::nextSampleView(CSampleView& sampleView) const {
+  return pmpegh->m_genericAudioTrackReader.nextSampleView(sampleView);
+}
+
+SSampleExtraInfo CMpeghTrackReader::sampleViewByIndex(size_t sampleIndex,
+                                                      CSampleView& sampleView) const {
+  return pmpegh->m_genericAudioTrackReader.sampleViewByIndex(sampleIndex, sampleView);
+}
+
+std::vector<SSampleExtraInfo> CMpeghTrackReader::nextSamples(std::vector<CSample>& samples,
+                                                             size_t sampleCount) const {
+  return pmpegh->m_genericAudioTrackReader.nextSamples(samples, sampleCount);
+}
+
 SSampleExtraInfo CMpeghTrackReader::sampleByTimestamp(const SSeekConfig& seekConfig,
                                                       CSample& sample, bool preallocate) const {
   return pmpegh->m_genericAudioTrackReader.sampleByTimestamp(seekConfig, sample, preallocate);
@@ -331,6 +382,26 @@ SSampleExtraInfo CMpeghTrackReader::resolveTimestamp(const SSeekConfig& seekConf
   return pmpegh->m_genericAudioTrackReader.resolveTimestamp(seekConfig);
 }
 
+std::vector<size_t> CMpeghTrackReader::syncSampleIndices() const {
+  return pmpegh->m_genericAudioTrackReader.syncSampleIndices();
+}
+
+size_t CMpeghTrackReader::syncSampleCount() const {
+  return pmpegh->m_genericAudioTrackReader.syncSampleCount();
+}
+
+size_t CMpeghTrackReader::syncSampleIndex(size_t syncSampleNumber) const {
+  return pmpegh->m_genericAudioTrackReader.syncSampleIndex(syncSampleNumber);
+}
+
+std::vector<SGopInfo> CMpeghTrackReader::gopBoundaries() const {
+  return pmpegh->m_genericAudioTrackReader.gopBoundaries();
+}
+
+size_t CMpeghTrackReader::nearestSyncSample(size_t sampleIndex) const {
+  return pmpegh->m_genericAudioTrackReader.nearestSyncSample(sampleIndex);
+}
+
 ilo::Fourcc CMpeghTrackReader::codingName() const {
   return pmpegh->m_genericAudioTrackReader.codingName();
 }
@@ -382,6 +453,20 @@ SSampleExtraInfo CMp4aTrackReader::sampleByIndex(size_t sampleIndex, CSample& sa
   return pmp4a->m_genericAudioTrackReader.sampleByIndex(sampleIndex, sample, preallocate);
 }
 
+SSampleExtraInfo CMp4aTrackReader::nextSampleView(CSampleView& sampleView) const {
+  return pmp4a->m_genericAudioTrackReader.nextSampleView(sampleView);
+}
+
+SSampleExtraInfo CMp4aTrackReader::sampleViewByIndex(size_t sampleIndex,
+                                                     CSampleView& sampleView) const {
+  return pmp4a->m_genericAudioTrackReader.sampleViewByIndex(sampleIndex, sampleView);
+}
+
+std::vector<SSampleExtraInfo> CMp4aTrackReader::nextSamples(std::vector<CSample>& samples,
+                                                            size_t sampleCount) const {
+  return pmp4a->m_genericAudioTrackReader.nextSamples(samples, sampleCount);
+}
+
 SSampleExtraInfo CMp4aTrackReader::sampleByTimestamp(const SSeekConfig& seekConfig, CSample& sample,
                                                      bool preallocate) const {
   return pmp4a->m_genericAudioTrackReader.sampleByTimestamp(seekConfig, sample, preallocate);
@@ -391,6 +476,26 @@ SSampleExtraInfo CMp4aTrackReader::resolveTimestamp(const SSeekConfig& seekConfi
   return pmp4a->m_genericAudioTrackReader.resolveTimestamp(seekConfig);
 }
 
+std::vector<size_t> CMp4aTrackReader::syncSampleIndices() const {
+  return pmp4a->m_genericAudioTrackReader.syncSampleIndices();
+}
+
+size_t CMp4aTrackReader::syncSampleCount() const {
+  return pmp4a->m_genericAudioTrackReader.syncSampleCount();
+}
+
+size_t CMp4aTrackReader::syncSampleIndex(size_t syncSampleNumber) const {
+  return pmp4a->m_genericAudioTrackReader.syncSampleIndex(syncSampleNumber);
+}
+
+std::vector<SGopInfo> CMp4aTrackReader::gopBoundaries() const {
+  return pmp4a->m_genericAudioTrackReader.gopBoundaries();
+}
+
+size_t CMp4aTrackReader::nearestSyncSample(size_t sampleIndex) const {
+  return pmp4a->m_genericAudioTrackReader.nearestSyncSample(sampleIndex);
+}
+
 ilo::Fourcc CMp4aTrackReader::codingName() const {
   return pmp4a->m_genericAudioTrackReader.codingName();
 }
@@ -477,6 +582,26 @@ SSampleExtraInfo CAvcTrackReader::resolveTimestamp(const SSeekConfig& seekConfig
   return pavc->m_genericVideoTrackReader.resolveTimestamp(seekConfig);
 }
 
+std::vector<size_t> CAvcTrackReader::syncSampleIndices() const {
+  return pavc->m_genericVideoTrackReader.syncSampleIndices();
+}
+
+size_t CAvcTrackReader::syncSampleCount() const {
+  return pavc->m_genericVideoTrackReader.syncSampleCount();
+}
+
+size_t CAvcTrackReader::syncSampleIndex(size_t syncSampleNumber) const {
+  return pavc->m_genericVideoTrackReader.syncSampleIndex(syncSampleNumber);
+}
+
+std::vector<SGopInfo> CAvcTrackReader::gopBoundaries() const {
+  return pavc->m_genericVideoTrackReader.gopBoundaries();
+}
+
+size_t CAvcTrackReader::nearestSyncSample(size_t sampleIndex) const {
+  return pavc->m_genericVideoTrackReader.nearestSyncSample(sampleIndex);
+}
+
 ilo::Fourcc CAvcTrackReader::codingName() const {
   return pavc->m_genericVideoTrackReader.codingName();
 }
@@ -566,6 +691,26 @@ SSampleExtraInfo CHevcTrackReader::resolveTimestamp(const SSeekConfig& seekConfi
   return phevc->m_genericVideoTrackReader.resolveTimestamp(seekConfig);
 }
 
+std::vector<size_t> CHevcTrackReader::syncSampleIndices() const {
+  return phevc->m_genericVideoTrackReader.syncSampleIndices();
+}
+
+size_t CHevcTrackReader::syncSampleCount() const {
+  return phevc->m_genericVideoTrackReader.syncSampleCount();
+}
+
+size_t CHevcTrackReader::syncSampleIndex(size_t syncSampleNumber) const {
+  return phevc->m_genericVideoTrackReader.syncSampleIndex(syncSampleNumber);
+}
+
+std::vector<SGopInfo> CHevcTrackReader::gopBoundaries() const {
+  return phevc->m_genericVideoTrackReader.gopBoundaries();
+}
+
+size_t CHevcTrackReader::nearestSyncSample(size_t sampleIndex) const {
+  return phevc->m_genericVideoTrackReader.nearestSyncSample(sampleIndex);
+}
+
 ilo::Fourcc CHevcTrackReader::codingName() const {
   return phevc->m_genericVideoTrackReader.codingName();
 }
@@ -600,13 +745,14 @@ struct CJxsTrackReader::PimplJxs {
   PimplJxs(std::weak_ptr<CIsobmffReader::Pimpl> reader_pimpl, size_t tracknumber)
       : m_genericVideoTrackReader(reader_pimpl, tracknumber) {
     auto rpimpl = reader_pimpl.lock();
-    const BoxElement& currentTrackElement = getCurrentTrackElement(rpimpl->tree(), tracknumber);
+    const BoxElement& currentTrackElement =
+      getCurrentTrackElement(rpimpl->movieTreeIndex(), tracknumber);
     auto jpegVideoInfoList = findAllBoxesWithFourccAndType<box::CJPEGXSVideoInformationBox>(
-        currentTrackElement, ilo::toFcc("jpvi"));
+        currentTrackElement, "jpvi"_fcc);
     auto profileAndLevelList = findAllBoxesWithFourccAndType<box::CJXPLProfileandLevelBox>(
-        currentTrackElement, ilo::toFcc("jxpl"));
-    auto colorinfoList = findAllBoxesWithFourccAndType<box::CColourInformationBox>(
-        currentTrackElement, ilo::toFcc("colr"));
+        currentTrackElement, "jxpl"_fcc);
+    auto colorinfoList =
+        findAllBoxesWithFourccAndType<box::CColourInformationBox>(currentTrackElement, "colr"_fcc);
 
     ILO_ASSERT(
         jpegVideoInfoList.size() <= 1,
@@ -679,6 +825,20 @@ SSampleExtraInfo CJxsTrackReader::sampleByIndex(size_t sampleIndex, CSample& jxs
   return pjxs->m_genericVideoTrackReader.sampleByIndex(sampleIndex, jxsSample, preallocate);
 }
 
+SSampleExtraInfo CJxsTrackReader::nextSampleView(CSampleView& sampleView) const {
+  return pjxs->m_genericVideoTrackReader.nextSampleView(sampleView);
+}
+
+SSampleExtraInfo CJxsTrackReader::sampleViewByIndex(size_t sampleIndex,
+                                                    CSampleView& sampleView) const {
+  return pjxs->m_genericVideoTrackReader.sampleViewByIndex(sampleIndex, sampleView);
+}
+
+std::vector<SSampleExtraInfo> CJxsTrackReader::nextSamples(std::vector<CSample>& samples,
+                                                           size_t sampleCount) const {
+  return pjxs->m_genericVideoTrackReader.nextSamples(samples, sampleCount);
+}
+
 SSampleExtraInfo CJxsTrackReader::sampleByTimestamp(const SSeekConfig& seekConfig,
                                                     CSample& jxsSample, bool preallocate) const {
   return pjxs->m_genericVideoTrackReader.sampleByTimestamp(seekConfig, jxsSample, preallocate);
@@ -688,6 +848,26 @@ SSampleExtraInfo CJxsTrackReader::resolveTimestamp(const SSeekConfig& seekConfig
   return pjxs->m_genericVideoTrackReader.resolveTimestamp(seekConfig);
 }
 
+std::vector<size_t> CJxsTrackReader::syncSampleIndices() const {
+  return pjxs->m_genericVideoTrackReader.syncSampleIndices();
+}
+
+size_t CJxsTrackReader::syncSampleCount() const {
+  return pjxs->m_genericVideoTrackReader.syncSampleCount();
+}
+
+size_t CJxsTrackReader::syncSampleIndex(size_t syncSampleNumber) const {
+  return pjxs->m_genericVideoTrackReader.syncSampleIndex(syncSampleNumber);
+}
+
+std::vector<SGopInfo> CJxsTrackReader::gopBoundaries() const {
+  return pjxs->m_genericVideoTrackReader.gopBoundaries();
+}
+
+size_t CJxsTrackReader::nearestSyncSample(size_t sampleIndex) const {
+  return pjxs->m_genericVideoTrackReader.nearestSyncSample(sampleIndex);
+}
+
 ilo::Fourcc CJxsTrackReader::codingName() const {
   return pjxs->m_genericVideoTrackReader.codingName();
 }
@@ -779,6 +959,26 @@ SSampleExtraInfo CVvcTrackReader::resolveTimestamp(const SSeekConfig& seekConfig
   return pvvc->m_genericVideoTrackReader.resolveTimestamp(seekConfig);
 }
 
+std::vector<size_t> CVvcTrackReader::syncSampleIndices() const {
+  return pvvc->m_genericVideoTrackReader.syncSampleIndices();
+}
+
+size_t CVvcTrackReader::syncSampleCount() const {
+  return pvvc->m_genericVideoTrackReader.syncSampleCount();
+}
+
+size_t CVvcTrackReader::syncSampleIndex(size_t syncSampleNumber) const {
+  return pvvc->m_genericVideoTrackReader.syncSampleIndex(syncSampleNumber);
+}
+
+std::vector<SGopInfo> CVvcTrackReader::gopBoundaries() const {
+  return pvvc->m_genericVideoTrackReader.gopBoundaries();
+}
+
+size_t CVvcTrackReader::nearestSyncSample(size_t sampleIndex) const {
+  return pvvc->m_genericVideoTrackReader.nearestSyncSample(sampleIndex);
+}
+
 ilo::Fourcc CVvcTrackReader::codingName() const {
   return pvvc->m_genericVideoTrackReader.codingName();
 }
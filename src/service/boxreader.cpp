@@ -115,11 +115,48 @@ BoxSizeType CBoxReader::readBoxInto(ilo::ByteBuffer& buffer) {
   return readBoxRemainder(buffer, boxSizeType);
 }
 
+BoxSizeType CBoxReader::skipBox() {
+  ilo::ByteBuffer header;
+  BoxSizeType boxSizeType = readBoxHeaderFields(header);
+  skipBoxRemainder(boxSizeType);
+  return boxSizeType;
+}
+
+void CBoxReader::skipBoxRemainder(const BoxSizeType& boxSizeType) {
+  ILO_ASSERT(boxSizeType.size >= boxSizeType.headerLengthInBytes,
+             "Invalid stream. Reported box header is bigger than total box size");
+
+  uint64_t toSkip = boxSizeType.size - boxSizeType.headerLengthInBytes;
+  if (toSkip == 0) {
+    return;
+  }
+
+  auto availableByteCount = bytesReadable();
+  if (toSkip > availableByteCount) {
+    ILO_LOG_WARNING("box truncated in input: type %s, size %" PRIu64 " (available: %" PRIu64 ")",
+                    ilo::toString(boxSizeType.type).c_str(), boxSizeType.size, availableByteCount);
+    toSkip = availableByteCount;
+  }
+
+  m_position += toSkip;
+  input->seek(m_position);
+}
+
 bool CBoxReader::isEos() {
+  if (m_inputSize != IIsobmffInput::unknownSize) {
+    return m_position >= m_inputSize;
+  }
   return input->isEOI();
 }
 
-BoxSizeType CBoxReader::readBoxHeaderFields(ilo::ByteBuffer& buffer) const {
+pos_type CBoxReader::bytesReadable() const {
+  if (m_inputSize != IIsobmffInput::unknownSize) {
+    return m_inputSize > m_position ? m_inputSize - m_position : 0;
+  }
+  return inputBytesReadable(input);
+}
+
+BoxSizeType CBoxReader::readBoxHeaderFields(ilo::ByteBuffer& buffer) {
   BoxSizeType boxSizeType;
   buffer.resize(BASIC_HEADER_SIZER);
 
@@ -127,16 +164,14 @@ BoxSizeType CBoxReader::readBoxHeaderFields(ilo::ByteBuffer& buffer) const {
       input->read(buffer.begin(), buffer.end()) == BASIC_HEADER_SIZER,
       "Failed to obtain box size and type. Buffer is too small to contain basic box header.");
 
+  m_position += BASIC_HEADER_SIZER;
+
   ilo::ByteBuffer::const_iterator iter = buffer.begin();
   boxSizeType.size = ilo::readUint32(buffer, iter);
   boxSizeType.type = ilo::readFourCC(buffer, iter);
 
   if (boxSizeType.size == 0) {
-    auto currentPos = input->tell();
-    input->seek(0, SeekingOrigin::end);
-    auto endPos = input->tell();
-    input->seek(currentPos);
-    boxSizeType.size = (size_t)(endPos - currentPos + buffer.size());
+    boxSizeType.size = (size_t)(bytesReadable() + buffer.size());
   } else if (boxSizeType.size == 1) {
     buffer.resize(buffer.size() + EXTRA_EXTENSION_HEADER);
     iter = buffer.begin() + static_cast<std::ptrdiff_t>(BASIC_HEADER_SIZER);
@@ -144,6 +179,7 @@ BoxSizeType CBoxReader::readBoxHeaderFields(ilo::ByteBuffer& buffer) const {
                            buffer.end()) == EXTRA_EXTENSION_HEADER,
                "Header signals 64bit box extension, but buffer is too small to contain extension "
                "size field");
+    m_position += EXTRA_EXTENSION_HEADER;
     boxSizeType.size = ilo::readUint64(buffer, iter);
   }
   boxSizeType.headerLengthInBytes = static_cast<uint32_t>(buffer.size());
@@ -156,7 +192,7 @@ BoxSizeType CBoxReader::readBoxHeaderFields(ilo::ByteBuffer& buffer) const {
 }
 
 BoxSizeType CBoxReader::readBoxRemainder(ilo::ByteBuffer& buffer,
-                                         const BoxSizeType& boxSizeType) const {
+                                         const BoxSizeType& boxSizeType) {
   ILO_ASSERT(boxSizeType.size >= boxSizeType.headerLengthInBytes,
              "Invalid stream. Reported box header is bigger than total box size");
 
@@ -166,15 +202,16 @@ BoxSizeType CBoxReader::readBoxRemainder(ilo::ByteBuffer& buffer,
     return boxSizeType;
   }
 
-  auto availableByteCount = inputBytesReadable(input);
+  auto availableByteCount = bytesReadable();
   if (toRead > availableByteCount) {
     ILO_LOG_WARNING("box truncated in input: type %s, size %" PRIu64 " (available: %" PRIu64 ")",
                     ilo::toString(boxSizeType.type).c_str(), boxSizeType.size, availableByteCount);
     toRead = availableByteCount;
   }
 
-  if (boxSizeType.type == ilo::toFcc("mdat") && m_skipMdatPayload) {
-    input->seek(static_cast<offset_type>(toRead), SeekingOrigin::cur);
+  if (boxSizeType.type == "mdat"_fcc && m_skipMdatPayload) {
+    m_position += toRead;
+    input->seek(m_position);
     return boxSizeType;
   }
 
@@ -184,6 +221,7 @@ BoxSizeType CBoxReader::readBoxRemainder(ilo::ByteBuffer& buffer,
       buffer.begin() + static_cast<std::ptrdiff_t>(boxSizeType.headerLengthInBytes), buffer.end());
   ILO_ASSERT(static_cast<uint64_t>(remainingRead) == toRead,
              "Failed to read box payload. Not enough data to read.");
+  m_position += remainingRead;
 
   return boxSizeType;
 }
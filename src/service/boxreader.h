@@ -111,7 +111,10 @@ struct IBoxReader {
 class CBoxReader : public IBoxReader {
  public:
   CBoxReader(std::unique_ptr<IIsobmffInput>& in, bool skipMdatPayload = true)
-      : input(in), m_skipMdatPayload(skipMdatPayload) {}
+      : input(in),
+        m_skipMdatPayload(skipMdatPayload),
+        m_inputSize(in->size()),
+        m_position(in->tell()) {}
 
   CBoxReader& operator=(const CBoxReader&) = delete;
   CBoxReader(const CBoxReader&) = delete;
@@ -119,15 +122,29 @@ class CBoxReader : public IBoxReader {
   //! reads the next box on this level into memory
   //  Hint: MDAT payload is skipped, so for mdat is it the pure header
   BoxSizeType readBoxInto(ilo::ByteBuffer& buffer);
+  //! reads only the header of the next box on this level and skips its payload
+  BoxSizeType skipBox();
   bool isEos();
+  //! position of the next box header in the input
+  pos_type position() const { return m_position; }
+
+  //! reads the header of the next box on this level into the buffer
+  BoxSizeType readBoxHeaderFields(ilo::ByteBuffer& buffer);
+  //! appends the payload of the box whose header was just read to the buffer
+  BoxSizeType readBoxRemainder(ilo::ByteBuffer& buffer, const BoxSizeType& boxSizeType);
+  //! skips the payload of the box whose header was just read
+  void skipBoxRemainder(const BoxSizeType& boxSizeType);
 
  private:
-  BoxSizeType readBoxHeaderFields(ilo::ByteBuffer& buffer) const;
-  BoxSizeType readBoxRemainder(ilo::ByteBuffer& buffer, const BoxSizeType& boxSizeType) const;
+  pos_type bytesReadable() const;
 
  private:
   std::unique_ptr<IIsobmffInput>& input;
   bool m_skipMdatPayload;
+  //! Input size queried once, IIsobmffInput::unknownSize if the input does not provide it
+  pos_type m_inputSize;
+  //! Reading position tracked by the box reader to avoid querying the input
+  pos_type m_position;
   const uint32_t BASIC_HEADER_SIZER = 8U;
   const uint32_t EXTRA_EXTENSION_HEADER = 8U;
 };
@@ -85,6 +85,9 @@ amm-info@iis.fraunhofer.de
  * Content: box registry
  */
 
+// System includes
+#include <algorithm>
+
 // External includes
 #include "ilo/common_types.h"
 
@@ -93,11 +96,11 @@ amm-info@iis.fraunhofer.de
 
 #define ADD_BOX_REGISTRY(RegEntry)        \
   extern box::CBoxRegistryEntry RegEntry; \
-  boxes[RegEntry.fcc] = RegEntry
+  boxes.push_back(RegEntry)
 
 namespace mmt {
 namespace isobmff {
-static void registerBoxes(CBoxRegistry::CRegistryMap& boxes) {
+static void registerBoxes(CBoxRegistry::CRegistryEntries& boxes) {
   ADD_BOX_REGISTRY(ftypBoxRegistryEntry);
   ADD_BOX_REGISTRY(stypBoxRegistryEntry);
   ADD_BOX_REGISTRY(moofBoxRegistryEntry);
@@ -169,14 +172,39 @@ static void registerBoxes(CBoxRegistry::CRegistryMap& boxes) {
   ADD_BOX_REGISTRY(vvcCBoxRegistryEntry);
 }
 
-CBoxRegistry::CBoxRegistry() {
-  registerBoxes(m_boxes);
+static bool entryLess(const box::CBoxRegistryEntry& entry, const ilo::Fourcc& fcc) {
+  return entry.fcc < fcc;
+}
+
+//! The registered boxes never change after static initialization, so the sorted table is built
+//! once and shared by all registry instances.
+static const CBoxRegistry::CRegistryEntries& registeredBoxes() {
+  static const CBoxRegistry::CRegistryEntries boxes = [] {
+    CBoxRegistry::CRegistryEntries entries;
+    registerBoxes(entries);
+    std::sort(entries.begin(), entries.end(),
+              [](const box::CBoxRegistryEntry& lhs, const box::CBoxRegistryEntry& rhs) {
+                return lhs.fcc < rhs.fcc;
+              });
+    return entries;
+  }();
+  return boxes;
+}
+
+CBoxRegistry::CBoxRegistry() : m_boxes(registeredBoxes()) {}
+
+const box::CBoxRegistryEntry* CBoxRegistry::find(const ilo::Fourcc& fcc) const {
+  auto boxreg = std::lower_bound(m_boxes.begin(), m_boxes.end(), fcc, entryLess);
+  if (boxreg != m_boxes.end() && boxreg->fcc == fcc) {
+    return &(*boxreg);
+  }
+  return nullptr;
 }
 
 bool CBoxRegistry::isContainer(const std::shared_ptr<box::IBox>& box) const {
-  auto boxreg = m_boxes.find(box->type());
-  if (boxreg != m_boxes.end())
-    return boxreg->second.containerType == box::CContainerType::isContainer;
+  const box::CBoxRegistryEntry* boxreg = find(box->type());
+  if (boxreg != nullptr)
+    return boxreg->containerType == box::CContainerType::isContainer;
   return false;
 }
 }  // namespace isobmff
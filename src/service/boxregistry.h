@@ -88,10 +88,9 @@ amm-info@iis.fraunhofer.de
 #pragma once
 
 // System includes
-#include <map>
+#include <vector>
 
 // External includes
-#include "ilo/servicelocator.h"
 #include "ilo/common_types.h"
 
 // Internal includes
@@ -101,23 +100,25 @@ amm-info@iis.fraunhofer.de
 
 namespace mmt {
 namespace isobmff {
-struct IBoxRegistry : public ilo::IService {
+struct IBoxRegistry {
   virtual ~IBoxRegistry() {}
 
-  virtual box::CBoxRegistryEntry entry(ilo::Fourcc fcc) const = 0;
+  //! Returns the registry entry for the given type or nullptr if the type is unknown
+  virtual const box::CBoxRegistryEntry* find(const ilo::Fourcc& fcc) const = 0;
   virtual bool isContainer(const std::shared_ptr<box::IBox>& box) const = 0;
 };
 
 struct CBoxRegistry : public IBoxRegistry {
-  typedef std::map<ilo::Fourcc, box::CBoxRegistryEntry> CRegistryMap;
+  //! Registry entries sorted by fourcc for binary search lookups
+  typedef std::vector<box::CBoxRegistryEntry> CRegistryEntries;
   CBoxRegistry();
 
-  box::CBoxRegistryEntry entry(ilo::Fourcc fcc) const { return m_boxes.at(fcc); }
+  const box::CBoxRegistryEntry* find(const ilo::Fourcc& fcc) const;
 
   bool isContainer(const std::shared_ptr<box::IBox>& box) const;
 
  private:
-  CRegistryMap m_boxes;
+  const CRegistryEntries& m_boxes;
 };
 
 }  // namespace isobmff
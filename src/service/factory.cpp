@@ -89,6 +89,8 @@ amm-info@iis.fraunhofer.de
 #define __STDC_FORMAT_MACROS
 
 // System includes
+#include <algorithm>
+#include <iterator>
 #include <stdexcept>
 #include <inttypes.h>
 
@@ -100,12 +102,12 @@ amm-info@iis.fraunhofer.de
 // Internal includes
 #include "factory.h"
 #include "boxregistry.h"
-#include "servicesingleton.h"
 #include "common/logging.h"
 #include "common/bytebuffertools_extension.h"
 #include "box/invalidbox.h"
 #include "box/unknownbox.h"
 #include "box/containerbox.h"
+#include "box/lazybox.h"
 
 namespace mmt {
 namespace isobmff {
@@ -113,27 +115,24 @@ std::shared_ptr<box::IBox> CBoxFactory::createBox(
     ilo::ByteBuffer::const_iterator& begin, const ilo::ByteBuffer::const_iterator& end) const {
   BoxSizeType boxSizeType = tools::getBoxSizeAndType(begin, end);
 
-  auto registry = CServiceLocatorSingleton::instance().lock()->getService<IBoxRegistry>().lock();
   if (verboseLogLevel) {
     ILO_LOG_INFO("creating box of type %s with size %" PRIu64,
                  ilo::toString(boxSizeType.type).c_str(), boxSizeType.size);
   }
 
-  box::CBoxRegistryEntry registryEntry;
-  try {
-    registryEntry = registry->entry(boxSizeType.type);
-  } catch (const std::exception&) {
+  const box::CBoxRegistryEntry* registryEntry = m_registry->find(boxSizeType.type);
+  if (registryEntry == nullptr) {
     ILO_LOG_WARNING("unknown box (%s) - skipping", ilo::toString(boxSizeType.type).c_str());
-    return std::make_shared<box::CUnknownBox>(begin, end);
+    return std::allocate_shared<box::CUnknownBox>(m_allocator, begin, end);
   }
 
   auto boxStart = begin;  // need later in case of a parsing error to create the invalid box
   try {
-    return registryEntry.parseCreate(begin, end);
+    return registryEntry->parseCreate(begin, end, m_allocator);
   } catch (const std::exception&) {
     ILO_LOG_WARNING("error at parsing (%s) - skipping", ilo::toString(boxSizeType.type).c_str());
     begin = boxStart;
-    return std::make_shared<box::CInvalidBox>(begin, end);
+    return std::allocate_shared<box::CInvalidBox>(m_allocator, begin, end);
   }
 }
 
@@ -141,23 +140,18 @@ std::shared_ptr<box::IBox> CBoxFactory::createBox(
     const box::CBox::SBoxWriteConfig& boxWriteConfig) const {
   const ilo::Fourcc& fcc = boxWriteConfig.getType();
 
-  auto registry = CServiceLocatorSingleton::instance().lock()->getService<IBoxRegistry>().lock();
-
   if (verboseLogLevel) {
     ILO_LOG_INFO("creating box of type %s", ilo::toString(fcc).c_str());
   }
 
-  box::CBoxRegistryEntry registryEntry;
-
-  try {
-    registryEntry = registry->entry(fcc);
-  } catch (const std::exception&) {
+  const box::CBoxRegistryEntry* registryEntry = m_registry->find(fcc);
+  if (registryEntry == nullptr) {
     ILO_LOG_WARNING("unknown box (%s)", ilo::toString(fcc).c_str());
     auto& config = static_cast<const box::CUnknownBox::SUnknownBoxWriteConfig&>(boxWriteConfig);
-    return std::make_shared<box::CUnknownBox>(config);
+    return std::allocate_shared<box::CUnknownBox>(m_allocator, config);
   }
 
-  return registryEntry.writeCreate(boxWriteConfig);
+  return registryEntry->writeCreate(boxWriteConfig, m_allocator);
 }
 
 static ilo::ByteBuffer::const_iterator boxEnd(const ilo::ByteBuffer::const_iterator& begin,
@@ -172,31 +166,66 @@ static ilo::ByteBuffer::const_iterator boxEnd(const ilo::ByteBuffer::const_itera
   return begin + static_cast<std::ptrdiff_t>(boxSizeType.size);
 }
 
+//! Sample table boxes which can hold millions of entries and are worth parsing on demand
+static bool isLazyBoxType(const ilo::Fourcc& type) {
+  static const ilo::Fourcc lazyTypes[] = {
+      "stsz"_fcc, "stz2"_fcc, "stco"_fcc, "co64"_fcc,
+      "stts"_fcc, "ctts"_fcc, "stss"_fcc, "stsc"_fcc,
+      "sbgp"_fcc};
+  return std::find(std::begin(lazyTypes), std::end(lazyTypes), type) != std::end(lazyTypes);
+}
+
 void CNodeFactory::createNode(BoxTree::NodeType& addTo, ilo::ByteBuffer::const_iterator& begin,
                               const ilo::ByteBuffer::const_iterator& end) const {
+  createNode(addTo, nullptr, begin, end);
+}
+
+void CNodeFactory::createLazyNode(BoxTree::NodeType& addTo,
+                                  const std::shared_ptr<const ilo::ByteBuffer>& buffer,
+                                  ilo::ByteBuffer::const_iterator& begin,
+                                  const ilo::ByteBuffer::const_iterator& end) const {
+  ILO_ASSERT(buffer != nullptr, "Lazy parsing requires a shared buffer");
+  createNode(addTo, buffer, begin, end);
+}
+
+void CNodeFactory::createNode(BoxTree::NodeType& addTo,
+                              const std::shared_ptr<const ilo::ByteBuffer>& buffer,
+                              ilo::ByteBuffer::const_iterator& begin,
+                              const ilo::ByteBuffer::const_iterator& end) const {
   auto chopEnd = boxEnd(begin, end);
   ilo::ByteBuffer::const_iterator chopBegin = begin;
 
-  auto boxfac = CServiceLocatorSingleton::instance().lock()->getService<IBoxFactory>().lock();
-  auto box = boxfac->createBox(begin, chopEnd);
+  if (buffer != nullptr && isLazyBoxType(tools::getBoxType(begin, chopEnd))) {
+    // the lazy box may outlive the parsing, so it keeps its own reference to the box factory
+    std::shared_ptr<const IBoxFactory> boxfac = m_boxFactory;
+    auto parseCreate = [boxfac](ilo::ByteBuffer::const_iterator& boxBegin,
+                                const ilo::ByteBuffer::const_iterator& boxEnd) {
+      return boxfac->createBox(boxBegin, boxEnd);
+    };
+    addTo.addChild(
+        std::allocate_shared<box::CLazyBox>(m_allocator, buffer, begin, chopEnd, parseCreate));
+    begin = chopEnd;
+    return;
+  }
+
+  auto box = m_boxFactory->createBox(begin, chopEnd);
   if (box->size() != static_cast<uint64_t>(chopEnd - chopBegin)) {
     ILO_LOG_WARNING("Box size mismatch");
   }
 
   BoxTree::NodeType& current_node = addTo.addChild(box);
 
-  auto registry = CServiceLocatorSingleton::instance().lock()->getService<IBoxRegistry>().lock();
   if (begin != chopEnd) {
-    ILO_ASSERT(registry->isContainer(box), "box was not fully parsed: %s",
+    ILO_ASSERT(m_registry->isContainer(box), "box was not fully parsed: %s",
                ilo::toString(box->type()).c_str());
-    if (!registry->isContainer(box)) {
+    if (!m_registry->isContainer(box)) {
       ILO_LOG_WARNING("box was not fully parsed: %s", ilo::toString(box->type()).c_str());
     } else {
       if (verboseLogLevel) {
         ILO_LOG_INFO("Container found");
       }
       while (begin != chopEnd) {
-        createNode(current_node, begin, chopEnd);
+        createNode(current_node, buffer, begin, chopEnd);
       }
     }
   }
@@ -205,15 +234,13 @@ void CNodeFactory::createNode(BoxTree::NodeType& addTo, ilo::ByteBuffer::const_i
 
 std::reference_wrapper<BoxElement> CNodeFactory::createNode(
     BoxTree::NodeType& addTo, const BoxWriteConfig& boxWriteConfig) const {
-  auto boxfac = CServiceLocatorSingleton::instance().lock()->getService<IBoxFactory>().lock();
-  auto box = boxfac->createBox(boxWriteConfig);
+  auto box = m_boxFactory->createBox(boxWriteConfig);
   return ref(addTo.addChild(box));
 }
 
 void CNodeFactory::replaceNode(BoxElement& toBeReplaced,
                                const BoxWriteConfig& boxWriteConfig) const {
-  auto boxfac = CServiceLocatorSingleton::instance().lock()->getService<IBoxFactory>().lock();
-  auto box = boxfac->createBox(boxWriteConfig);
+  auto box = m_boxFactory->createBox(boxWriteConfig);
   toBeReplaced.item = box;
 }
 
@@ -91,19 +91,20 @@ amm-info@iis.fraunhofer.de
 #include <memory>
 #include <string>
 #include <map>
+#include <utility>
 
 // External includes
-#include "ilo/servicelocator.h"
 #include "ilo/common_types.h"
 
 // Internal includes
 #include "mmtisobmff/types.h"
 #include "box/box.h"
 #include "tree/boxtree.h"
+#include "service/boxregistry.h"
 
 namespace mmt {
 namespace isobmff {
-struct IBoxFactory : public ilo::IService {
+struct IBoxFactory {
   virtual ~IBoxFactory() {}
   virtual std::shared_ptr<box::IBox> createBox(
       ilo::ByteBuffer::const_iterator& begin, const ilo::ByteBuffer::const_iterator& end) const = 0;
@@ -112,17 +113,31 @@ struct IBoxFactory : public ilo::IService {
 };
 
 struct CBoxFactory : public IBoxFactory {
+  //! Boxes are allocated from memoryResource, or from the heap if it is null
+  explicit CBoxFactory(std::shared_ptr<const IBoxRegistry> registry,
+                       std::shared_ptr<IMemoryResource> memoryResource = nullptr)
+      : m_registry(std::move(registry)), m_allocator(std::move(memoryResource)) {}
+
   std::shared_ptr<box::IBox> createBox(ilo::ByteBuffer::const_iterator& begin,
                                        const ilo::ByteBuffer::const_iterator& end) const;
   std::shared_ptr<box::IBox> createBox(const box::CBox::SBoxWriteConfig& boxWriteConfig) const;
+
+ private:
+  std::shared_ptr<const IBoxRegistry> m_registry;
+  box::BoxAllocator m_allocator;
 };
 
 typedef box::CBox::SBoxWriteConfig BoxWriteConfig;
 
-struct INodeFactory : public ilo::IService {
+struct INodeFactory {
   virtual ~INodeFactory() {}
   virtual void createNode(BoxTree::NodeType& addTo, ilo::ByteBuffer::const_iterator& begin,
                           const ilo::ByteBuffer::const_iterator& end) const = 0;
+  //! like createNode, but sample table boxes only keep their location in buffer until accessed
+  virtual void createLazyNode(BoxTree::NodeType& addTo,
+                              const std::shared_ptr<const ilo::ByteBuffer>& buffer,
+                              ilo::ByteBuffer::const_iterator& begin,
+                              const ilo::ByteBuffer::const_iterator& end) const = 0;
   virtual std::reference_wrapper<BoxElement> createNode(
       BoxTree::NodeType& addTo, const BoxWriteConfig& boxWriteConfig) const = 0;
   virtual void replaceNode(BoxElement& toBeReplaced,
@@ -130,11 +145,33 @@ struct INodeFactory : public ilo::IService {
 };
 
 struct CNodeFactory : public INodeFactory {
+  CNodeFactory(std::shared_ptr<const IBoxRegistry> registry,
+               std::shared_ptr<const IBoxFactory> boxFactory,
+               std::shared_ptr<IMemoryResource> memoryResource = nullptr)
+      : m_registry(std::move(registry)),
+        m_boxFactory(std::move(boxFactory)),
+        m_allocator(std::move(memoryResource)) {}
+
   void createNode(BoxTree::NodeType& addTo, ilo::ByteBuffer::const_iterator& begin,
                   const ilo::ByteBuffer::const_iterator& end) const override;
+  void createLazyNode(BoxTree::NodeType& addTo,
+                      const std::shared_ptr<const ilo::ByteBuffer>& buffer,
+                      ilo::ByteBuffer::const_iterator& begin,
+                      const ilo::ByteBuffer::const_iterator& end) const override;
   std::reference_wrapper<BoxElement> createNode(
       BoxTree::NodeType& addTo, const BoxWriteConfig& boxWriteConfig) const override;
   void replaceNode(BoxElement& toBeReplaced, const BoxWriteConfig& boxWriteConfig) const override;
+
+ private:
+  //! creates the node, buffer is only set for lazy parsing
+  void createNode(BoxTree::NodeType& addTo, const std::shared_ptr<const ilo::ByteBuffer>& buffer,
+                  ilo::ByteBuffer::const_iterator& begin,
+                  const ilo::ByteBuffer::const_iterator& end) const;
+
+  std::shared_ptr<const IBoxRegistry> m_registry;
+  std::shared_ptr<const IBoxFactory> m_boxFactory;
+  //! used for the lazy boxes, all other boxes are allocated by the box factory
+  box::BoxAllocator m_allocator;
 };
 }  // namespace isobmff
 }  // namespace mmt
@@ -82,30 +82,26 @@ amm-info@iis.fraunhofer.de
 
 /*
  * Project: MPEG-4 ISO Base Media File Format (ISO BMFF) library
- * Content: mmtisobmff services
+ * Content: parser context holding the box registry and factories
  */
 
-#include "servicesingleton.h"
-
-#include <mutex>
-
-#include "service/boxregistry.h"
-#include "service/factory.h"
-
-using namespace mmt::isobmff;
-
-namespace {
-std::once_flag setupFlag;
-
-void wrapSetup() {
-  CServices::setup<CBoxRegistry, CBoxFactory, CNodeFactory>();
-}
-}  // namespace
+// Internal includes
+#include "parsercontext.h"
+#include "common/logging.h"
 
 namespace mmt {
 namespace isobmff {
-void setupServicesOnce() {
-  std::call_once(setupFlag, wrapSetup);
+CParserContext::CParserContext(std::shared_ptr<IMemoryResource> memoryResource)
+    : m_memoryResource(memoryResource) {
+  if (verboseLogLevel) {
+    ILO_LOG_SCOPE("");
+  }
+
+  auto boxRegistry = std::make_shared<const CBoxRegistry>();
+  auto boxFactory = std::make_shared<const CBoxFactory>(boxRegistry, memoryResource);
+  m_nodeFactory = std::make_shared<const CNodeFactory>(boxRegistry, boxFactory, memoryResource);
+  m_boxFactory = boxFactory;
+  m_registry = boxRegistry;
 }
 }  // namespace isobmff
 }  // namespace mmt
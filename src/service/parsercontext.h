@@ -82,53 +82,46 @@ amm-info@iis.fraunhofer.de
 
 /*
  * Project: MPEG-4 ISO Base Media File Format (ISO BMFF) library
- * Content: mmtisobmff services
+ * Content: parser context holding the box registry and factories
  */
 
 #pragma once
 
 // System includes
-#include <utility>
 #include <memory>
 
-// External includes
-#include "ilo/servicelocator.h"
-#include "ilo/singleton.h"
-
 // Internal includes
 #include "factory.h"
 #include "boxregistry.h"
-#include "common/logging.h"
+#include "mmtisobmff/memoryresource.h"
 
 namespace mmt {
 namespace isobmff {
-typedef ilo::Singleton<ilo::ServiceLocator> CServiceLocatorSingleton;
-
-void setupServicesOnce();
-
-struct CServices {
-  //! setup services
-  template <class boxregType, class boxfactoryType, class nodefactoryType>
-  static void setup() {
-    if (verboseLogLevel) {
-      ILO_LOG_SCOPE("");
-    }
-
-    // setup service locator
-    CServiceLocatorSingleton::swap(std::make_shared<ilo::ServiceLocator>());
-
-    // setup box registry and register service
-    auto servloc = CServiceLocatorSingleton::instance().lock();
-
-    std::shared_ptr<IBoxRegistry> boxreg = std::make_shared<boxregType>();
-    servloc->registerService<IBoxRegistry>(boxreg);
-
-    std::shared_ptr<IBoxFactory> boxfac = std::make_shared<boxfactoryType>();
-    servloc->registerService<IBoxFactory>(boxfac);
-
-    std::shared_ptr<INodeFactory> nodefac = std::make_shared<nodefactoryType>();
-    servloc->registerService<INodeFactory>(nodefac);
-  }
+/*!
+ * Box registry and factories used for parsing and building box trees.
+ *
+ * One context is created per reader and writer and handed down to everything that creates
+ * boxes, so no global lookups are needed while parsing or building.
+ */
+class CParserContext {
+ public:
+  //! All boxes are allocated from memoryResource, or from the heap if it is null
+  explicit CParserContext(std::shared_ptr<IMemoryResource> memoryResource = nullptr);
+
+  CParserContext& operator=(const CParserContext&) = delete;
+  CParserContext(const CParserContext&) = delete;
+
+  const IBoxRegistry& registry() const { return *m_registry; }
+  const IBoxFactory& boxFactory() const { return *m_boxFactory; }
+  const INodeFactory& nodeFactory() const { return *m_nodeFactory; }
+  //! Resource the boxes are allocated from, null for the heap
+  const std::shared_ptr<IMemoryResource>& memoryResource() const { return m_memoryResource; }
+
+ private:
+  std::shared_ptr<IMemoryResource> m_memoryResource;
+  std::shared_ptr<const IBoxRegistry> m_registry;
+  std::shared_ptr<const IBoxFactory> m_boxFactory;
+  std::shared_ptr<const INodeFactory> m_nodeFactory;
 };
 }  // namespace isobmff
 }  // namespace mmt
@@ -0,0 +1,191 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2025 - 2026 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+/*
+ * Project: MPEG-4 ISO Base Media File Format (ISO BMFF) library
+ * Content: event based parser walking the boxes of an isobmff input without building a tree
+ */
+
+// Internal includes
+#include "box_event_parser.h"
+#include "box/mdatbox.h"
+#include "common/bytebuffertools_extension.h"
+#include "service/boxreader.h"
+
+namespace mmt {
+namespace isobmff {
+static bool isContainerType(const IBoxRegistry& registry, const ilo::Fourcc& type) {
+  const box::CBoxRegistryEntry* registryEntry = registry.find(type);
+  return registryEntry != nullptr &&
+         registryEntry->containerType == box::CContainerType::isContainer;
+}
+
+static void walkBoxes(const CParserContext& context, IBoxEventHandler& handler,
+                      ilo::ByteBuffer::const_iterator begin,
+                      const ilo::ByteBuffer::const_iterator& end, uint64_t offset, uint32_t depth);
+
+//! decodes the box in [begin, end) as requested by action and visits its children
+static void walkBox(const CParserContext& context, IBoxEventHandler& handler,
+                    EBoxEventAction action, const ilo::Fourcc& type,
+                    ilo::ByteBuffer::const_iterator begin,
+                    const ilo::ByteBuffer::const_iterator& end, uint64_t offset, uint32_t depth) {
+  bool isContainer = isContainerType(context.registry(), type);
+  if (action == EBoxEventAction::skip || (action == EBoxEventAction::descend && !isContainer)) {
+    return;
+  }
+
+  auto boxBegin = begin;
+  auto box = context.boxFactory().createBox(begin, end);
+  if (action == EBoxEventAction::decode) {
+    handler.onBoxPayload(box, depth);
+  }
+  if (isContainer && begin != end) {
+    walkBoxes(context, handler, begin, end, offset + static_cast<uint64_t>(begin - boxBegin),
+              depth + 1);
+  }
+}
+
+//! reports all sibling boxes in [begin, end), offset is the position of begin in the input
+static void walkBoxes(const CParserContext& context, IBoxEventHandler& handler,
+                      ilo::ByteBuffer::const_iterator begin,
+                      const ilo::ByteBuffer::const_iterator& end, uint64_t offset, uint32_t depth) {
+  const auto first = begin;
+  while (begin != end) {
+    BoxSizeType boxSizeType = tools::getBoxSizeAndType(begin, end);
+    ILO_ASSERT(boxSizeType.size >= boxSizeType.headerLengthInBytes,
+               "Invalid stream. Reported box header is bigger than total box size");
+
+    auto boxEnd = end;
+    if (static_cast<uint64_t>(end - begin) < boxSizeType.size) {
+      ILO_LOG_WARNING("Box size is bigger than remaining buffer - reading might fail");
+    } else {
+      boxEnd = begin + static_cast<std::ptrdiff_t>(boxSizeType.size);
+    }
+
+    uint64_t boxOffset = offset + static_cast<uint64_t>(begin - first);
+    EBoxEventAction action =
+        handler.onBoxBegin(boxSizeType.type, boxOffset, boxSizeType.size, depth);
+    walkBox(context, handler, action, boxSizeType.type, begin, boxEnd, boxOffset, depth);
+    handler.onBoxEnd(boxSizeType.type, depth);
+    begin = boxEnd;
+  }
+}
+
+void parseBoxEvents(const CParserContext& context, std::unique_ptr<IIsobmffInput>& input,
+                    IBoxEventHandler& handler) {
+  auto inputBuffer = input->sharedBuffer();
+  CBoxReader boxreader(input, true);
+  ilo::ByteBuffer buffer;
+
+  while (!boxreader.isEos()) {
+    auto boxOffset = static_cast<uint64_t>(boxreader.position());
+    BoxSizeType boxSizeType = boxreader.readBoxHeaderFields(buffer);
+    EBoxEventAction action = handler.onBoxBegin(boxSizeType.type, boxOffset, boxSizeType.size, 0);
+
+    if (action == EBoxEventAction::skip) {
+      boxreader.skipBoxRemainder(boxSizeType);
+    } else if (boxSizeType.type == "mdat"_fcc) {
+      // the media data itself is never needed for walking the boxes
+      boxreader.skipBoxRemainder(boxSizeType);
+      if (action == EBoxEventAction::decode) {
+        box::CMediaDataBox::SMdatBoxWriteConfig config;
+        config.type = boxSizeType.type;
+        config.payloadSize = boxSizeType.size - boxSizeType.headerLengthInBytes;
+        config.force64BitSizeExt = boxSizeType.headerLengthInBytes > 8;
+        handler.onBoxPayload(context.boxFactory().createBox(config), 0);
+      }
+    } else if (inputBuffer != nullptr) {
+      boxreader.skipBoxRemainder(boxSizeType);
+      auto begin = inputBuffer->cbegin() + static_cast<std::ptrdiff_t>(boxOffset);
+      auto end = inputBuffer->cbegin() + static_cast<std::ptrdiff_t>(boxreader.position());
+      walkBox(context, handler, action, boxSizeType.type, begin, end, boxOffset, 0);
+    } else {
+      boxreader.readBoxRemainder(buffer, boxSizeType);
+      walkBox(context, handler, action, boxSizeType.type, buffer.cbegin(), buffer.cend(),
+              boxOffset, 0);
+    }
+
+    handler.onBoxEnd(boxSizeType.type, 0);
+  }
+}
+}  // namespace isobmff
+}  // namespace mmt
@@ -0,0 +1,149 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2025 - 2026 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+/*
+ * Project: MPEG-4 ISO Base Media File Format (ISO BMFF) library
+ * Content: event based parser walking the boxes of an isobmff input without building a tree
+ */
+
+#pragma once
+
+// System includes
+#include <cstdint>
+#include <memory>
+
+// External includes
+#include "ilo/common_types.h"
+
+// Internal includes
+#include "mmtisobmff/reader/input.h"
+#include "service/parsercontext.h"
+#include "tree/boxtree.h"
+
+namespace mmt {
+namespace isobmff {
+//! What the box event parser should do with a box after onBoxBegin
+enum class EBoxEventAction {
+  //! Neither decode the box nor visit its children
+  skip,
+  //! Visit the children of container boxes without reporting the box itself
+  descend,
+  //! Decode the box, report it with onBoxPayload and visit the children of container boxes
+  decode
+};
+
+/*!
+ * Callbacks of the box event parser
+ *
+ * onBoxBegin and onBoxEnd are called for every visited box, children are reported in between.
+ */
+struct IBoxEventHandler {
+  virtual ~IBoxEventHandler() {}
+
+  /*!
+   * Called when a box starts
+   *
+   * @param type Fourcc of the box
+   * @param offset Offset of the box header from the start of the input
+   * @param size Complete box size in bytes as signaled in the box header
+   * @param depth Nesting level of the box, 0 for top-level boxes
+   */
+  virtual EBoxEventAction onBoxBegin(const ilo::Fourcc& type, uint64_t offset, uint64_t size,
+                                     uint32_t depth) = 0;
+  //! Called with the decoded box if onBoxBegin returned EBoxEventAction::decode
+  virtual void onBoxPayload(const BoxItem& /*box*/, uint32_t /*depth*/) {}
+  //! Called when a box and all its children have been visited
+  virtual void onBoxEnd(const ilo::Fourcc& /*type*/, uint32_t /*depth*/) {}
+};
+
+/*!
+ * function to walk all boxes of an isobmff input in a single forward pass
+ *
+ * No box tree is built and only boxes the handler asks for are decoded. Top-level boxes which are
+ * skipped are never read from the input and the payload of top-level 'mdat' boxes is never read.
+ * Container boxes are decoded up to their first child to visit their children, even if the
+ * handler did not ask to decode them.
+ */
+void parseBoxEvents(const CParserContext& context, std::unique_ptr<IIsobmffInput>& input,
+                    IBoxEventHandler& handler);
+}  // namespace isobmff
+}  // namespace mmt
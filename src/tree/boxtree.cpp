@@ -94,17 +94,34 @@ amm-info@iis.fraunhofer.de
 #include "boxtree.h"
 
 #include "service/boxregistry.h"
-#include "service/servicesingleton.h"
 
 namespace mmt {
 namespace isobmff {
-uint64_t updateSizeAndReturnElementSize(const BoxElement& currentElement) {
-  setupServicesOnce();
-  auto registry = CServiceLocatorSingleton::instance().lock()->getService<IBoxRegistry>().lock();
-  if (registry->isContainer(currentElement.item)) {
+void CBoxTreeIndex::append(const BoxNode& tree, size_t firstChild) {
+  for (size_t index = firstChild; index < tree.childCount(); ++index) {
+    add(tree[index]);
+  }
+}
+
+const CBoxTreeIndex::Elements& CBoxTreeIndex::elements(const ilo::Fourcc& fcc) const {
+  static const Elements noElements;
+  auto elements = m_elements.find(fcc);
+  return elements != m_elements.end() ? elements->second : noElements;
+}
+
+void CBoxTreeIndex::add(const BoxElement& element) {
+  m_elements[element.item->type()].push_back(std::cref(element));
+  for (size_t index = 0; index < element.childCount(); ++index) {
+    add(element[index]);
+  }
+}
+
+uint64_t updateSizeAndReturnElementSize(const BoxElement& currentElement,
+                                        const IBoxRegistry& registry) {
+  if (registry.isContainer(currentElement.item)) {
     uint64_t size = 0;
     for (size_t index = 0; index < currentElement.childCount(); ++index) {
-      size += updateSizeAndReturnElementSize(currentElement[index]);
+      size += updateSizeAndReturnElementSize(currentElement[index], registry);
     }
     currentElement.item->updateSize(size);
   }
@@ -112,28 +129,32 @@ uint64_t updateSizeAndReturnElementSize(const BoxElement& currentElement) {
   return currentElement.item->size();
 }
 
-uint64_t updateSizeAndReturnTotalSize(const BoxTree& tree) {
+uint64_t updateSizeAndReturnTotalSize(const BoxTree& tree, const IBoxRegistry& registry) {
   uint64_t size = 0;
   for (size_t index = 0; index < tree.childCount(); ++index) {
-    size += updateSizeAndReturnElementSize(tree[index]);
+    size += updateSizeAndReturnElementSize(tree[index], registry);
   }
   return size;
 }
 
+void addOverhead(const box::IBox& topLevelBox, SOverheadInfo& info) {
+  if (topLevelBox.type() == "mdat"_fcc) {
+    auto mdatBoxHeaderLength = 8U;
+    if (topLevelBox.had64BitSizeInInput()) {
+      mdatBoxHeaderLength = 16U;
+    }
+    info.sizeOverhead += mdatBoxHeaderLength;
+    info.sizePayload += (topLevelBox.size() - mdatBoxHeaderLength);
+  } else {
+    info.sizeOverhead += topLevelBox.size();
+  }
+}
+
 SOverheadInfo calculateOverhead(const BoxTree& tree) {
   SOverheadInfo info;
 
   for (size_t nodeNr = 0; nodeNr < tree.childCount(); ++nodeNr) {
-    if (tree[nodeNr].item->type() == ilo::toFcc("mdat")) {
-      auto mdatBoxHeaderLength = 8U;
-      if (tree[nodeNr].item->had64BitSizeInInput()) {
-        mdatBoxHeaderLength = 16U;
-      }
-      info.sizeOverhead += mdatBoxHeaderLength;
-      info.sizePayload += (tree[nodeNr].item->size() - mdatBoxHeaderLength);
-    } else {
-      info.sizeOverhead += tree[nodeNr].item->size();
-    }
+    addOverhead(*tree[nodeNr].item, info);
   }
 
   return info;
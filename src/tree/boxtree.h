@@ -91,6 +91,8 @@ amm-info@iis.fraunhofer.de
 #include <cstdio>
 #include <memory>
 #include <functional>
+#include <map>
+#include <vector>
 
 // external include
 #include "ilo/string_utils.h"
@@ -100,6 +102,8 @@ amm-info@iis.fraunhofer.de
 // Internal includes
 #include "box/box.h"
 #include "box/containerbox.h"
+#include "box/lazybox.h"
+#include "common/internal_types.h"
 #include "common/logging.h"
 #include "mmtisobmff/types.h"
 
@@ -110,11 +114,49 @@ using BoxElement = ilo::Element<BoxItem>;
 using BoxNode = ilo::Node<BoxItem, BoxElement>;
 using BoxTree = ilo::NodeTree<BoxItem>;
 
+struct IBoxRegistry;
+
+//! cast a tree item to the requested box type, lazily stored boxes are parsed on first access
+template <class type>
+std::shared_ptr<type> boxItemCast(const BoxItem& item) {
+  auto value = box::boxCast<type>(item);
+  if (value == nullptr && item != nullptr && item->kind() == box::EBoxKind::lazy) {
+    value = box::boxCast<type>(std::static_pointer_cast<box::CLazyBox>(item)->box());
+  }
+  return value;
+}
+
+/*!
+ * Fourcc index over all elements of a box tree
+ *
+ * Lists the elements of every box type in the same order as a visitAllOf traversal, so repeated
+ * lookups don't have to walk the whole tree. The index does not track modifications of the tree.
+ * Top-level boxes that were added after the index was built can be indexed with append.
+ */
+class CBoxTreeIndex {
+ public:
+  using Elements = std::vector<std::reference_wrapper<const BoxElement>>;
+
+  CBoxTreeIndex() = default;
+  explicit CBoxTreeIndex(const BoxNode& tree) { append(tree, 0); }
+
+  //! adds the top-level children [firstChild, childCount) of tree and all their descendants
+  void append(const BoxNode& tree, size_t firstChild);
+
+  //! all indexed elements with the given type
+  const Elements& elements(const ilo::Fourcc& fcc) const;
+
+ private:
+  void add(const BoxElement& element);
+
+  std::map<ilo::Fourcc, Elements> m_elements;
+};
+
 template <class type>
 std::vector<std::shared_ptr<type>> findAllBoxesWithType(const BoxNode& tree) {
   std::vector<std::shared_ptr<type>> boxlist;
   visitAllOf(tree, [&boxlist](const BoxElement& e) mutable {
-    auto value = std::dynamic_pointer_cast<type>(e.item);
+    auto value = boxItemCast<type>(e.item);
     if (value) {
       boxlist.push_back(value);
     }
@@ -127,7 +169,7 @@ std::vector<std::reference_wrapper<const BoxElement>> findAllElementsWithBoxType
     const BoxNode& tree) {
   std::vector<std::reference_wrapper<const BoxElement>> nodelist;
   visitAllOf(tree, [&nodelist](const BoxElement& e) mutable {
-    auto value = std::dynamic_pointer_cast<type>(e.item);
+    auto value = boxItemCast<type>(e.item);
     if (value) {
       nodelist.push_back(ref(e));
     }
@@ -139,7 +181,7 @@ template <class type>
 std::shared_ptr<type> findFirstBoxWithType(const BoxNode& tree) {
   std::shared_ptr<type> box(nullptr);
   visitUntil(tree, [&box](const BoxElement& e) mutable {
-    auto value = std::dynamic_pointer_cast<type>(e.item);
+    auto value = boxItemCast<type>(e.item);
     if (value) {
       box = value;
       return true;
@@ -155,7 +197,7 @@ std::vector<std::shared_ptr<type>> findAllBoxesWithFourccAndType(const BoxNode&
   std::vector<std::shared_ptr<type>> boxlist;
   visitAllOf(tree, [&boxlist, &fcc](const BoxElement& e) mutable {
     if (e.item->type() == fcc) {
-      auto value = std::dynamic_pointer_cast<type>(e.item);
+      auto value = boxItemCast<type>(e.item);
       if (value != nullptr) {
         boxlist.push_back(value);
       }
@@ -170,7 +212,7 @@ std::vector<std::reference_wrapper<const BoxElement>> findAllElementsWithFourccA
   std::vector<std::reference_wrapper<const BoxElement>> nodelist;
   visitAllOf(tree, [&nodelist, &fcc](const BoxElement& e) mutable {
     if (e.item->type() == fcc) {
-      if (std::dynamic_pointer_cast<type>(e.item) != nullptr) {
+      if (boxItemCast<type>(e.item) != nullptr) {
         nodelist.push_back(ref(e));
       }
     }
@@ -184,7 +226,7 @@ std::vector<std::reference_wrapper<const BoxElement>> findAllElementsWithFourccA
   std::vector<std::reference_wrapper<const BoxElement>> nodelist;
   visitAllOf(tree, [&nodelist, &fcc, &level](const BoxElement& e, int32_t currLevel) mutable {
     if (e.item->type() == fcc && currLevel <= level) {
-      if (std::dynamic_pointer_cast<type>(e.item) != nullptr) {
+      if (boxItemCast<type>(e.item) != nullptr) {
         nodelist.push_back(ref(e));
       }
     }
@@ -198,7 +240,7 @@ std::reference_wrapper<const BoxElement> findFirstElementWithFourccAndBoxType(
   std::vector<std::reference_wrapper<const BoxElement>> nodelist;
   visitUntil(tree, [&nodelist, &fcc](const BoxElement& e) mutable {
     if (e.item->type() == fcc) {
-      if (std::dynamic_pointer_cast<type>(e.item) != nullptr) {
+      if (boxItemCast<type>(e.item) != nullptr) {
         nodelist.push_back(ref(e));
         return true;
       }
@@ -214,7 +256,7 @@ std::shared_ptr<type> findFirstBoxWithFourccAndType(const BoxNode& tree, const i
   std::shared_ptr<type> box(nullptr);
   visitUntil(tree, [&box, &fcc](const BoxElement& e) {
     if (e.item->type() == fcc) {
-      auto value = std::dynamic_pointer_cast<type>(e.item);
+      auto value = boxItemCast<type>(e.item);
       if (value) {
         box = value;
         return true;
@@ -225,32 +267,96 @@ std::shared_ptr<type> findFirstBoxWithFourccAndType(const BoxNode& tree, const i
   return box;
 }
 
-template <class box_type, class string_type>
-std::shared_ptr<box_type> findChildBoxByPathTokens(std::reference_wrapper<const BoxElement> elem,
-                                                   std::deque<string_type> tokens) {
-  for (size_t i = 0U; i < elem.get().childCount(); ++i) {
-    if (elem.get()[i].item->type() == ilo::toFcc(tokens[0])) {
-      tokens.pop_front();
-      if (tokens.size() == 0) {
-        return std::dynamic_pointer_cast<box_type>(elem.get()[i].item);
+template <class type>
+std::vector<std::shared_ptr<type>> findAllBoxesWithFourccAndType(const CBoxTreeIndex& index,
+                                                                 const ilo::Fourcc& fcc) {
+  std::vector<std::shared_ptr<type>> boxlist;
+  for (const auto& element : index.elements(fcc)) {
+    auto value = boxItemCast<type>(element.get().item);
+    if (value != nullptr) {
+      boxlist.push_back(value);
+    }
+  }
+  return boxlist;
+}
+
+template <class type>
+std::vector<std::reference_wrapper<const BoxElement>> findAllElementsWithFourccAndBoxType(
+    const CBoxTreeIndex& index, const ilo::Fourcc& fcc) {
+  std::vector<std::reference_wrapper<const BoxElement>> nodelist;
+  for (const auto& element : index.elements(fcc)) {
+    if (boxItemCast<type>(element.get().item) != nullptr) {
+      nodelist.push_back(element);
+    }
+  }
+  return nodelist;
+}
+
+template <class type>
+std::reference_wrapper<const BoxElement> findFirstElementWithFourccAndBoxType(
+    const CBoxTreeIndex& index, const ilo::Fourcc& fcc) {
+  std::vector<std::reference_wrapper<const BoxElement>> nodelist;
+  for (const auto& element : index.elements(fcc)) {
+    if (boxItemCast<type>(element.get().item) != nullptr) {
+      nodelist.push_back(element);
+      break;
+    }
+  }
+  ILO_ASSERT(nodelist.size() == 1, "Box element %s not found in tree", ilo::toString(fcc).c_str());
+  return nodelist.at(0);
+}
+
+template <class type>
+std::shared_ptr<type> findFirstBoxWithFourccAndType(const CBoxTreeIndex& index,
+                                                    const ilo::Fourcc& fcc) {
+  for (const auto& element : index.elements(fcc)) {
+    auto value = boxItemCast<type>(element.get().item);
+    if (value) {
+      return value;
+    }
+  }
+  return std::shared_ptr<type>(nullptr);
+}
+
+//! box path as a sequence of fourccs, e.g. {"mdia"_fcc, "hdlr"_fcc}
+using BoxPath = std::vector<ilo::Fourcc>;
+
+template <class box_type>
+std::shared_ptr<box_type> findChildBoxByPath(const BoxElement& elem, BoxPath::const_iterator first,
+                                             BoxPath::const_iterator last) {
+  for (size_t i = 0U; i < elem.childCount(); ++i) {
+    if (elem[i].item->type() == *first) {
+      if (first + 1 == last) {
+        return boxItemCast<box_type>(elem[i].item);
       } else {
-        return findChildBoxByPathTokens<box_type>(
-            std::reference_wrapper<const BoxElement>(ref(elem.get()[i])), tokens);
+        return findChildBoxByPath<box_type>(elem[i], first + 1, last);
       }
     }
   }
   return std::shared_ptr<box_type>(nullptr);
 }
 
+//! finds the first box in the tree with a matching path (the first fourcc may be on any level)
+template <class box_type>
+std::shared_ptr<box_type> findFirstBoxWithPathAndType(const BoxNode& tree, const BoxPath& path) {
+  ILO_ASSERT(path.size() > 0, "Path specification invalid: empty path");
+  auto root = findFirstElementWithFourccAndBoxType<box::IBox>(tree, path[0]);
+  if (path.size() == 1) {
+    return boxItemCast<box_type>(root.get().item);
+  }
+  return findChildBoxByPath<box_type>(root.get(), path.begin() + 1, path.end());
+}
+
 //! finds the first box in the tree with a matching path specification (e.g. "trak/mdia/hdlr")
 template <class box_type>
 std::shared_ptr<box_type> findFirstBoxWithPathAndType(const BoxNode& tree,
                                                       const std::string& path) {
-  auto tokens = ilo::tokenize(path, '/');
-  ILO_ASSERT(tokens.size() > 0, "Path specification invalid: %s", path.c_str());
-  auto root = findFirstElementWithFourccAndBoxType<box::IBox>(tree, ilo::toFcc(tokens[0]));
-  tokens.pop_front();
-  return findChildBoxByPathTokens<box_type>(root, tokens);
+  BoxPath boxPath;
+  for (const auto& token : ilo::tokenize(path, '/')) {
+    boxPath.push_back(ilo::toFcc(token));
+  }
+  ILO_ASSERT(boxPath.size() > 0, "Path specification invalid: %s", path.c_str());
+  return findFirstBoxWithPathAndType<box_type>(tree, boxPath);
 }
 
 inline void prettyPrintTree(const BoxNode& tree) {
@@ -267,7 +373,7 @@ inline uint64_t treeSizeWithoutMdatPayloadInBytes(const BoxNode& tree) {
 
   for (size_t nodeNr = 0; nodeNr < tree.childCount(); ++nodeNr) {
     treeSize += tree[nodeNr].item->size();
-    if (tree[nodeNr].item->type() == ilo::toFcc("mdat")) {
+    if (tree[nodeNr].item->type() == "mdat"_fcc) {
       auto mdatBoxHeaderLength = 8U;
       if (tree[nodeNr].item->had64BitSizeInInput()) {
         mdatBoxHeaderLength = 16U;
@@ -286,9 +392,13 @@ inline void serializeTree(const BoxNode& tree, ilo::ByteBuffer& writeBuffer,
                   [&writeBuffer, &iter](const BoxElement& e) { e.item->write(writeBuffer, iter); });
 }
 
-uint64_t updateSizeAndReturnElementSize(const BoxElement& currentElement);
+uint64_t updateSizeAndReturnElementSize(const BoxElement& currentElement,
+                                        const IBoxRegistry& registry);
+
+uint64_t updateSizeAndReturnTotalSize(const BoxTree& tree, const IBoxRegistry& registry);
 
-uint64_t updateSizeAndReturnTotalSize(const BoxTree& tree);
+//! Adds a top-level box to info, the payload of mdat boxes is media data, everything else overhead
+void addOverhead(const box::IBox& topLevelBox, SOverheadInfo& info);
 
 SOverheadInfo calculateOverhead(const BoxTree& tree);
 
@@ -87,34 +87,139 @@ amm-info@iis.fraunhofer.de
 
 #pragma once
 
+// System includes
+#include <vector>
+
 #include "mmtisobmff/reader/input.h"
 
 #include "boxtree.h"
-#include "service/servicesingleton.h"
+#include "service/parsercontext.h"
 #include "service/boxreader.h"
 #include "box/mdatbox.h"
 
 namespace mmt {
 namespace isobmff {
+//! Location of a top-level box in an isobmff input as found by scanTopLevelBoxes
+struct STopLevelBoxInfo {
+  ilo::Fourcc type;
+  //! Offset of the box header from the start of the input
+  uint64_t offset = 0;
+  //! Complete box size in bytes as signaled in the box header
+  uint64_t size = 0;
+  uint32_t headerSize = 0;
+};
+
+using TopLevelBoxIndex = std::vector<STopLevelBoxInfo>;
+
+/*!
+ * function to add a box that was read by the box reader to the tree
+ *
+ * The box is parsed from [begin, end) which must be a range inside buffer. With lazyPayloads set,
+ * sample tables only keep their location in the shared buffer and are parsed on first typed
+ * access (see boxItemCast).
+ */
+inline void createNodeFromBox(const CParserContext& context, BoxTree& tree,
+                              const std::shared_ptr<const ilo::ByteBuffer>& buffer,
+                              ilo::ByteBuffer::const_iterator begin,
+                              const ilo::ByteBuffer::const_iterator& end,
+                              const BoxSizeType& boxSizeAndType, bool lazyPayloads = false) {
+  const INodeFactory& nodefactory = context.nodeFactory();
+
+  if (boxSizeAndType.type == "mdat"_fcc) {
+    box::CMediaDataBox::SMdatBoxWriteConfig config;
+    config.type = boxSizeAndType.type;
+    config.payloadSize = boxSizeAndType.size - boxSizeAndType.headerLengthInBytes;
+    config.force64BitSizeExt = boxSizeAndType.headerLengthInBytes > 8 ? true : false;
+    nodefactory.createNode(tree, config);
+  } else {
+    if (lazyPayloads) {
+      nodefactory.createLazyNode(tree, buffer, begin, end);
+    } else {
+      nodefactory.createNode(tree, begin, end);
+    }
+    ILO_ASSERT(begin == end, "Box was not read to the end?");
+  }
+}
+
+//! function to add a box that was read by the box reader into its own buffer to the tree
+inline void createNodeFromBox(const CParserContext& context, BoxTree& tree,
+                              const std::shared_ptr<const ilo::ByteBuffer>& buffer,
+                              const BoxSizeType& boxSizeAndType, bool lazyPayloads = false) {
+  createNodeFromBox(context, tree, buffer, buffer->begin(), buffer->end(), boxSizeAndType,
+                    lazyPayloads);
+}
+
+/*!
+ * function to read the next top-level box and add it to the tree
+ *
+ * If the input is backed by a shared buffer, the box is parsed in place from that buffer.
+ * Otherwise the box is copied into a buffer of its own first.
+ */
+inline void readNodeFromInput(const CParserContext& context, BoxTree& tree, CBoxReader& boxreader,
+                              const std::shared_ptr<const ilo::ByteBuffer>& inputBuffer,
+                              bool lazyPayloads = false) {
+  if (inputBuffer == nullptr) {
+    auto buffer = std::make_shared<ilo::ByteBuffer>();
+    auto boxSizeAndType = boxreader.readBoxInto(*buffer);
+    createNodeFromBox(context, tree, buffer, boxSizeAndType, lazyPayloads);
+    return;
+  }
+
+  auto boxBegin = boxreader.position();
+  auto boxSizeAndType = boxreader.skipBox();
+  ILO_ASSERT(boxreader.position() <= inputBuffer->size(), "Box exceeds the input buffer");
+  auto begin = inputBuffer->begin() + static_cast<std::ptrdiff_t>(boxBegin);
+  auto end = inputBuffer->begin() + static_cast<std::ptrdiff_t>(boxreader.position());
+  createNodeFromBox(context, tree, inputBuffer, begin, end, boxSizeAndType, lazyPayloads);
+}
+
 //! function to build a tree from a isobmff input (file, memory, etc.)
-inline void parseTree(BoxTree& tree, std::unique_ptr<IIsobmffInput>& input) {
-  auto nodefactory = CServiceLocatorSingleton::instance().lock()->getService<INodeFactory>().lock();
+inline void parseTree(const CParserContext& context, BoxTree& tree,
+                      std::unique_ptr<IIsobmffInput>& input) {
+  auto inputBuffer = input->sharedBuffer();
+  CBoxReader boxreader(input, true);
+  while (!boxreader.isEos()) {
+    readNodeFromInput(context, tree, boxreader, inputBuffer);
+  }
+}
 
+//! function to locate all top-level boxes of an isobmff input by reading their headers only
+inline TopLevelBoxIndex scanTopLevelBoxes(std::unique_ptr<IIsobmffInput>& input) {
+  TopLevelBoxIndex index;
   CBoxReader boxreader(input, true);
   while (!boxreader.isEos()) {
-    ilo::ByteBuffer buffer;
-    auto boxSizeAndType = boxreader.readBoxInto(buffer);
-    if (boxSizeAndType.type == ilo::toFcc("mdat")) {
-      box::CMediaDataBox::SMdatBoxWriteConfig config;
-      config.type = boxSizeAndType.type;
-      config.payloadSize = boxSizeAndType.size - boxSizeAndType.headerLengthInBytes;
-      config.force64BitSizeExt = boxSizeAndType.headerLengthInBytes > 8 ? true : false;
-      nodefactory->createNode(tree, config);
-    } else {
-      ilo::ByteBuffer::const_iterator begin = buffer.begin();
-      nodefactory->createNode(tree, begin, buffer.end());
-      ILO_ASSERT(begin == buffer.end(), "Box was not read to the end?");
-    }
+    STopLevelBoxInfo info;
+    info.offset = static_cast<uint64_t>(boxreader.position());
+    auto boxSizeAndType = boxreader.skipBox();
+    info.type = boxSizeAndType.type;
+    info.size = boxSizeAndType.size;
+    info.headerSize = boxSizeAndType.headerLengthInBytes;
+    index.push_back(info);
+  }
+  return index;
+}
+
+/*!
+ * function to fully parse the top-level boxes [first, last) of a previously scanned input
+ *
+ * Boxes are appended to the tree, so ranges have to be parsed in input order to keep the tree
+ * layout identical to a complete parse.
+ */
+inline void parseTree(const CParserContext& context, BoxTree& tree,
+                      std::unique_ptr<IIsobmffInput>& input, const TopLevelBoxIndex& index,
+                      size_t first, size_t last, bool lazyPayloads = false) {
+  ILO_ASSERT(first <= last && last <= index.size(), "Invalid top-level box range");
+  if (first == last) {
+    return;
+  }
+
+  auto inputBuffer = input->sharedBuffer();
+  input->seek(static_cast<pos_type>(index[first].offset));
+  CBoxReader boxreader(input, true);
+  for (size_t i = first; i < last; ++i) {
+    ILO_ASSERT(static_cast<uint64_t>(boxreader.position()) == index[i].offset,
+               "Top-level box index does not match the input");
+    readNodeFromInput(context, tree, boxreader, inputBuffer, lazyPayloads);
   }
 }
 }  // namespace isobmff
@@ -97,8 +97,10 @@ amm-info@iis.fraunhofer.de
 
 namespace mmt {
 namespace isobmff {
-CAvcTreeEnhancer::CAvcTreeEnhancer(BoxElement& subTree, const SAvcEnhancerConfig& config) {
-  ILO_ASSERT_WITH(subTree.item->type() == (ilo::toFcc("stsd")), std::invalid_argument,
+CAvcTreeEnhancer::CAvcTreeEnhancer(const CParserContext& context, BoxElement& subTree,
+                                   const SAvcEnhancerConfig& config)
+    : CDefaultTreeEnhancer(context) {
+  ILO_ASSERT_WITH(subTree.item->type() == "stsd"_fcc, std::invalid_argument,
                   "CAvcTreeEnhancer: the stsd box element was not provided!");
 
   const auto& avcNode = addElement(subTree, config.avc1Config);
@@ -106,12 +108,12 @@ CAvcTreeEnhancer::CAvcTreeEnhancer(BoxElement& subTree, const SAvcEnhancerConfig
   // HINT: For Avc the decoder config is mandatory but we are not asserting here on purpose to allow
   // the user to write wrong files if necessary
   if (config.decoderConfig != nullptr) {
-    box::CDecoderConfigurationBox::SConfigBoxWriteConfig avcC(ilo::toFcc("avcC"));
+    box::CDecoderConfigurationBox::SConfigBoxWriteConfig avcC("avcC"_fcc);
     avcC.decoderConfigRecord.resize(static_cast<size_t>(config.decoderConfig->size()));
     ilo::ByteBuffer::iterator iter = avcC.decoderConfigRecord.begin();
     config.decoderConfig->write(avcC.decoderConfigRecord, iter);
     addElement(avcNode, avcC);
-    updateSizeAndReturnElementSize(subTree);
+    updateSizeAndReturnElementSize(subTree, context.registry());
   }
 }
 }  // namespace isobmff
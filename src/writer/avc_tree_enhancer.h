@@ -96,7 +96,7 @@ namespace mmt {
 namespace isobmff {
 // a struct of the configuration info of all the boxes and the tree to be enhanced
 struct SAvcEnhancerConfig {
-  SAvcEnhancerConfig() : avc1Config(ilo::toFcc("avc1")) {}
+  SAvcEnhancerConfig() : avc1Config("avc1"_fcc) {}
   box::CAvcSampleEntry::SAvcSampleEntryWriteConfig avc1Config;
   std::unique_ptr<config::CAvcDecoderConfigRecord> decoderConfig;
 };
@@ -104,7 +104,8 @@ struct SAvcEnhancerConfig {
 class CAvcTreeEnhancer : public CDefaultTreeEnhancer {
  public:
   // Constructor takes the configuration info of the boxes
-  CAvcTreeEnhancer(BoxElement& subTree, const SAvcEnhancerConfig& config);
+  CAvcTreeEnhancer(const CParserContext& context, BoxElement& subTree,
+                   const SAvcEnhancerConfig& config);
 };
 }  // namespace isobmff
 }  // namespace mmt
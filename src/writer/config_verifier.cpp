@@ -97,17 +97,18 @@ amm-info@iis.fraunhofer.de
 // Project includes
 #include "config_verifier.h"
 #include "mmtisobmff/writer/writer.h"
+#include "common/internal_types.h"
 #include "common/logging.h"
 
 namespace mmt {
 namespace isobmff {
 CMovieConfigVerifier::CMovieConfigVerifier(const SMovieConfig& config, bool strictVerification) {
   try {
-    ILO_ASSERT_WITH(config.majorBrand != ilo::toFcc("0000"), std::invalid_argument,
+    ILO_ASSERT_WITH(config.majorBrand != "0000"_fcc, std::invalid_argument,
                     "Major brand with a value of 0000 is not allowed!");
 
     for (auto curBrand : config.compatibleBrands) {
-      ILO_ASSERT_WITH(curBrand != ilo::toFcc("0000"), std::invalid_argument,
+      ILO_ASSERT_WITH(curBrand != "0000"_fcc, std::invalid_argument,
                       "Compatible brand with a value of 0000 is not allowed!");
 
       auto compBrandsOcc =
@@ -97,9 +97,10 @@ amm-info@iis.fraunhofer.de
 
 namespace mmt {
 namespace isobmff {
-CHevcTreeEnhancer::CHevcTreeEnhancer(BoxElement& subTree, const SHevcEnhancerConfig& config)
-    : CDefaultTreeEnhancer() {
-  ILO_ASSERT_WITH(subTree.item->type() == (ilo::toFcc("stsd")), std::invalid_argument,
+CHevcTreeEnhancer::CHevcTreeEnhancer(const CParserContext& context, BoxElement& subTree,
+                                     const SHevcEnhancerConfig& config)
+    : CDefaultTreeEnhancer(context) {
+  ILO_ASSERT_WITH(subTree.item->type() == "stsd"_fcc, std::invalid_argument,
                   "CHevcTreeEnhancer: stsd box was not found!");
 
   const auto& hevcNode = addElement(subTree, config.sampleEntryConfig);
@@ -107,12 +108,12 @@ CHevcTreeEnhancer::CHevcTreeEnhancer(BoxElement& subTree, const SHevcEnhancerCon
   // HINT: For Hevc the decoder config is mandatory but we are not asserting here on purpose to
   // allow the user to write wrong files if necessary
   if (config.decoderConfig != nullptr) {
-    box::CDecoderConfigurationBox::SConfigBoxWriteConfig hvcC(ilo::toFcc("hvcC"));
+    box::CDecoderConfigurationBox::SConfigBoxWriteConfig hvcC("hvcC"_fcc);
     hvcC.decoderConfigRecord.resize(static_cast<size_t>(config.decoderConfig->size()));
     ilo::ByteBuffer::iterator iter = hvcC.decoderConfigRecord.begin();
     config.decoderConfig->write(hvcC.decoderConfigRecord, iter);
     addElement(hevcNode, hvcC);
-    updateSizeAndReturnElementSize(subTree);
+    updateSizeAndReturnElementSize(subTree, context.registry());
   }
 }
 }  // namespace isobmff
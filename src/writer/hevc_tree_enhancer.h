@@ -104,17 +104,18 @@ struct SHevcEnhancerConfig {
 };
 
 struct SHvc1EnhancerConfig : SHevcEnhancerConfig {
-  SHvc1EnhancerConfig() : SHevcEnhancerConfig(ilo::toFcc("hvc1")) {}
+  SHvc1EnhancerConfig() : SHevcEnhancerConfig("hvc1"_fcc) {}
 };
 
 struct SHev1EnhancerConfig : SHevcEnhancerConfig {
-  SHev1EnhancerConfig() : SHevcEnhancerConfig(ilo::toFcc("hev1")) {}
+  SHev1EnhancerConfig() : SHevcEnhancerConfig("hev1"_fcc) {}
 };
 
 class CHevcTreeEnhancer : public CDefaultTreeEnhancer {
  public:
   // Constructor takes the configuration info of the boxes
-  CHevcTreeEnhancer(BoxElement& subTree, const SHevcEnhancerConfig& config);
+  CHevcTreeEnhancer(const CParserContext& context, BoxElement& subTree,
+                    const SHevcEnhancerConfig& config);
 };
 }  // namespace isobmff
 }  // namespace mmt
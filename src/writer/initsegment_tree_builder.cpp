@@ -95,25 +95,23 @@ amm-info@iis.fraunhofer.de
 #include "initsegment_tree_builder.h"
 #include "box/containerbox.h"
 #include "service/factory.h"
-#include "service/servicesingleton.h"
+#include "service/parsercontext.h"
 
 namespace mmt {
 namespace isobmff {
-CInitSegmentTreeBuilder::CInitSegmentTreeBuilder(const SInitSegmentConfig& config)
-    : m_config(config) {}
+CInitSegmentTreeBuilder::CInitSegmentTreeBuilder(const CParserContext& context,
+                                                 const SInitSegmentConfig& config)
+    : m_context(context), m_config(config) {}
 
 std::unique_ptr<BoxTree> CInitSegmentTreeBuilder::build() {
   std::unique_ptr<BoxTree> tree = ilo::make_unique<BoxTree>();
   {
-    setupServicesOnce();
-    auto nodefactory =
-        CServiceLocatorSingleton::instance().lock()->getService<INodeFactory>().lock();
-    nodefactory->createNode(*tree, m_config.ftypConfig);
-    nodefactory->createNode(*tree,
-                            box::CContainerBox::SContainerBoxWriteConfig(ilo::toFcc("moov")));
-    nodefactory->createNode((*tree)[1], m_config.mvhdConfig);
+    const INodeFactory& nodefactory = m_context.nodeFactory();
+    nodefactory.createNode(*tree, m_config.ftypConfig);
+    nodefactory.createNode(*tree, box::CContainerBox::SContainerBoxWriteConfig("moov"_fcc));
+    nodefactory.createNode((*tree)[1], m_config.mvhdConfig);
   }
-  updateSizeAndReturnTotalSize(*tree);
+  updateSizeAndReturnTotalSize(*tree, m_context.registry());
   return tree;
 }
 }  // namespace isobmff
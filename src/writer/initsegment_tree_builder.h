@@ -90,6 +90,7 @@ amm-info@iis.fraunhofer.de
 // Internal includes
 #include "treebuilder.h"
 #include "tree/boxtree.h"
+#include "service/parsercontext.h"
 #include "box/ftypbox.h"
 #include "box/mvhdbox.h"
 
@@ -104,11 +105,12 @@ struct SInitSegmentConfig {
 class CInitSegmentTreeBuilder : public ITreeBuilder {
  public:
   // Constructor takes the configuration info of the boxes
-  CInitSegmentTreeBuilder(const SInitSegmentConfig& config);
+  CInitSegmentTreeBuilder(const CParserContext& context, const SInitSegmentConfig& config);
   // The build() returns tree with the ftyp and moov boxes
   std::unique_ptr<BoxTree> build();
 
  private:
+  const CParserContext& m_context;
   SInitSegmentConfig m_config;
 };
 }  // namespace isobmff
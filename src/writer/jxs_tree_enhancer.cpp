@@ -102,16 +102,18 @@ amm-info@iis.fraunhofer.de
 
 namespace mmt {
 namespace isobmff {
-CJxsTreeEnhancer::CJxsTreeEnhancer(BoxElement& subTree, const SJxsEnhancerConfig& config) {
-  ILO_ASSERT_WITH(subTree.item->type() == (ilo::toFcc("stsd")), std::invalid_argument,
+CJxsTreeEnhancer::CJxsTreeEnhancer(const CParserContext& context, BoxElement& subTree,
+                                   const SJxsEnhancerConfig& config)
+    : CDefaultTreeEnhancer(context) {
+  ILO_ASSERT_WITH(subTree.item->type() == "stsd"_fcc, std::invalid_argument,
                   "CJxsTreeEnhancer: the stsd box element was not provided!");
 
-  box::CJxsSampleEntry::SCJXSSampleEntryWriteConfig jxsSampleEntryConfig(ilo::toFcc("jxsm"));
+  box::CJxsSampleEntry::SCJXSSampleEntryWriteConfig jxsSampleEntryConfig("jxsm"_fcc);
 
   const auto& jxsmNode = addElement(subTree, config.jxsmConfig);
 
   if (config.jxsExtraData != nullptr) {
-    box::CContainerBox::SContainerBoxWriteConfig jpvsConfig(ilo::toFcc("jpvs"));
+    box::CContainerBox::SContainerBoxWriteConfig jpvsConfig("jpvs"_fcc);
     const auto& jpvsNode = addElement(jxsmNode, jpvsConfig);
 
     box::CJPEGXSVideoInformationBox::SJPEGXSVideoInformationBoxWriteConfig jpviConfig(
@@ -137,14 +139,14 @@ CJxsTreeEnhancer::CJxsTreeEnhancer(BoxElement& subTree, const SJxsEnhancerConfig
   }
 
   if (config.decoderConfig != nullptr) {
-    box::CDecoderConfigurationBox::SConfigBoxWriteConfig jxsHConfig(ilo::toFcc("jxsH"));
+    box::CDecoderConfigurationBox::SConfigBoxWriteConfig jxsHConfig("jxsH"_fcc);
     jxsHConfig.decoderConfigRecord.resize(static_cast<size_t>(config.decoderConfig->size()));
     auto iter = jxsHConfig.decoderConfigRecord.begin();
     config.decoderConfig->write(jxsHConfig.decoderConfigRecord, iter);
 
     addElement(jxsmNode, jxsHConfig);
   }
-  updateSizeAndReturnElementSize(subTree);
+  updateSizeAndReturnElementSize(subTree, context.registry());
 }
 }  // namespace isobmff
 }  // namespace mmt
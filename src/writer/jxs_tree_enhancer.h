@@ -97,7 +97,7 @@ namespace isobmff {
 // a struct of the configuration info of all the boxes and the tree to be enhanced
 struct SJxsEnhancerConfig {
   box::CJxsSampleEntry::SCJXSSampleEntryWriteConfig jxsmConfig =
-      box::CJxsSampleEntry::SCJXSSampleEntryWriteConfig(ilo::toFcc("jxsm"));
+      box::CJxsSampleEntry::SCJXSSampleEntryWriteConfig("jxsm"_fcc);
   std::unique_ptr<config::CJxsDecoderConfigRecord> decoderConfig;
   std::unique_ptr<SJpegxsExtraData> jxsExtraData;
 };
@@ -105,7 +105,8 @@ struct SJxsEnhancerConfig {
 class CJxsTreeEnhancer : public CDefaultTreeEnhancer {
  public:
   // Constructor takes the configuration info of the boxes
-  CJxsTreeEnhancer(BoxElement& subTree, const SJxsEnhancerConfig& config);
+  CJxsTreeEnhancer(const CParserContext& context, BoxElement& subTree,
+                   const SJxsEnhancerConfig& config);
 };
 }  // namespace isobmff
 }  // namespace mmt
@@ -94,25 +94,23 @@ amm-info@iis.fraunhofer.de
 // project includes
 #include "mediafragment_tree_builder.h"
 #include "service/factory.h"
-#include "service/servicesingleton.h"
+#include "service/parsercontext.h"
 #include "box/containerbox.h"
 
 namespace mmt {
 namespace isobmff {
-CMediaFragmentTreeBuilder::CMediaFragmentTreeBuilder(const SMediaFragmentTreeConfig& config)
-    : m_config(config) {}
+CMediaFragmentTreeBuilder::CMediaFragmentTreeBuilder(const CParserContext& context,
+                                                     const SMediaFragmentTreeConfig& config)
+    : m_context(context), m_config(config) {}
 
 std::unique_ptr<BoxTree> CMediaFragmentTreeBuilder::build() {
   std::unique_ptr<BoxTree> tree = ilo::make_unique<BoxTree>();
   {
-    setupServicesOnce();
-    auto nodefactory =
-        CServiceLocatorSingleton::instance().lock()->getService<INodeFactory>().lock();
-    nodefactory->createNode(*tree,
-                            box::CContainerBox::SContainerBoxWriteConfig(ilo::toFcc("moof")));
-    nodefactory->createNode((*tree)[0], m_config.mfhdConfig);
+    const INodeFactory& nodefactory = m_context.nodeFactory();
+    nodefactory.createNode(*tree, box::CContainerBox::SContainerBoxWriteConfig("moof"_fcc));
+    nodefactory.createNode((*tree)[0], m_config.mfhdConfig);
   }
-  updateSizeAndReturnTotalSize(*tree);
+  updateSizeAndReturnTotalSize(*tree, m_context.registry());
   return tree;
 }
 }  // namespace isobmff
@@ -90,6 +90,7 @@ amm-info@iis.fraunhofer.de
 // Internal includes
 #include "treebuilder.h"
 #include "tree/boxtree.h"
+#include "service/parsercontext.h"
 #include "box/mfhdbox.h"
 
 namespace mmt {
@@ -102,11 +103,12 @@ struct SMediaFragmentTreeConfig {
 class CMediaFragmentTreeBuilder : public ITreeBuilder {
  public:
   // Constructor takes the configuration info of the boxes
-  CMediaFragmentTreeBuilder(const SMediaFragmentTreeConfig& config);
+  CMediaFragmentTreeBuilder(const CParserContext& context, const SMediaFragmentTreeConfig& config);
   // The build() returns tree with the moof, mfhd and traf boxes
   std::unique_ptr<BoxTree> build();
 
  private:
+  const CParserContext& m_context;
   SMediaFragmentTreeConfig m_config;
 };
 }  // namespace isobmff
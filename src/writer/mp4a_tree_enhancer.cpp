@@ -97,8 +97,10 @@ amm-info@iis.fraunhofer.de
 
 namespace mmt {
 namespace isobmff {
-CMp4aTreeEnhancer::CMp4aTreeEnhancer(BoxElement& subTree, const SMp4aEnhancerConfig& config) {
-  ILO_ASSERT_WITH(subTree.item->type() == (ilo::toFcc("stsd")), std::invalid_argument,
+CMp4aTreeEnhancer::CMp4aTreeEnhancer(const CParserContext& context, BoxElement& subTree,
+                                     const SMp4aEnhancerConfig& config)
+    : CDefaultTreeEnhancer(context) {
+  ILO_ASSERT_WITH(subTree.item->type() == "stsd"_fcc, std::invalid_argument,
                   "CMp4aTreeEnhancer: stsd box was not found!");
 
   const auto& mp4aNode = addElement(subTree, config.mp4aConfig);
@@ -107,12 +109,12 @@ CMp4aTreeEnhancer::CMp4aTreeEnhancer(BoxElement& subTree, const SMp4aEnhancerCon
   // allow the user to write wrong files if necessary
   if (config.decoderConfig != nullptr) {
     box::CDecoderConfigurationFullBox::SConfigFullBoxWriteConfig esds(
-        ilo::toFcc("esds"), 0, 0);  // version and flags are 0
+        "esds"_fcc, 0, 0);  // version and flags are 0
     esds.decoderConfigRecord.resize(static_cast<size_t>(config.decoderConfig->size()));
     ilo::ByteBuffer::iterator iter = esds.decoderConfigRecord.begin();
     config.decoderConfig->write(esds.decoderConfigRecord, iter);
     addElement(mp4aNode, esds);
-    updateSizeAndReturnElementSize(subTree);
+    updateSizeAndReturnElementSize(subTree, context.registry());
   }
 }
 }  // namespace isobmff
@@ -96,7 +96,7 @@ namespace mmt {
 namespace isobmff {
 // a struct of the configuration info of all the boxes and the tree to be enhanced
 struct SMp4aEnhancerConfig {
-  SMp4aEnhancerConfig() : mp4aConfig(ilo::toFcc("mp4a")) {}
+  SMp4aEnhancerConfig() : mp4aConfig("mp4a"_fcc) {}
   box::CMp4aSampleEntry::SMp4aSampleEntryWriteConfig mp4aConfig;
   std::unique_ptr<config::CMp4aDecoderConfigRecord> decoderConfig;
 };
@@ -104,7 +104,8 @@ struct SMp4aEnhancerConfig {
 class CMp4aTreeEnhancer : public CDefaultTreeEnhancer {
  public:
   // Constructor takes the configuration info of the boxes
-  CMp4aTreeEnhancer(BoxElement& subTree, const SMp4aEnhancerConfig& config);
+  CMp4aTreeEnhancer(const CParserContext& context, BoxElement& subTree,
+                    const SMp4aEnhancerConfig& config);
 };
 }  // namespace isobmff
 }  // namespace mmt
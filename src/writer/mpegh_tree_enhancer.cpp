@@ -98,24 +98,27 @@ amm-info@iis.fraunhofer.de
 
 namespace mmt {
 namespace isobmff {
-CMpeghTreeEnhancer::CMpeghTreeEnhancer(BoxElement& subTree, const SMhm1EnhancerConfig& config)
-    : CDefaultTreeEnhancer() {
+CMpeghTreeEnhancer::CMpeghTreeEnhancer(const CParserContext& context, BoxElement& subTree,
+                                       const SMhm1EnhancerConfig& config)
+    : CDefaultTreeEnhancer(context) {
   setup(subTree, config);
 }
 
-CMpeghTreeEnhancer::CMpeghTreeEnhancer(BoxElement& subTree, const SMhm2EnhancerConfig& config)
-    : CDefaultTreeEnhancer() {
+CMpeghTreeEnhancer::CMpeghTreeEnhancer(const CParserContext& context, BoxElement& subTree,
+                                       const SMhm2EnhancerConfig& config)
+    : CDefaultTreeEnhancer(context) {
   setup(subTree, config);
 }
 
-CMpeghTreeEnhancer::CMpeghTreeEnhancer(BoxElement& subTree, const SMha1EnhancerConfig& config)
-    : CDefaultTreeEnhancer() {
+CMpeghTreeEnhancer::CMpeghTreeEnhancer(const CParserContext& context, BoxElement& subTree,
+                                       const SMha1EnhancerConfig& config)
+    : CDefaultTreeEnhancer(context) {
   setup(subTree, config);
 }
 
 template <typename TEnhConfig>
 void CMpeghTreeEnhancer::setup(BoxElement& subTree, const TEnhConfig& config) {
-  ILO_ASSERT_WITH(subTree.item->type() == (ilo::toFcc("stsd")), std::invalid_argument,
+  ILO_ASSERT_WITH(subTree.item->type() == "stsd"_fcc, std::invalid_argument,
                   "CMpeghTreeEnhancer: stsd box was not found!");
 
   const auto& mpeghNode = addElement(subTree, config.sampleEntryConfig);
@@ -124,19 +127,19 @@ void CMpeghTreeEnhancer::setup(BoxElement& subTree, const TEnhConfig& config) {
   // allow to write "wrong" files if necessary (e.g. for special copy functions). It will be
   // prevented and checked by higher-level/user-facing functions/interfaces
   if (config.decoderConfig != nullptr) {
-    box::CDecoderConfigurationBox::SConfigBoxWriteConfig mhaC(ilo::toFcc("mhaC"));
+    box::CDecoderConfigurationBox::SConfigBoxWriteConfig mhaC("mhaC"_fcc);
     mhaC.decoderConfigRecord.resize(static_cast<size_t>(config.decoderConfig->size()));
     ilo::ByteBuffer::iterator iter = mhaC.decoderConfigRecord.begin();
     config.decoderConfig->write(mhaC.decoderConfigRecord, iter);
     addElement(mpeghNode, mhaC);
-    updateSizeAndReturnElementSize(subTree);
+    updateSizeAndReturnElementSize(subTree, m_context.registry());
   }
 
   if (!config.profileAndLevelCompatibleSets.empty()) {
     box::CMhaProfileLevelCompatibilitySetBox::SMhaPBoxWriteConfig mhaPConfig;
     mhaPConfig.profileAndLevelCompatibleSets = config.profileAndLevelCompatibleSets;
     addElement(mpeghNode, mhaPConfig);
-    updateSizeAndReturnElementSize(subTree);
+    updateSizeAndReturnElementSize(subTree, m_context.registry());
   }
 }
 }  // namespace isobmff
@@ -109,25 +109,28 @@ struct SMpeghEnhancerConfig {
 
 struct SMhm1EnhancerConfig
     : SMpeghEnhancerConfig<box::CMhmSampleEntry::SMhmSampleEntryWriteConfig> {
-  SMhm1EnhancerConfig() : SMpeghEnhancerConfig(ilo::toFcc("mhm1")) {}
+  SMhm1EnhancerConfig() : SMpeghEnhancerConfig("mhm1"_fcc) {}
 };
 
 struct SMhm2EnhancerConfig
     : SMpeghEnhancerConfig<box::CMhmSampleEntry::SMhmSampleEntryWriteConfig> {
-  SMhm2EnhancerConfig() : SMpeghEnhancerConfig(ilo::toFcc("mhm2")) {}
+  SMhm2EnhancerConfig() : SMpeghEnhancerConfig("mhm2"_fcc) {}
 };
 
 struct SMha1EnhancerConfig
     : SMpeghEnhancerConfig<box::CMhaSampleEntry::SMhaSampleEntryWriteConfig> {
-  SMha1EnhancerConfig() : SMpeghEnhancerConfig(ilo::toFcc("mha1")) {}
+  SMha1EnhancerConfig() : SMpeghEnhancerConfig("mha1"_fcc) {}
 };
 
 class CMpeghTreeEnhancer : public CDefaultTreeEnhancer {
  public:
   // Constructor takes the configuration info of the boxes
-  CMpeghTreeEnhancer(BoxElement& subTree, const SMhm1EnhancerConfig& config);
-  CMpeghTreeEnhancer(BoxElement& subTree, const SMhm2EnhancerConfig& config);
-  CMpeghTreeEnhancer(BoxElement& subTree, const SMha1EnhancerConfig& config);
+  CMpeghTreeEnhancer(const CParserContext& context, BoxElement& subTree,
+                     const SMhm1EnhancerConfig& config);
+  CMpeghTreeEnhancer(const CParserContext& context, BoxElement& subTree,
+                     const SMhm2EnhancerConfig& config);
+  CMpeghTreeEnhancer(const CParserContext& context, BoxElement& subTree,
+                     const SMha1EnhancerConfig& config);
 
  private:
   template <typename TEnhConfig>
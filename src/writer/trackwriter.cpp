@@ -112,7 +112,7 @@ amm-info@iis.fraunhofer.de
 #include "writer/writerpimpl.h"
 #include "tree/boxtree.h"
 #include "service/factory.h"
-#include "service/servicesingleton.h"
+#include "service/parsercontext.h"
 #include "box/sampleentry.h"
 #include "box/containerbox.h"
 #include "box/stsdbox.h"
@@ -124,12 +124,12 @@ namespace isobmff {
 struct CTrackWriter::SPimpl {
   SPimpl(const SBaseAudioConfig& config) {
     m_enhancerConfig.mdhdConfig.language = config.language;
-    m_enhancerConfig.hdlrConfig.handlerType = ilo::toFcc("soun");
+    m_enhancerConfig.hdlrConfig.handlerType = "soun"_fcc;
     m_enhancerConfig.hdlrConfig.name = "soun";
   };
 
   SPimpl(const SBaseVideoConfig& config) {
-    m_enhancerConfig.hdlrConfig.handlerType = ilo::toFcc("vide");
+    m_enhancerConfig.hdlrConfig.handlerType = "vide"_fcc;
     m_enhancerConfig.hdlrConfig.name = "VideoHandler";
     m_enhancerConfig.tkhdConfig.width = config.width;
     m_enhancerConfig.tkhdConfig.height = config.height;
@@ -137,26 +137,25 @@ struct CTrackWriter::SPimpl {
 
   std::reference_wrapper<BoxElement> createTrack() {
     auto wPimpl = wP.lock();
-    auto nodefactory =
-        CServiceLocatorSingleton::instance().lock()->getService<INodeFactory>().lock();
+    const INodeFactory& nodefactory = wPimpl->m_parserContext->nodeFactory();
 
-    auto moovBoxElements = findAllElementsWithFourccAndBoxType<box::CContainerBox>(
-        *(wPimpl->m_tree), ilo::toFcc("moov"));
+    auto moovBoxElements =
+        findAllElementsWithFourccAndBoxType<box::CContainerBox>(*(wPimpl->m_tree), "moov"_fcc);
     ILO_ASSERT(moovBoxElements.size() == 1, "one and only one moov box should be present");
     BoxElement& moovBoxElement = const_cast<BoxElement&>(moovBoxElements[0].get());
 
-    auto trakBoxElement = nodefactory->createNode(
-        moovBoxElement, box::CContainerBox::SContainerBoxWriteConfig(ilo::toFcc("trak")));
-    CTrakTreeEnhancer{trakBoxElement, m_enhancerConfig};
+    auto trakBoxElement = nodefactory.createNode(
+        moovBoxElement, box::CContainerBox::SContainerBoxWriteConfig("trak"_fcc));
+    CTrakTreeEnhancer{*wPimpl->m_parserContext, trakBoxElement, m_enhancerConfig};
 
     if (wPimpl->m_hasFragments) {
-      auto stblBoxElements = findAllElementsWithFourccAndBoxType<box::CContainerBox>(
-          trakBoxElement, ilo::toFcc("stbl"));
+      auto stblBoxElements =
+          findAllElementsWithFourccAndBoxType<box::CContainerBox>(trakBoxElement, "stbl"_fcc);
       ILO_ASSERT(stblBoxElements.size() == 1,
                  "one and only one stbl box should be present for each trak");
       BoxElement& stblBoxElement = const_cast<BoxElement&>(stblBoxElements[0].get());
 
-      CTrakSampleEnhancer{stblBoxElement};
+      CTrakSampleEnhancer{*wPimpl->m_parserContext, stblBoxElement};
     }
 
     return trakBoxElement;
@@ -170,13 +169,13 @@ struct CTrackWriter::SPimpl {
 template <typename TConfig>
 CTrackWriter::CTrackWriter(std::weak_ptr<CIsobmffWriter::Pimpl> writerPimpl, const TConfig& config)
     : m_pimpl(new SPimpl(config)) {
-  ILO_ASSERT_WITH(config.codingName != ilo::toFcc("0000"), std::invalid_argument,
+  ILO_ASSERT_WITH(config.codingName != "0000"_fcc, std::invalid_argument,
                   "mandatory codingName was not set");
   m_pimpl->wP = writerPimpl;
 
   auto wPimpl = writerPimpl.lock();
   if (wPimpl->m_writeIods) {
-    ILO_ASSERT_WITH(config.codingName == ilo::toFcc("mp4a"), std::invalid_argument,
+    ILO_ASSERT_WITH(config.codingName == "mp4a"_fcc, std::invalid_argument,
                     "the iods box can only be written for mp4a");
   }
 
@@ -255,8 +254,8 @@ template <typename TEnhConfig>
 void setupMpegh(std::weak_ptr<CIsobmffWriter::Pimpl> writerPimpl,
                 std::reference_wrapper<BoxElement> trakBoxElement,
                 const SMpeghTrackConfig& config) {
-  auto stsdBoxElements = findAllElementsWithFourccAndBoxType<box::CSampleDescriptionBox>(
-      trakBoxElement, ilo::toFcc("stsd"));
+  auto stsdBoxElements =
+      findAllElementsWithFourccAndBoxType<box::CSampleDescriptionBox>(trakBoxElement, "stsd"_fcc);
   ILO_ASSERT(stsdBoxElements.size() == 1,
              "one and only one stsd box should be present for each trak");
   BoxElement& stsdBoxElement = const_cast<BoxElement&>(stsdBoxElements[0].get());
@@ -270,10 +269,10 @@ void setupMpegh(std::weak_ptr<CIsobmffWriter::Pimpl> writerPimpl,
   }
   enhConfig.profileAndLevelCompatibleSets = config.profileAndLevelCompatibleSets;
 
-  CMpeghTreeEnhancer{stsdBoxElement, enhConfig};
+  auto wPimpl = writerPimpl.lock();
+  CMpeghTreeEnhancer{*wPimpl->m_parserContext, stsdBoxElement, enhConfig};
 
   // Creates sample tables in moov and fill mvex if necessary
-  auto wPimpl = writerPimpl.lock();
   wPimpl->fillStaticMoovInfo();
 }
 
@@ -308,8 +307,8 @@ CMp4aTrackWriter::CMp4aTrackWriter(std::weak_ptr<CIsobmffWriter::Pimpl> writerPi
     : CTrackWriter(writerPimpl, config) {
   auto trakBoxElement = m_pimpl->createTrack();
 
-  auto stsdBoxElements = findAllElementsWithFourccAndBoxType<box::CSampleDescriptionBox>(
-      trakBoxElement, ilo::toFcc("stsd"));
+  auto stsdBoxElements =
+      findAllElementsWithFourccAndBoxType<box::CSampleDescriptionBox>(trakBoxElement, "stsd"_fcc);
   ILO_ASSERT(stsdBoxElements.size() == 1,
              "one and only one stsd box should be present for each trak");
   BoxElement& stsdBoxElement = const_cast<BoxElement&>(stsdBoxElements[0].get());
@@ -322,9 +321,8 @@ CMp4aTrackWriter::CMp4aTrackWriter(std::weak_ptr<CIsobmffWriter::Pimpl> writerPi
   mp4aEnhancerConfig.decoderConfig =
       ilo::make_unique<config::CMp4aDecoderConfigRecord>(*config.configRecord);
 
-  CMp4aTreeEnhancer{stsdBoxElement, mp4aEnhancerConfig};
-
   auto wPimpl = writerPimpl.lock();
+  CMp4aTreeEnhancer{*wPimpl->m_parserContext, stsdBoxElement, mp4aEnhancerConfig};
 
   if (wPimpl->m_writeIods) {
     wPimpl->m_mp4aTrackIds.push_back(wPimpl->m_nextTrackId - 1);
@@ -341,8 +339,8 @@ CAvcTrackWriter::CAvcTrackWriter(std::weak_ptr<CIsobmffWriter::Pimpl> writerPimp
     : CTrackWriter(writerPimpl, config) {
   auto trakBoxElement = m_pimpl->createTrack();
 
-  auto stsdBoxElements = findAllElementsWithFourccAndBoxType<box::CSampleDescriptionBox>(
-      trakBoxElement, ilo::toFcc("stsd"));
+  auto stsdBoxElements =
+      findAllElementsWithFourccAndBoxType<box::CSampleDescriptionBox>(trakBoxElement, "stsd"_fcc);
   ILO_ASSERT(stsdBoxElements.size() == 1,
              "one and only one stsd box should be present for each trak");
   BoxElement& stsdBoxElement = const_cast<BoxElement&>(stsdBoxElements[0].get());
@@ -357,10 +355,10 @@ CAvcTrackWriter::CAvcTrackWriter(std::weak_ptr<CIsobmffWriter::Pimpl> writerPimp
       ilo::make_unique<config::CAvcDecoderConfigRecord>(*config.configRecord);
   m_decoderConfigRecord = ilo::make_unique<config::CAvcDecoderConfigRecord>(*config.configRecord);
 
-  CAvcTreeEnhancer{stsdBoxElement, avc1EnhancerConfig};
+  auto wPimpl = writerPimpl.lock();
+  CAvcTreeEnhancer{*wPimpl->m_parserContext, stsdBoxElement, avc1EnhancerConfig};
 
   // Creates sample tables in moov and fill mvex if necessary
-  auto wPimpl = writerPimpl.lock();
   wPimpl->fillStaticMoovInfo();
 }
 
@@ -388,8 +386,8 @@ CHevcTrackWriter::CHevcTrackWriter(std::weak_ptr<CIsobmffWriter::Pimpl> writerPi
     : CTrackWriter(writerPimpl, config) {
   auto trakBoxElement = m_pimpl->createTrack();
 
-  auto stsdBoxElements = findAllElementsWithFourccAndBoxType<box::CSampleDescriptionBox>(
-      trakBoxElement, ilo::toFcc("stsd"));
+  auto stsdBoxElements =
+      findAllElementsWithFourccAndBoxType<box::CSampleDescriptionBox>(trakBoxElement, "stsd"_fcc);
   ILO_ASSERT(stsdBoxElements.size() == 1,
              "one and only one stsd box should be present for each trak");
   BoxElement& stsdBoxElement = const_cast<BoxElement&>(stsdBoxElements[0].get());
@@ -404,10 +402,10 @@ CHevcTrackWriter::CHevcTrackWriter(std::weak_ptr<CIsobmffWriter::Pimpl> writerPi
       ilo::make_unique<config::CHevcDecoderConfigRecord>(*config.configRecord);
   m_decoderConfigRecord = ilo::make_unique<config::CHevcDecoderConfigRecord>(*config.configRecord);
 
-  CHevcTreeEnhancer{stsdBoxElement, enhancerConfig};
+  auto wPimpl = writerPimpl.lock();
+  CHevcTreeEnhancer{*wPimpl->m_parserContext, stsdBoxElement, enhancerConfig};
 
   // Creates sample tables in moov and fill mvex if necessary
-  auto wPimpl = writerPimpl.lock();
   wPimpl->fillStaticMoovInfo();
 }
 
@@ -435,8 +433,8 @@ CJxsTrackWriter::CJxsTrackWriter(std::weak_ptr<CIsobmffWriter::Pimpl> writerPimp
     : CTrackWriter(writerPimpl, config) {
   auto trakBoxElement = m_pimpl->createTrack();
 
-  auto stsdBoxElements = findAllElementsWithFourccAndBoxType<box::CSampleDescriptionBox>(
-      trakBoxElement, ilo::toFcc("stsd"));
+  auto stsdBoxElements =
+      findAllElementsWithFourccAndBoxType<box::CSampleDescriptionBox>(trakBoxElement, "stsd"_fcc);
   ILO_ASSERT(stsdBoxElements.size() == 1,
              "one and only one stsd box should be present for each trak");
   BoxElement& stsdBoxElement = const_cast<BoxElement&>(stsdBoxElements[0].get());
@@ -459,9 +457,9 @@ CJxsTrackWriter::CJxsTrackWriter(std::weak_ptr<CIsobmffWriter::Pimpl> writerPimp
   jxsEnhancerConfig.jxsmConfig.width = config.width;
   jxsEnhancerConfig.jxsmConfig.compressorName = config.compressorName;
 
-  CJxsTreeEnhancer{stsdBoxElement, jxsEnhancerConfig};
-
   auto wPimpl = writerPimpl.lock();
+  CJxsTreeEnhancer{*wPimpl->m_parserContext, stsdBoxElement, jxsEnhancerConfig};
+
   wPimpl->fillStaticMoovInfo();
 }
 
@@ -477,8 +475,8 @@ CVvcTrackWriter::CVvcTrackWriter(std::weak_ptr<CIsobmffWriter::Pimpl> writerPimp
     : CTrackWriter(writerPimpl, config) {
   auto trakBoxElement = m_pimpl->createTrack();
 
-  auto stsdBoxElements = findAllElementsWithFourccAndBoxType<box::CSampleDescriptionBox>(
-      trakBoxElement, ilo::toFcc("stsd"));
+  auto stsdBoxElements =
+      findAllElementsWithFourccAndBoxType<box::CSampleDescriptionBox>(trakBoxElement, "stsd"_fcc);
   ILO_ASSERT(stsdBoxElements.size() == 1,
              "one and only one stsd box should be present for each trak");
   BoxElement& stsdBoxElement = const_cast<BoxElement&>(stsdBoxElements[0].get());
@@ -493,10 +491,10 @@ CVvcTrackWriter::CVvcTrackWriter(std::weak_ptr<CIsobmffWriter::Pimpl> writerPimp
       ilo::make_unique<config::CVvcDecoderConfigRecord>(*config.configRecord);
   m_decoderConfigRecord = ilo::make_unique<config::CVvcDecoderConfigRecord>(*config.configRecord);
 
-  CVvcTreeEnhancer{stsdBoxElement, enhancerConfig};
+  auto wPimpl = writerPimpl.lock();
+  CVvcTreeEnhancer{*wPimpl->m_parserContext, stsdBoxElement, enhancerConfig};
 
   // Creates sample tables in moov and fill mvex if necessary
-  auto wPimpl = writerPimpl.lock();
   wPimpl->fillStaticMoovInfo();
 }
 
@@ -91,20 +91,18 @@ amm-info@iis.fraunhofer.de
 // project includes
 #include "traf_sample_enhancer.h"
 #include "service/factory.h"
-#include "service/servicesingleton.h"
+#include "service/parsercontext.h"
 #include "box/containerbox.h"
 
 namespace mmt {
 namespace isobmff {
-CTrafSampleEnhancer::CTrafSampleEnhancer(BoxElement& subTree,
+CTrafSampleEnhancer::CTrafSampleEnhancer(const CParserContext& context, BoxElement& subTree,
                                          const STrafSampleEnhancerConfig& config) {
-  ILO_ASSERT_WITH(subTree.item->type() == ilo::toFcc("traf"), std::invalid_argument,
+  ILO_ASSERT_WITH(subTree.item->type() == "traf"_fcc, std::invalid_argument,
                   "TrafSampleEnhancer: the traf box element was not provided!");
   {
-    setupServicesOnce();
-    auto nodefactory =
-        CServiceLocatorSingleton::instance().lock()->getService<INodeFactory>().lock();
-    nodefactory->createNode(subTree, config.trunConfig);
+    const INodeFactory& nodefactory = context.nodeFactory();
+    nodefactory.createNode(subTree, config.trunConfig);
   }
 }
 }  // namespace isobmff
@@ -103,7 +103,8 @@ struct STrafSampleEnhancerConfig {
 class CTrafSampleEnhancer : public ITreeEnhancer {
  public:
   // Constructor takes the configuration info of the boxes and the tree to be enhaced
-  CTrafSampleEnhancer(BoxElement& subTree, const STrafSampleEnhancerConfig& config);
+  CTrafSampleEnhancer(const CParserContext& context, BoxElement& subTree,
+                      const STrafSampleEnhancerConfig& config);
 };
 }  // namespace isobmff
 }  // namespace mmt
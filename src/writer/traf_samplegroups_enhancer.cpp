@@ -91,23 +91,23 @@ amm-info@iis.fraunhofer.de
 // project includes
 #include "traf_samplegroups_enhancer.h"
 #include "service/factory.h"
-#include "service/servicesingleton.h"
+#include "service/parsercontext.h"
 #include "box/containerbox.h"
 
 namespace mmt {
 namespace isobmff {
-CTrafSampleGroupsEnhancer::CTrafSampleGroupsEnhancer(BoxElement& subTree,
+CTrafSampleGroupsEnhancer::CTrafSampleGroupsEnhancer(const CParserContext& context,
+                                                     BoxElement& subTree,
                                                      const SSampleGroupsEnhancerConfig& config,
                                                      bool defaultSampleGroup) {
-  ILO_ASSERT_WITH(subTree.item->type() == ilo::toFcc("traf"), std::invalid_argument,
+  ILO_ASSERT_WITH(subTree.item->type() == "traf"_fcc, std::invalid_argument,
                   "TrafSampleGroupsEnhancer: the traf box element was not provided!");
 
-  mmt::isobmff::setupServicesOnce();
-  auto nodefactory = CServiceLocatorSingleton::instance().lock()->getService<INodeFactory>().lock();
+  const INodeFactory& nodefactory = context.nodeFactory();
   if (defaultSampleGroup == false) {
-    nodefactory->createNode(subTree, config.sgpdConfig);
+    nodefactory.createNode(subTree, config.sgpdConfig);
   }
-  nodefactory->createNode(subTree, config.sbgpConfig);
+  nodefactory.createNode(subTree, config.sbgpConfig);
 }
 }  // namespace isobmff
 }  // namespace mmt
@@ -96,7 +96,8 @@ namespace mmt {
 namespace isobmff {
 class CTrafSampleGroupsEnhancer : public ITreeEnhancer {
  public:
-  CTrafSampleGroupsEnhancer(BoxElement& subTree, const SSampleGroupsEnhancerConfig& config,
+  CTrafSampleGroupsEnhancer(const CParserContext& context, BoxElement& subTree,
+                            const SSampleGroupsEnhancerConfig& config,
                             bool defaultSampleGroup = false);
 };
 }  // namespace isobmff
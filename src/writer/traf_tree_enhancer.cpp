@@ -91,19 +91,18 @@ amm-info@iis.fraunhofer.de
 // project includes
 #include "traf_tree_enhancer.h"
 #include "service/factory.h"
-#include "service/servicesingleton.h"
+#include "service/parsercontext.h"
 
 namespace mmt {
 namespace isobmff {
-CTrafTreeEnhancer::CTrafTreeEnhancer(BoxElement& subTree, const STrafTreeEnhancerConfig& config) {
-  ILO_ASSERT_WITH(subTree.item->type() == (ilo::toFcc("traf")), std::invalid_argument,
+CTrafTreeEnhancer::CTrafTreeEnhancer(const CParserContext& context, BoxElement& subTree,
+                                     const STrafTreeEnhancerConfig& config) {
+  ILO_ASSERT_WITH(subTree.item->type() == "traf"_fcc, std::invalid_argument,
                   "TrafTreeEnhancer: the traf box element was not provided!");
   {
-    setupServicesOnce();
-    auto nodefactory =
-        CServiceLocatorSingleton::instance().lock()->getService<INodeFactory>().lock();
-    nodefactory->createNode(subTree, config.tfhdConfig);
-    nodefactory->createNode(subTree, config.tfdtConfig);
+    const INodeFactory& nodefactory = context.nodeFactory();
+    nodefactory.createNode(subTree, config.tfhdConfig);
+    nodefactory.createNode(subTree, config.tfdtConfig);
   }
 }
 }  // namespace isobmff
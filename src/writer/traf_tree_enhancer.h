@@ -104,7 +104,8 @@ struct STrafTreeEnhancerConfig {
 class CTrafTreeEnhancer : public ITreeEnhancer {
  public:
   // Constructor takes the configuration info of the boxes and the tree to be enhanced
-  CTrafTreeEnhancer(BoxElement& subTree, const STrafTreeEnhancerConfig& config);
+  CTrafTreeEnhancer(const CParserContext& context, BoxElement& subTree,
+                    const STrafTreeEnhancerConfig& config);
 };
 }  // namespace isobmff
 }  // namespace mmt
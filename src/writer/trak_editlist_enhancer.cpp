@@ -92,13 +92,14 @@ amm-info@iis.fraunhofer.de
 // project includes
 #include "trak_editlist_enhancer.h"
 #include "service/factory.h"
-#include "service/servicesingleton.h"
+#include "service/parsercontext.h"
 #include "box/containerbox.h"
 
 namespace mmt {
 namespace isobmff {
-CTrakEditListEnhancer::CTrakEditListEnhancer(BoxElement& subTree, const SEditList& editList) {
-  ILO_ASSERT_WITH(subTree.item->type() == ilo::toFcc("trak"), std::invalid_argument,
+CTrakEditListEnhancer::CTrakEditListEnhancer(const CParserContext& context, BoxElement& subTree,
+                                             const SEditList& editList) {
+  ILO_ASSERT_WITH(subTree.item->type() == "trak"_fcc, std::invalid_argument,
                   "CTrakEditListEnhancer: the trak box element was not provided!");
 
   box::CEditListBox::SEditListBoxWriteConfig elstConfig;
@@ -121,12 +122,10 @@ CTrakEditListEnhancer::CTrakEditListEnhancer(BoxElement& subTree, const SEditLis
   }
 
   if (elstConfig.entries.size() > 0) {
-    mmt::isobmff::setupServicesOnce();
-    auto nodefactory =
-        CServiceLocatorSingleton::instance().lock()->getService<INodeFactory>().lock();
-    auto edts = nodefactory->createNode(
-        subTree, box::CContainerBox::SContainerBoxWriteConfig(ilo::toFcc("edts")));
-    nodefactory->createNode(edts, elstConfig);
+    const INodeFactory& nodefactory = context.nodeFactory();
+    auto edts =
+        nodefactory.createNode(subTree, box::CContainerBox::SContainerBoxWriteConfig("edts"_fcc));
+    nodefactory.createNode(edts, elstConfig);
   }
 }
 }  // namespace isobmff
@@ -96,7 +96,8 @@ namespace mmt {
 namespace isobmff {
 class CTrakEditListEnhancer : public ITreeEnhancer {
  public:
-  CTrakEditListEnhancer(BoxElement& subTree, const SEditList& editList);
+  CTrakEditListEnhancer(const CParserContext& context, BoxElement& subTree,
+                        const SEditList& editList);
 };
 }  // namespace isobmff
 }  // namespace mmt
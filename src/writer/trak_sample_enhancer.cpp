@@ -91,15 +91,15 @@ amm-info@iis.fraunhofer.de
 // project includes
 #include "trak_sample_enhancer.h"
 #include "service/factory.h"
-#include "service/servicesingleton.h"
+#include "service/parsercontext.h"
 #include "box/containerbox.h"
 
 namespace mmt {
 namespace isobmff {
 // Flat mp4 use-case
-CTrakSampleEnhancer::CTrakSampleEnhancer(BoxElement& subTree,
+CTrakSampleEnhancer::CTrakSampleEnhancer(const CParserContext& context, BoxElement& subTree,
                                          const STrakSampleEnhancerConfig& config) {
-  ILO_ASSERT_WITH(subTree.item->type() == ilo::toFcc("stbl"), std::invalid_argument,
+  ILO_ASSERT_WITH(subTree.item->type() == "stbl"_fcc, std::invalid_argument,
                   "TrakSampleEnhancer: the stbl box element was not provided!");
   ILO_ASSERT_WITH(
       (config.co64Config.chunkOffsets.size() >= 1 && config.stcoConfig.chunkOffsets.size() == 0) ||
@@ -107,41 +107,38 @@ CTrakSampleEnhancer::CTrakSampleEnhancer(BoxElement& subTree,
            config.co64Config.chunkOffsets.size() == 0),
       std::invalid_argument, "only one box of either stco or co64 should be present");
 
-  setupServicesOnce();
-  auto nodefactory = CServiceLocatorSingleton::instance().lock()->getService<INodeFactory>().lock();
-  nodefactory->createNode(subTree, config.sttsConfig);
-  nodefactory->createNode(subTree, config.stscConfig);
-  nodefactory->createNode(subTree, config.stszConfig);
+  const INodeFactory& nodefactory = context.nodeFactory();
+  nodefactory.createNode(subTree, config.sttsConfig);
+  nodefactory.createNode(subTree, config.stscConfig);
+  nodefactory.createNode(subTree, config.stszConfig);
 
   if (config.co64Config.chunkOffsets.size() == 0) {
-    nodefactory->createNode(subTree, config.stcoConfig);
+    nodefactory.createNode(subTree, config.stcoConfig);
   } else {
-    nodefactory->createNode(subTree, config.co64Config);
+    nodefactory.createNode(subTree, config.co64Config);
   }
 
   if (!config.allSamplesSyncSamples) {
-    nodefactory->createNode(subTree, config.stssConfig);
+    nodefactory.createNode(subTree, config.stssConfig);
   }
 
   if (config.cttsConfig.entries.size() > 0) {
-    nodefactory->createNode(subTree, config.cttsConfig);
+    nodefactory.createNode(subTree, config.cttsConfig);
   }
 }
 
 // Fragmented mp4 use-case
-CTrakSampleEnhancer::CTrakSampleEnhancer(BoxElement& subTree) {
-  ILO_ASSERT_WITH(subTree.item->type() == ilo::toFcc("stbl"), std::invalid_argument,
+CTrakSampleEnhancer::CTrakSampleEnhancer(const CParserContext& context, BoxElement& subTree) {
+  ILO_ASSERT_WITH(subTree.item->type() == "stbl"_fcc, std::invalid_argument,
                   "TrakSampleEnhancer: stbl box was not found!");
 
   STrakSampleEnhancerConfig config;
   {
-    setupServicesOnce();
-    auto nodefactory =
-        CServiceLocatorSingleton::instance().lock()->getService<INodeFactory>().lock();
-    nodefactory->createNode(subTree, config.sttsConfig);
-    nodefactory->createNode(subTree, config.stscConfig);
-    nodefactory->createNode(subTree, config.stszConfig);
-    nodefactory->createNode(subTree, config.stcoConfig);
+    const INodeFactory& nodefactory = context.nodeFactory();
+    nodefactory.createNode(subTree, config.sttsConfig);
+    nodefactory.createNode(subTree, config.stscConfig);
+    nodefactory.createNode(subTree, config.stszConfig);
+    nodefactory.createNode(subTree, config.stcoConfig);
 
     // CMAF compliance for fragmented MP4 files
     //  -> SyncSampleTableBox absent if all samples are SyncSamples
@@ -149,7 +146,7 @@ CTrakSampleEnhancer::CTrakSampleEnhancer(BoxElement& subTree) {
     //  -> Stss box shall not contain SyncSample Entries
     // For simplicity, we always create an empty stss and overwrite later
     // with trun
-    nodefactory->createNode(subTree, config.stssConfig);
+    nodefactory.createNode(subTree, config.stssConfig);
   }
 }
 }  // namespace isobmff
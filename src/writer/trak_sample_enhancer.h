@@ -116,9 +116,10 @@ class CTrakSampleEnhancer : public ITreeEnhancer {
  public:
   // Constructor takes the configuration info of the boxes and the tree to be enhaced (flat mp4
   // use-case)
-  CTrakSampleEnhancer(BoxElement& subTree, const STrakSampleEnhancerConfig& config);
+  CTrakSampleEnhancer(const CParserContext& context, BoxElement& subTree,
+                      const STrakSampleEnhancerConfig& config);
   // No config is needed for the fragmented mp4 use-case
-  CTrakSampleEnhancer(BoxElement& subTree);
+  CTrakSampleEnhancer(const CParserContext& context, BoxElement& subTree);
 };
 }  // namespace isobmff
 }  // namespace mmt
@@ -91,22 +91,22 @@ amm-info@iis.fraunhofer.de
 // project includes
 #include "trak_samplegroups_enhancer.h"
 #include "service/factory.h"
-#include "service/servicesingleton.h"
+#include "service/parsercontext.h"
 #include "box/containerbox.h"
 
 namespace mmt {
 namespace isobmff {
-CTrakSampleGroupsEnhancer::CTrakSampleGroupsEnhancer(BoxElement& subTree,
+CTrakSampleGroupsEnhancer::CTrakSampleGroupsEnhancer(const CParserContext& context,
+                                                     BoxElement& subTree,
                                                      const SSampleGroupsEnhancerConfig& config,
                                                      bool defaultSampleGroup) {
-  ILO_ASSERT_WITH(subTree.item->type() == ilo::toFcc("stbl"), std::invalid_argument,
+  ILO_ASSERT_WITH(subTree.item->type() == "stbl"_fcc, std::invalid_argument,
                   "TrakSampleGroupsEnhancer: the stbl box element was not provided!");
 
-  mmt::isobmff::setupServicesOnce();
-  auto nodefactory = CServiceLocatorSingleton::instance().lock()->getService<INodeFactory>().lock();
-  nodefactory->createNode(subTree, config.sgpdConfig);
+  const INodeFactory& nodefactory = context.nodeFactory();
+  nodefactory.createNode(subTree, config.sgpdConfig);
   if (defaultSampleGroup == false) {
-    nodefactory->createNode(subTree, config.sbgpConfig);
+    nodefactory.createNode(subTree, config.sbgpConfig);
   }
 }
 }  // namespace isobmff
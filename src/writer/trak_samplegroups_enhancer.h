@@ -98,7 +98,8 @@ namespace mmt {
 namespace isobmff {
 class CTrakSampleGroupsEnhancer : public ITreeEnhancer {
  public:
-  CTrakSampleGroupsEnhancer(BoxElement& subTree, const SSampleGroupsEnhancerConfig& config,
+  CTrakSampleGroupsEnhancer(const CParserContext& context, BoxElement& subTree,
+                            const SSampleGroupsEnhancerConfig& config,
                             bool defaultSampleGroup = false);
 };
 }  // namespace isobmff
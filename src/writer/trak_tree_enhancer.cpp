@@ -96,48 +96,47 @@ amm-info@iis.fraunhofer.de
 #include "box/smhdbox.h"
 #include "box/vmhdbox.h"
 #include "service/factory.h"
-#include "service/servicesingleton.h"
+#include "service/parsercontext.h"
 
 namespace mmt {
 namespace isobmff {
-CTrakTreeEnhancer::CTrakTreeEnhancer(BoxElement& subTree,
+CTrakTreeEnhancer::CTrakTreeEnhancer(const CParserContext& context, BoxElement& subTree,
                                      const STrakTreeEnhancerConfig& trakconfig) {
-  ILO_ASSERT_WITH(subTree.item->type() == (ilo::toFcc("trak")), std::invalid_argument,
+  ILO_ASSERT_WITH(subTree.item->type() == "trak"_fcc, std::invalid_argument,
                   "TrakTreeEnhancer: the trak box element was not provided!");
 
-  setupServicesOnce();
-  auto nodefactory = CServiceLocatorSingleton::instance().lock()->getService<INodeFactory>().lock();
-  nodefactory->createNode(subTree, trakconfig.tkhdConfig);
-  auto mdia = nodefactory->createNode(
-      subTree, box::CContainerBox::SContainerBoxWriteConfig(ilo::toFcc("mdia")));
-  nodefactory->createNode(mdia, trakconfig.mdhdConfig);
-  nodefactory->createNode(mdia, trakconfig.hdlrConfig);
-  auto minf = nodefactory->createNode(
-      mdia, box::CContainerBox::SContainerBoxWriteConfig(ilo::toFcc("minf")));
-  if (trakconfig.hdlrConfig.handlerType == ilo::toFcc("soun")) {
+  const INodeFactory& nodefactory = context.nodeFactory();
+  nodefactory.createNode(subTree, trakconfig.tkhdConfig);
+  auto mdia =
+      nodefactory.createNode(subTree, box::CContainerBox::SContainerBoxWriteConfig("mdia"_fcc));
+  nodefactory.createNode(mdia, trakconfig.mdhdConfig);
+  nodefactory.createNode(mdia, trakconfig.hdlrConfig);
+  auto minf =
+      nodefactory.createNode(mdia, box::CContainerBox::SContainerBoxWriteConfig("minf"_fcc));
+  if (trakconfig.hdlrConfig.handlerType == "soun"_fcc) {
     box::CSoundMediaHeaderBox::SSmhdBoxWriteConfig smhdConf;
-    nodefactory->createNode(minf, smhdConf);
-  } else if (trakconfig.hdlrConfig.handlerType == ilo::toFcc("vide")) {
+    nodefactory.createNode(minf, smhdConf);
+  } else if (trakconfig.hdlrConfig.handlerType == "vide"_fcc) {
     box::CVideoMediaHeaderBox::SVmhdBoxWriteConfig vmhdConf;
-    nodefactory->createNode(minf, vmhdConf);
-  } else if (trakconfig.hdlrConfig.handlerType == ilo::toFcc("hint")) {
+    nodefactory.createNode(minf, vmhdConf);
+  } else if (trakconfig.hdlrConfig.handlerType == "hint"_fcc) {
     throw std::invalid_argument(
         "'Hmhd' box needed to write 'hint' handler tracks is not implemented yet");
   } else {
     ILO_LOG_WARNING("No media header available for unknown handler type of: %s",
                     ilo::toString(trakconfig.hdlrConfig.type).c_str());
   }
-  auto dinf = nodefactory->createNode(
-      minf, box::CContainerBox::SContainerBoxWriteConfig(ilo::toFcc("dinf")));
-  auto dref = nodefactory->createNode(dinf, trakconfig.drefConfig);
+  auto dinf =
+      nodefactory.createNode(minf, box::CContainerBox::SContainerBoxWriteConfig("dinf"_fcc));
+  auto dref = nodefactory.createNode(dinf, trakconfig.drefConfig);
   if (trakconfig.drefConfig.entryCount > 0) {
-    nodefactory->createNode(dref, trakconfig.urlConfig);
+    nodefactory.createNode(dref, trakconfig.urlConfig);
   }
-  auto stbl = nodefactory->createNode(
-      minf, box::CContainerBox::SContainerBoxWriteConfig(ilo::toFcc("stbl")));
-  nodefactory->createNode(stbl, trakconfig.stsdConfig);
+  auto stbl =
+      nodefactory.createNode(minf, box::CContainerBox::SContainerBoxWriteConfig("stbl"_fcc));
+  nodefactory.createNode(stbl, trakconfig.stsdConfig);
 
-  updateSizeAndReturnElementSize(subTree);
+  updateSizeAndReturnElementSize(subTree, context.registry());
 }
 }  // namespace isobmff
 }  // namespace mmt
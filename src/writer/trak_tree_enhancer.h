@@ -115,7 +115,8 @@ struct STrakTreeEnhancerConfig {
 class CTrakTreeEnhancer : public ITreeEnhancer {
  public:
   // Constructor takes the configuration info of the boxes and the tree to be enhaced
-  CTrakTreeEnhancer(BoxElement& subTree, const STrakTreeEnhancerConfig& trakconfig);
+  CTrakTreeEnhancer(const CParserContext& context, BoxElement& subTree,
+                    const STrakTreeEnhancerConfig& trakconfig);
 };
 }  // namespace isobmff
 }  // namespace mmt
@@ -91,29 +91,28 @@ amm-info@iis.fraunhofer.de
 // Internal headers
 #include "trak_userdata_enhancer.h"
 #include "service/factory.h"
-#include "service/servicesingleton.h"
+#include "service/parsercontext.h"
 #include "box/containerbox.h"
 #include "box/unknownbox.h"
 
 namespace mmt {
 namespace isobmff {
 
-CTrakUserDataEnhancer::CTrakUserDataEnhancer(BoxElement& subTree,
+CTrakUserDataEnhancer::CTrakUserDataEnhancer(const CParserContext& context, BoxElement& subTree,
                                              const std::vector<ilo::ByteBuffer>& udtaEntries) {
   ILO_ASSERT_WITH(
-      subTree.item->type() == ilo::toFcc("trak") || subTree.item->type() == ilo::toFcc("moov"),
+      subTree.item->type() == "trak"_fcc || subTree.item->type() == "moov"_fcc,
       std::invalid_argument,
       "The UserData track enhancer must enhance a 'trak' box but a different one was provided");
 
-  mmt::isobmff::setupServicesOnce();
-  auto nodefactory = CServiceLocatorSingleton::instance().lock()->getService<INodeFactory>().lock();
-  auto udta = nodefactory->createNode(
-      subTree, box::CContainerBox::SContainerBoxWriteConfig(ilo::toFcc("udta")));
+  const INodeFactory& nodefactory = context.nodeFactory();
+  auto udta =
+      nodefactory.createNode(subTree, box::CContainerBox::SContainerBoxWriteConfig("udta"_fcc));
 
   for (const auto& entry : udtaEntries) {
     auto iter = entry.begin();
     auto end = entry.end();
-    nodefactory->createNode(udta, iter, end);
+    nodefactory.createNode(udta, iter, end);
     ILO_ASSERT(iter == end, "Failed to create udta box from user given entries");
   }
 }
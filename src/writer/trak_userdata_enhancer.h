@@ -104,7 +104,8 @@ namespace isobmff {
 // byte buffer. Potentially, it could contain nested boxes (if specified by the application).
 class CTrakUserDataEnhancer : public ITreeEnhancer {
  public:
-  CTrakUserDataEnhancer(BoxElement& subTree, const std::vector<ilo::ByteBuffer>& udtaEntries);
+  CTrakUserDataEnhancer(const CParserContext& context, BoxElement& subTree,
+                        const std::vector<ilo::ByteBuffer>& udtaEntries);
 };
 
 }  // namespace isobmff
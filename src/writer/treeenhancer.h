@@ -94,7 +94,7 @@ amm-info@iis.fraunhofer.de
 // Internal includes
 #include "tree/boxtree.h"
 #include "service/factory.h"
-#include "service/servicesingleton.h"
+#include "service/parsercontext.h"
 
 namespace mmt {
 namespace isobmff {
@@ -103,16 +103,17 @@ struct ITreeEnhancer {
 };
 
 struct CDefaultTreeEnhancer : ITreeEnhancer {
-  CDefaultTreeEnhancer() { setupServicesOnce(); }
+  explicit CDefaultTreeEnhancer(const CParserContext& context) : m_context(context) {}
 
   virtual ~CDefaultTreeEnhancer() {}
 
   std::reference_wrapper<BoxElement> addElement(BoxElement& subTree,
                                                 const BoxWriteConfig& boxWriteConfig) {
-    auto nodefactory =
-        CServiceLocatorSingleton::instance().lock()->getService<INodeFactory>().lock();
-    return nodefactory->createNode(subTree, boxWriteConfig);
+    return m_context.nodeFactory().createNode(subTree, boxWriteConfig);
   }
+
+ protected:
+  const CParserContext& m_context;
 };
 }  // namespace isobmff
 }  // namespace mmt
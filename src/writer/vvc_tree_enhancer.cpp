@@ -97,9 +97,10 @@ amm-info@iis.fraunhofer.de
 
 namespace mmt {
 namespace isobmff {
-CVvcTreeEnhancer::CVvcTreeEnhancer(BoxElement& subTree, const SVvcEnhancerConfig& config)
-    : CDefaultTreeEnhancer() {
-  ILO_ASSERT_WITH(subTree.item->type() == (ilo::toFcc("stsd")), std::invalid_argument,
+CVvcTreeEnhancer::CVvcTreeEnhancer(const CParserContext& context, BoxElement& subTree,
+                                   const SVvcEnhancerConfig& config)
+    : CDefaultTreeEnhancer(context) {
+  ILO_ASSERT_WITH(subTree.item->type() == "stsd"_fcc, std::invalid_argument,
                   "CVvcTreeEnhancer: stsd box was not found!");
 
   const auto& vvcNode = addElement(subTree, config.sampleEntryConfig);
@@ -107,12 +108,12 @@ CVvcTreeEnhancer::CVvcTreeEnhancer(BoxElement& subTree, const SVvcEnhancerConfig
   // HINT: For Vvc the decoder config is mandatory but we are not asserting here on purpose to allow
   // the user to write wrong files if necessary
   if (config.decoderConfig != nullptr) {
-    box::CDecoderConfigurationFullBox::SConfigFullBoxWriteConfig vvcC(ilo::toFcc("vvcC"), 0, 0);
+    box::CDecoderConfigurationFullBox::SConfigFullBoxWriteConfig vvcC("vvcC"_fcc, 0, 0);
     vvcC.decoderConfigRecord.resize(static_cast<size_t>(config.decoderConfig->size()));
     ilo::ByteBuffer::iterator iter = vvcC.decoderConfigRecord.begin();
     config.decoderConfig->write(vvcC.decoderConfigRecord, iter);
     addElement(vvcNode, vvcC);
-    updateSizeAndReturnElementSize(subTree);
+    updateSizeAndReturnElementSize(subTree, context.registry());
   }
 }
 }  // namespace isobmff
@@ -104,17 +104,18 @@ struct SVvcEnhancerConfig {
 };
 
 struct SVvc1EnhancerConfig : SVvcEnhancerConfig {
-  SVvc1EnhancerConfig() : SVvcEnhancerConfig(ilo::toFcc("vvc1")) {}
+  SVvc1EnhancerConfig() : SVvcEnhancerConfig("vvc1"_fcc) {}
 };
 
 struct SVvi1EnhancerConfig : SVvcEnhancerConfig {
-  SVvi1EnhancerConfig() : SVvcEnhancerConfig(ilo::toFcc("vvi1")) {}
+  SVvi1EnhancerConfig() : SVvcEnhancerConfig("vvi1"_fcc) {}
 };
 
 class CVvcTreeEnhancer : public CDefaultTreeEnhancer {
  public:
   // Constructor takes the configuration info of the boxes
-  CVvcTreeEnhancer(BoxElement& subTree, const SVvcEnhancerConfig& config);
+  CVvcTreeEnhancer(const CParserContext& context, BoxElement& subTree,
+                   const SVvcEnhancerConfig& config);
 };
 }  // namespace isobmff
 }  // namespace mmt
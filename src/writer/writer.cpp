@@ -93,7 +93,7 @@ amm-info@iis.fraunhofer.de
 
 // Internal includes
 #include "mmtisobmff/writer/writer.h"
-#include "service/servicesingleton.h"
+#include "service/parsercontext.h"
 #include "writer/writerpimpl.h"
 #include "writer/initsegment_tree_builder.h"
 #include "writer/trak_userdata_enhancer.h"
@@ -110,10 +110,10 @@ SMovieConfig::SMovieConfig(SMovieConfig&& otherConf) {
   sidxConfig = std::move(otherConf.sidxConfig);
   iodsConfig = std::move(otherConf.iodsConfig);
   userData = std::move(otherConf.userData);
+  memoryResource = std::move(otherConf.memoryResource);
 }
 
 CIsobmffWriter::CIsobmffWriter() {
-  setupServicesOnce();
 }
 
 CIsobmffWriter::~CIsobmffWriter() {
@@ -180,19 +180,18 @@ CIsobmffBaseFragWriter::CIsobmffBaseFragWriter(std::unique_ptr<IIsobmffOutput>&&
   initConfig.mvhdConfig.modificationTime = timeNowUtc;
   initConfig.mvhdConfig.nextTrackID = 1;
   initConfig.mvhdConfig.timescale = config.movieTimeScale;
-  CInitSegmentTreeBuilder initSegBuilder(initConfig);
+  auto parserContext = std::make_shared<const CParserContext>(config.memoryResource);
+  CInitSegmentTreeBuilder initSegBuilder(*parserContext, initConfig);
   auto tree = initSegBuilder.build();
 
   if (config.iodsConfig) {
     box::CObjectDescriptorBox::SIodsBoxWriteConfig iodsConfig;
     iodsConfig.audioProfileLevelIndication = config.iodsConfig->audioProfileLevelIndication;
-    auto nodefactory =
-        CServiceLocatorSingleton::instance().lock()->getService<INodeFactory>().lock();
-    nodefactory->createNode((*tree)[1], iodsConfig);
+    parserContext->nodeFactory().createNode((*tree)[1], iodsConfig);
   }
 
   if (config.userData.size() > 0) {
-    CTrakUserDataEnhancer{(*tree)[1], config.userData};
+    CTrakUserDataEnhancer{*parserContext, (*tree)[1], config.userData};
   }
 
   auto sink = ilo::make_unique<CMemorySampleSink>();
@@ -202,6 +201,7 @@ CIsobmffBaseFragWriter::CIsobmffBaseFragWriter(std::unique_ptr<IIsobmffOutput>&&
 
   // Fill pimpl config struct
   Pimpl::SPimplConfig pimplConfig;
+  pimplConfig.parserContext = parserContext;
   pimplConfig.out = std::move(output);
   pimplConfig.tree = std::move(tree);
   pimplConfig.sampleStore = std::move(sampleStore);
@@ -341,19 +341,18 @@ CIsobmffBaseWriter::CIsobmffBaseWriter(const std::string& outUri, const std::str
   initConfig.mvhdConfig.modificationTime = timeNowUtc;
   initConfig.mvhdConfig.nextTrackID = 1;
   initConfig.mvhdConfig.timescale = config.movieTimeScale;
-  CInitSegmentTreeBuilder initSegBuilder(initConfig);
+  auto parserContext = std::make_shared<const CParserContext>(config.memoryResource);
+  CInitSegmentTreeBuilder initSegBuilder(*parserContext, initConfig);
   auto tree = initSegBuilder.build();
 
   if (config.iodsConfig) {
     box::CObjectDescriptorBox::SIodsBoxWriteConfig iodsConfig;
     iodsConfig.audioProfileLevelIndication = config.iodsConfig->audioProfileLevelIndication;
-    auto nodefactory =
-        CServiceLocatorSingleton::instance().lock()->getService<INodeFactory>().lock();
-    nodefactory->createNode((*tree)[1], iodsConfig);
+    parserContext->nodeFactory().createNode((*tree)[1], iodsConfig);
   }
 
   if (config.userData.size() > 0) {
-    CTrakUserDataEnhancer{(*tree)[1], config.userData};
+    CTrakUserDataEnhancer{*parserContext, (*tree)[1], config.userData};
   }
 
   std::unique_ptr<IIsobmffOutput> output;
@@ -380,6 +379,7 @@ CIsobmffBaseWriter::CIsobmffBaseWriter(const std::string& outUri, const std::str
 
   // Fill pimpl config struct
   Pimpl::SPimplConfig pimplConfig;
+  pimplConfig.parserContext = parserContext;
   pimplConfig.out = std::move(output);
   pimplConfig.tree = std::move(tree);
   pimplConfig.sampleStore = std::move(sampleStore);
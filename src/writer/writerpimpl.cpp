@@ -105,7 +105,7 @@ amm-info@iis.fraunhofer.de
 #include "writer/trak_samplegroups_enhancer.h"
 #include "writer/trak_editlist_enhancer.h"
 #include "writer/trak_userdata_enhancer.h"
-#include "service/servicesingleton.h"
+#include "service/parsercontext.h"
 #include "box/trexbox.h"
 #include "box/ftypbox.h"
 #include "box/stypbox.h"
@@ -135,13 +135,13 @@ void CIsobmffWriter::Pimpl::closeAllOutputs() {
 
 void CIsobmffWriter::Pimpl::fillStaticMoovInfo() {
   auto moovBoxElements =
-      findAllElementsWithFourccAndBoxType<box::CContainerBox>(*(m_tree), ilo::toFcc("moov"));
+      findAllElementsWithFourccAndBoxType<box::CContainerBox>(*(m_tree), "moov"_fcc);
   ILO_ASSERT(moovBoxElements.size() == 1, "one and only one moov box should be present");
   BoxElement& moovBoxElement = const_cast<BoxElement&>(moovBoxElements[0].get());
 
   if (m_writeIods) {
-    auto iodsBoxElements = findAllElementsWithFourccAndBoxType<box::CObjectDescriptorBox>(
-        moovBoxElement, ilo::toFcc("iods"));
+    auto iodsBoxElements =
+        findAllElementsWithFourccAndBoxType<box::CObjectDescriptorBox>(moovBoxElement, "iods"_fcc);
     ILO_ASSERT(iodsBoxElements.size() == 1, "one Object Descriptor box should be present");
     BoxElement& iodsBoxElement = const_cast<BoxElement&>(iodsBoxElements[0].get());
     auto iodsBox = std::dynamic_pointer_cast<box::CObjectDescriptorBox>(iodsBoxElement.item);
@@ -151,14 +151,12 @@ void CIsobmffWriter::Pimpl::fillStaticMoovInfo() {
     config.trackIds = m_mp4aTrackIds;
 
     // Replace old iods box with new one
-    auto nodefactory =
-        CServiceLocatorSingleton::instance().lock()->getService<INodeFactory>().lock();
-    nodefactory->replaceNode(iodsBoxElement,
-                             box::CObjectDescriptorBox::SIodsBoxWriteConfig(config));
+    const INodeFactory& nodefactory = m_parserContext->nodeFactory();
+    nodefactory.replaceNode(iodsBoxElement, box::CObjectDescriptorBox::SIodsBoxWriteConfig(config));
   }
 
   auto trakBoxElements =
-      findAllElementsWithFourccAndBoxType<box::CContainerBox>(moovBoxElement, ilo::toFcc("trak"));
+      findAllElementsWithFourccAndBoxType<box::CContainerBox>(moovBoxElement, "trak"_fcc);
   ILO_ASSERT(trakBoxElements.size() >= 1, "one or more trak boxes should be present");
 }
 
@@ -263,37 +261,37 @@ void CIsobmffWriter::Pimpl::createMvexBox() {
   ILO_ASSERT(m_hasFragments, "Mvex/Trex boxes cannot be used for a plain mp4 file");
 
   auto moovBoxElements =
-      findAllElementsWithFourccAndBoxType<box::CContainerBox>(*(m_tree), ilo::toFcc("moov"));
+      findAllElementsWithFourccAndBoxType<box::CContainerBox>(*(m_tree), "moov"_fcc);
   ILO_ASSERT(moovBoxElements.size() == 1, "one and only one moov box should be present");
   BoxElement& moovBoxElement = const_cast<BoxElement&>(moovBoxElements[0].get());
 
   ILO_ASSERT(
-      findAllElementsWithFourccAndBoxType<box::CContainerBox>(moovBoxElement, ilo::toFcc("mvex"))
+      findAllElementsWithFourccAndBoxType<box::CContainerBox>(moovBoxElement, "mvex"_fcc)
           .empty(),
       "Mvex box is already existing.");
 
-  auto nodefactory = CServiceLocatorSingleton::instance().lock()->getService<INodeFactory>().lock();
-  auto mvexBoxElement = nodefactory->createNode(
-      moovBoxElement, box::CContainerBox::SContainerBoxWriteConfig(ilo::toFcc("mvex")));
+  const INodeFactory& nodefactory = m_parserContext->nodeFactory();
+  auto mvexBoxElement = nodefactory.createNode(
+      moovBoxElement, box::CContainerBox::SContainerBoxWriteConfig("mvex"_fcc));
 
   auto trakBoxElements =
-      findAllElementsWithFourccAndBoxType<box::CContainerBox>(moovBoxElement, ilo::toFcc("trak"));
+      findAllElementsWithFourccAndBoxType<box::CContainerBox>(moovBoxElement, "trak"_fcc);
   ILO_ASSERT(trakBoxElements.size() >= 1, "one or more trak boxes must be present");
   for (auto trakBoxElementRef : trakBoxElements) {
     auto tkhdBoxes =
-        findAllBoxesWithFourccAndType<box::CTrackHeaderBox>(trakBoxElementRef, ilo::toFcc("tkhd"));
+        findAllBoxesWithFourccAndType<box::CTrackHeaderBox>(trakBoxElementRef, "tkhd"_fcc);
     ILO_ASSERT(tkhdBoxes.size() == 1, "one and only one tkhd box should be present for each trak");
 
     box::CTrackExtendsBox::STrexBoxWriteConfig trexConfig;
     trexConfig.trackID = tkhdBoxes.at(0)->trackID();
     trexConfig.defaultSampleDescriptionIndex = 1;
 
-    nodefactory->createNode(mvexBoxElement, trexConfig);
+    nodefactory.createNode(mvexBoxElement, trexConfig);
   }
 }
 
 void CIsobmffWriter::Pimpl::createStypBox(ilo::ByteBuffer& stypBuff, const bool& isLastSegment) {
-  auto ftypBoxes = findAllBoxesWithFourccAndType<box::CFileTypeBox>(*m_tree, ilo::toFcc("ftyp"));
+  auto ftypBoxes = findAllBoxesWithFourccAndType<box::CFileTypeBox>(*m_tree, "ftyp"_fcc);
   ILO_ASSERT(ftypBoxes.size() == 1, "one and only one ftyp box should be present");
 
   // Copy ftyp data to styp
@@ -303,7 +301,7 @@ void CIsobmffWriter::Pimpl::createStypBox(ilo::ByteBuffer& stypBuff, const bool&
   stypConfig.compatibleBrands = ftypBoxes.at(0)->compatibleBrands();
 
   if (isLastSegment) {
-    stypConfig.compatibleBrands.push_back(ilo::toFcc("lmsg"));
+    stypConfig.compatibleBrands.push_back("lmsg"_fcc);
   }
 
   // Create styp box and write to tmp buffer
@@ -317,25 +315,25 @@ void CIsobmffWriter::Pimpl::createSidxBox(ilo::ByteBuffer& sidxBuff) {
   box::CSegmentIndexBox::SSidxBoxWriteConfig sidxConfig;
 
   auto moovBoxElements =
-      findAllElementsWithFourccAndBoxType<box::CContainerBox>(*m_tree, ilo::toFcc("moov"));
+      findAllElementsWithFourccAndBoxType<box::CContainerBox>(*m_tree, "moov"_fcc);
   ILO_ASSERT(moovBoxElements.size() == 1, "one and only one moov box should be present");
   BoxElement& moovBoxElement = const_cast<BoxElement&>(moovBoxElements[0].get());
 
   auto trakBoxElements =
-      findAllElementsWithFourccAndBoxType<box::CContainerBox>(moovBoxElement, ilo::toFcc("trak"));
+      findAllElementsWithFourccAndBoxType<box::CContainerBox>(moovBoxElement, "trak"_fcc);
   ILO_ASSERT(trakBoxElements.size() == 1,
              "We currently only support fragmented files with 1 track");
   BoxElement& trakBoxElement = const_cast<BoxElement&>(trakBoxElements[0].get());
 
   auto edtsBoxElements =
-      findAllElementsWithFourccAndBoxType<box::CContainerBox>(trakBoxElement, ilo::toFcc("edts"));
+      findAllElementsWithFourccAndBoxType<box::CContainerBox>(trakBoxElement, "edts"_fcc);
   ILO_ASSERT(edtsBoxElements.size() <= 1, "zero or one edts box should be present");
 
   std::shared_ptr<box::CEditListBox> elstBox;
   if (edtsBoxElements.size() == 1) {
     BoxElement& edtsBoxElement = const_cast<BoxElement&>(edtsBoxElements[0].get());
     auto elstBoxElements =
-        findAllElementsWithFourccAndBoxType<box::CEditListBox>(edtsBoxElement, ilo::toFcc("elst"));
+        findAllElementsWithFourccAndBoxType<box::CEditListBox>(edtsBoxElement, "elst"_fcc);
     BoxElement& elstBoxElement = const_cast<BoxElement&>(elstBoxElements[0].get());
     elstBox = std::dynamic_pointer_cast<box::CEditListBox>(elstBoxElement.item);
 
@@ -345,17 +343,17 @@ void CIsobmffWriter::Pimpl::createSidxBox(ilo::ByteBuffer& sidxBuff) {
   }
 
   auto tkhdBoxElements =
-      findAllElementsWithFourccAndBoxType<box::CTrackHeaderBox>(trakBoxElement, ilo::toFcc("tkhd"));
+      findAllElementsWithFourccAndBoxType<box::CTrackHeaderBox>(trakBoxElement, "tkhd"_fcc);
   BoxElement& tkhdBoxElement = const_cast<BoxElement&>(tkhdBoxElements[0].get());
   auto tkhdBox = std::dynamic_pointer_cast<box::CTrackHeaderBox>(tkhdBoxElement.item);
 
   auto mdiaBoxElements =
-      findAllElementsWithFourccAndBoxType<box::CContainerBox>(trakBoxElement, ilo::toFcc("mdia"));
+      findAllElementsWithFourccAndBoxType<box::CContainerBox>(trakBoxElement, "mdia"_fcc);
   ILO_ASSERT(mdiaBoxElements.size() == 1,
              "one and only one mdia box should be present for each trak");
 
   auto mdhdBoxElements =
-      findAllElementsWithFourccAndBoxType<box::CMediaHeaderBox>(trakBoxElement, ilo::toFcc("mdhd"));
+      findAllElementsWithFourccAndBoxType<box::CMediaHeaderBox>(trakBoxElement, "mdhd"_fcc);
   BoxElement& mdhdBoxElement = const_cast<BoxElement&>(mdhdBoxElements[0].get());
   auto mdhdBox = std::dynamic_pointer_cast<box::CMediaHeaderBox>(mdhdBoxElement.item);
 
@@ -365,17 +363,17 @@ void CIsobmffWriter::Pimpl::createSidxBox(ilo::ByteBuffer& sidxBuff) {
 
   for (const auto& fragTree : m_fragTrees) {
     auto moofBoxElements =
-        findAllElementsWithFourccAndBoxType<box::CContainerBox>(*fragTree, ilo::toFcc("moof"));
+        findAllElementsWithFourccAndBoxType<box::CContainerBox>(*fragTree, "moof"_fcc);
     BoxElement& moofBoxElement = const_cast<BoxElement&>(moofBoxElements[0].get());
 
     auto trafBoxElements =
-        findAllElementsWithFourccAndBoxType<box::CContainerBox>(moofBoxElement, ilo::toFcc("traf"));
+        findAllElementsWithFourccAndBoxType<box::CContainerBox>(moofBoxElement, "traf"_fcc);
     ILO_ASSERT(trafBoxElements.size() == 1,
                "We currently only support fragmented files with 1 track");
     BoxElement& trafBoxElement = const_cast<BoxElement&>(trafBoxElements[0].get());
 
     auto trunBoxElements =
-        findAllElementsWithFourccAndBoxType<box::CTrackRunBox>(trafBoxElement, ilo::toFcc("trun"));
+        findAllElementsWithFourccAndBoxType<box::CTrackRunBox>(trafBoxElement, "trun"_fcc);
     BoxElement& trunBoxElement = const_cast<BoxElement&>(trunBoxElements[0].get());
     auto trunBox = std::dynamic_pointer_cast<box::CTrackRunBox>(trunBoxElement.item);
 
@@ -405,7 +403,8 @@ void CIsobmffWriter::Pimpl::createSidxBox(ilo::ByteBuffer& sidxBuff) {
     box::CSegmentIndexBox::SSidxReference reference;
 
     reference.referenceType = 0;
-    reference.referenceSize = static_cast<uint32_t>(updateSizeAndReturnTotalSize(*fragTree));
+    reference.referenceSize = static_cast<uint32_t>(
+        updateSizeAndReturnTotalSize(*fragTree, m_parserContext->registry()));
 
     // startsWithSap is true when sample with earliest presentation time is a sync Sample
     reference.startsWithSap = (sapFound && (curFragEarliestPts == ptsFirstSap)) ? true : false;
@@ -490,26 +489,26 @@ void CIsobmffWriter::Pimpl::createInitFragment(std::unique_ptr<IIsobmffOutput>&&
   // Add default Sample Group description box (if avaialble)
   if (!m_defaultSampleGroupInfoMap.empty()) {
     auto moovBoxElements =
-        findAllElementsWithFourccAndBoxType<box::CContainerBox>(*m_tree, ilo::toFcc("moov"));
+        findAllElementsWithFourccAndBoxType<box::CContainerBox>(*m_tree, "moov"_fcc);
     ILO_ASSERT(moovBoxElements.size() == 1, "one and only one moov box should be present");
     BoxElement& moovBoxElement = const_cast<BoxElement&>(moovBoxElements[0].get());
 
     auto trakBoxElements =
-        findAllElementsWithFourccAndBoxType<box::CContainerBox>(moovBoxElement, ilo::toFcc("trak"));
+        findAllElementsWithFourccAndBoxType<box::CContainerBox>(moovBoxElement, "trak"_fcc);
     ILO_ASSERT(trakBoxElements.size() >= 1, "one or more trak boxes should be present");
     for (auto trakBoxElementRef : trakBoxElements) {
       BoxElement& trakBoxElement = const_cast<BoxElement&>(trakBoxElementRef.get());
 
-      auto tkhdBoxElements = findAllElementsWithFourccAndBoxType<box::CTrackHeaderBox>(
-          trakBoxElement, ilo::toFcc("tkhd"));
+      auto tkhdBoxElements =
+          findAllElementsWithFourccAndBoxType<box::CTrackHeaderBox>(trakBoxElement, "tkhd"_fcc);
       BoxElement& tkhdBoxElement = const_cast<BoxElement&>(tkhdBoxElements[0].get());
       auto tkhdBox = std::dynamic_pointer_cast<box::CTrackHeaderBox>(tkhdBoxElement.item);
 
       // Enhance only the 'trak' box of the right track
       if (m_defaultSampleGroupInfoMap.find(tkhdBox->trackID()) !=
           m_defaultSampleGroupInfoMap.end()) {
-        auto stblBoxElements = findAllElementsWithFourccAndBoxType<box::CContainerBox>(
-            trakBoxElement, ilo::toFcc("stbl"));
+        auto stblBoxElements =
+            findAllElementsWithFourccAndBoxType<box::CContainerBox>(trakBoxElement, "stbl"_fcc);
         ILO_ASSERT(stblBoxElements.size() == 1,
                    "one and only one stbl box should be present for each trak");
         BoxElement& stblBoxElement = const_cast<BoxElement&>(stblBoxElements[0].get());
@@ -520,15 +519,18 @@ void CIsobmffWriter::Pimpl::createInitFragment(std::unique_ptr<IIsobmffOutput>&&
         updateEntries(config);
 
         if (config.prolConfig.boxesConfig.sgpdConfig.sampleGroupDescriptionEntries.size() != 0) {
-          CTrakSampleGroupsEnhancer{stblBoxElement, config.prolConfig.boxesConfig, true};
+          CTrakSampleGroupsEnhancer{*m_parserContext, stblBoxElement, config.prolConfig.boxesConfig,
+                                    true};
         }
 
         if (config.rollConfig.boxesConfig.sgpdConfig.sampleGroupDescriptionEntries.size() != 0) {
-          CTrakSampleGroupsEnhancer{stblBoxElement, config.rollConfig.boxesConfig, true};
+          CTrakSampleGroupsEnhancer{*m_parserContext, stblBoxElement, config.rollConfig.boxesConfig,
+                                    true};
         }
 
         if (config.sapConfig.boxesConfig.sgpdConfig.sampleGroupDescriptionEntries.size() != 0) {
-          CTrakSampleGroupsEnhancer{stblBoxElement, config.sapConfig.boxesConfig, true};
+          CTrakSampleGroupsEnhancer{*m_parserContext, stblBoxElement, config.sapConfig.boxesConfig,
+                                    true};
         }
       }
     }
@@ -536,7 +538,7 @@ void CIsobmffWriter::Pimpl::createInitFragment(std::unique_ptr<IIsobmffOutput>&&
 
   createMvexBox();
 
-  uint64_t treeSize = updateSizeAndReturnTotalSize(*m_tree);
+  uint64_t treeSize = updateSizeAndReturnTotalSize(*m_tree, m_parserContext->registry());
   ilo::ByteBuffer buff(static_cast<size_t>(treeSize));
   ilo::ByteBuffer::iterator iter = buff.begin();
   ilo::ByteBuffer::const_iterator begConst = buff.begin();
@@ -595,9 +597,9 @@ void CIsobmffWriter::Pimpl::createFragment(const std::vector<CMetaSample>& metaD
   SMediaFragmentTreeConfig fragConfig;
   fragConfig.mfhdConfig.sequenceNumber = metaDataSamples.at(0).fragmentNumber;
 
-  CMediaFragmentTreeBuilder mediaFragTreeBuilder(fragConfig);
+  CMediaFragmentTreeBuilder mediaFragTreeBuilder(*m_parserContext, fragConfig);
   auto fragTree = mediaFragTreeBuilder.build();
-  auto nodefactory = CServiceLocatorSingleton::instance().lock()->getService<INodeFactory>().lock();
+  const INodeFactory& nodefactory = m_parserContext->nodeFactory();
 
   size_t index = 0;
   while (index < metaDataSamples.size()) {
@@ -606,8 +608,8 @@ void CIsobmffWriter::Pimpl::createFragment(const std::vector<CMetaSample>& metaD
       m_baseMediaDecodeTime.insert(std::make_pair(metaDataSamples[index].trackId, 0U));
     }
 
-    auto trafBoxElement = nodefactory->createNode(
-        (*fragTree)[0], box::CContainerBox::SContainerBoxWriteConfig(ilo::toFcc("traf")));
+    auto trafBoxElement = nodefactory.createNode(
+        (*fragTree)[0], box::CContainerBox::SContainerBoxWriteConfig("traf"_fcc));
 
     STrafTreeEnhancerConfig trafTreeConfig;
     trafTreeConfig.tfhdConfig.trackId = metaDataSamples[index].trackId;
@@ -730,25 +732,25 @@ void CIsobmffWriter::Pimpl::createFragment(const std::vector<CMetaSample>& metaD
       sampleConfig.trunConfig.firstSampleFlagsPresent = false;
     }
 
-    CTrafTreeEnhancer{trafBoxElement, trafTreeConfig};
-    CTrafSampleEnhancer{trafBoxElement, sampleConfig};
+    CTrafTreeEnhancer{*m_parserContext, trafBoxElement, trafTreeConfig};
+    CTrafSampleEnhancer{*m_parserContext, trafBoxElement, sampleConfig};
 
     if (sampleGroupsConfig.prolConfig.boxesConfig.sgpdConfig.sampleGroupDescriptionEntries.size() !=
         0) {
-      CTrafSampleGroupsEnhancer{trafBoxElement, sampleGroupsConfig.prolConfig.boxesConfig,
-                                defaultSampleGroupsFlag};
+      CTrafSampleGroupsEnhancer{*m_parserContext, trafBoxElement,
+                                sampleGroupsConfig.prolConfig.boxesConfig, defaultSampleGroupsFlag};
     }
 
     if (sampleGroupsConfig.rollConfig.boxesConfig.sgpdConfig.sampleGroupDescriptionEntries.size() !=
         0) {
-      CTrafSampleGroupsEnhancer{trafBoxElement, sampleGroupsConfig.rollConfig.boxesConfig,
-                                defaultSampleGroupsFlag};
+      CTrafSampleGroupsEnhancer{*m_parserContext, trafBoxElement,
+                                sampleGroupsConfig.rollConfig.boxesConfig, defaultSampleGroupsFlag};
     }
 
     if (sampleGroupsConfig.sapConfig.boxesConfig.sgpdConfig.sampleGroupDescriptionEntries.size() !=
         0) {
-      CTrafSampleGroupsEnhancer{trafBoxElement, sampleGroupsConfig.sapConfig.boxesConfig,
-                                defaultSampleGroupsFlag};
+      CTrafSampleGroupsEnhancer{*m_parserContext, trafBoxElement,
+                                sampleGroupsConfig.sapConfig.boxesConfig, defaultSampleGroupsFlag};
     }
 
     if (index < metaDataSamples.size() &&
@@ -761,9 +763,9 @@ void CIsobmffWriter::Pimpl::createFragment(const std::vector<CMetaSample>& metaD
   auto storedSamples = m_sampleStore->storedSamples(0, fragConfig.mfhdConfig.sequenceNumber);
   box::CMediaDataBox::SMdatBoxWriteConfig mdatConfig;
   mdatConfig.payloadSize = storedSamples->size();
-  nodefactory->createNode(*fragTree, mdatConfig);
+  nodefactory.createNode(*fragTree, mdatConfig);
 
-  uint64_t treeSize = updateSizeAndReturnTotalSize(*fragTree);
+  uint64_t treeSize = updateSizeAndReturnTotalSize(*fragTree, m_parserContext->registry());
   uint32_t treeSizeNoPayload = static_cast<uint32_t>(treeSize - storedSamples->size());
   updateTrunDataOffset(*fragTree, treeSizeNoPayload);
   ilo::ByteBuffer buff(static_cast<size_t>(treeSizeNoPayload));  // Hint: Exclude the mdat payload!
@@ -795,23 +797,23 @@ void CIsobmffWriter::Pimpl::finishNonFragmentedFile(const size_t maxChunkSize) {
   MetaSampleVec sampleMetaDataVec;
 
   auto moovBoxElements =
-      findAllElementsWithFourccAndBoxType<box::CContainerBox>(*m_tree, ilo::toFcc("moov"));
+      findAllElementsWithFourccAndBoxType<box::CContainerBox>(*m_tree, "moov"_fcc);
   ILO_ASSERT(moovBoxElements.size() == 1, "one and only one moov box should be present");
   BoxElement& moovBoxElement = const_cast<BoxElement&>(moovBoxElements[0].get());
 
   auto trakBoxElements =
-      findAllElementsWithFourccAndBoxType<box::CContainerBox>(moovBoxElement, ilo::toFcc("trak"));
+      findAllElementsWithFourccAndBoxType<box::CContainerBox>(moovBoxElement, "trak"_fcc);
   ILO_ASSERT(trakBoxElements.size() >= 1, "one or more trak boxes should be present");
   for (auto trakBoxElementRef : trakBoxElements) {
     BoxElement& trakBoxElement = const_cast<BoxElement&>(trakBoxElementRef.get());
 
-    auto tkhdBoxElements = findAllElementsWithFourccAndBoxType<box::CTrackHeaderBox>(
-        trakBoxElement, ilo::toFcc("tkhd"));
+    auto tkhdBoxElements =
+        findAllElementsWithFourccAndBoxType<box::CTrackHeaderBox>(trakBoxElement, "tkhd"_fcc);
     BoxElement& tkhdBoxElement = const_cast<BoxElement&>(tkhdBoxElements[0].get());
     auto tkhdBox = std::dynamic_pointer_cast<box::CTrackHeaderBox>(tkhdBoxElement.item);
 
     auto stblBoxElements =
-        findAllElementsWithFourccAndBoxType<box::CContainerBox>(trakBoxElement, ilo::toFcc("stbl"));
+        findAllElementsWithFourccAndBoxType<box::CContainerBox>(trakBoxElement, "stbl"_fcc);
     ILO_ASSERT(stblBoxElements.size() == 1,
                "one and only one stbl box should be present for each trak");
     BoxElement& stblBoxElement = const_cast<BoxElement&>(stblBoxElements[0].get());
@@ -820,30 +822,33 @@ void CIsobmffWriter::Pimpl::finishNonFragmentedFile(const size_t maxChunkSize) {
     STrakEnhancersConfig config(1, 0);
     fillTrakEnhancersConfigs(config, sampleMetaDataVec, tkhdBox->trackID());
 
-    CTrakSampleEnhancer{stblBoxElement, config.trakSampleEnhancerConfig};
+    CTrakSampleEnhancer{*m_parserContext, stblBoxElement, config.trakSampleEnhancerConfig};
     if (config.sampleGroupsConfig.prolConfig.boxesConfig.sgpdConfig.sampleGroupDescriptionEntries
             .size() != 0) {
-      CTrakSampleGroupsEnhancer{stblBoxElement, config.sampleGroupsConfig.prolConfig.boxesConfig};
+      CTrakSampleGroupsEnhancer{*m_parserContext, stblBoxElement,
+                                config.sampleGroupsConfig.prolConfig.boxesConfig};
     }
 
     if (config.sampleGroupsConfig.rollConfig.boxesConfig.sgpdConfig.sampleGroupDescriptionEntries
             .size() != 0) {
-      CTrakSampleGroupsEnhancer{stblBoxElement, config.sampleGroupsConfig.rollConfig.boxesConfig};
+      CTrakSampleGroupsEnhancer{*m_parserContext, stblBoxElement,
+                                config.sampleGroupsConfig.rollConfig.boxesConfig};
     }
 
     if (config.sampleGroupsConfig.sapConfig.boxesConfig.sgpdConfig.sampleGroupDescriptionEntries
             .size() != 0) {
-      CTrakSampleGroupsEnhancer{stblBoxElement, config.sampleGroupsConfig.sapConfig.boxesConfig};
+      CTrakSampleGroupsEnhancer{*m_parserContext, stblBoxElement,
+                                config.sampleGroupsConfig.sapConfig.boxesConfig};
     }
 
     auto iter = m_editListMap.find(tkhdBox->trackID());
     if (iter != m_editListMap.end()) {
-      CTrakEditListEnhancer{trakBoxElement, iter->second};
+      CTrakEditListEnhancer{*m_parserContext, trakBoxElement, iter->second};
     }
 
     auto iter2 = m_userDataMap.find(tkhdBox->trackID());
     if (iter2 != m_userDataMap.end()) {
-      CTrakUserDataEnhancer{trakBoxElement, iter2->second};
+      CTrakUserDataEnhancer{*m_parserContext, trakBoxElement, iter2->second};
     }
   }
   // write file
@@ -852,14 +857,13 @@ void CIsobmffWriter::Pimpl::finishNonFragmentedFile(const size_t maxChunkSize) {
   mdatConfig.payloadSize = m_sampleStore->getStoreSize();
 
   {
-    auto nodefactory =
-        CServiceLocatorSingleton::instance().lock()->getService<INodeFactory>().lock();
-    nodefactory->createNode(*m_tree, mdatConfig);
+    const INodeFactory& nodefactory = m_parserContext->nodeFactory();
+    nodefactory.createNode(*m_tree, mdatConfig);
   }
 
   updateNextTrackId();
   updateDurationsInTree(sampleMetaDataVec);
-  uint64_t treeSize = updateSizeAndReturnTotalSize(*m_tree);
+  uint64_t treeSize = updateSizeAndReturnTotalSize(*m_tree, m_parserContext->registry());
   uint32_t treeSizeNoPayload = static_cast<uint32_t>(treeSize - m_sampleStore->getStoreSize());
 
   updateChunkOffsets(trakBoxElements, treeSizeNoPayload);
@@ -886,7 +890,7 @@ void CIsobmffWriter::Pimpl::overwriteBaseMediaDecodeTime(uint32_t trackId, uint6
 
 void CIsobmffWriter::Pimpl::updateNextTrackId() {
   auto mvhdBoxElements =
-      findAllElementsWithFourccAndBoxType<box::CMovieHeaderBox>(*m_tree, ilo::toFcc("mvhd"));
+      findAllElementsWithFourccAndBoxType<box::CMovieHeaderBox>(*m_tree, "mvhd"_fcc);
   ILO_ASSERT(mvhdBoxElements.size() == 1, "one and only one mvhd box should be present");
 
   BoxElement& mvhdBoxElement = const_cast<BoxElement&>(mvhdBoxElements[0].get());
@@ -897,8 +901,8 @@ void CIsobmffWriter::Pimpl::updateNextTrackId() {
   config.nextTrackID = m_nextTrackId;
 
   // Replace old mvhd box with new one
-  auto nodefactory = CServiceLocatorSingleton::instance().lock()->getService<INodeFactory>().lock();
-  nodefactory->replaceNode(mvhdBoxElement, box::CMovieHeaderBox::SMvhdBoxWriteConfig(config));
+  const INodeFactory& nodefactory = m_parserContext->nodeFactory();
+  nodefactory.replaceNode(mvhdBoxElement, box::CMovieHeaderBox::SMvhdBoxWriteConfig(config));
 }
 
 box::CTrackRunBox::STrunBoxWriteConfig CIsobmffWriter::Pimpl::createTrunConfig(
@@ -983,7 +987,7 @@ box::CObjectDescriptorBox::SIodsBoxWriteConfig CIsobmffWriter::Pimpl::createIods
 void CIsobmffWriter::Pimpl::updateTrunDataOffset(BoxTree::NodeType& subTree,
                                                  const uint32_t& dataOffset) {
   auto trunBoxElements =
-      findAllElementsWithFourccAndBoxType<box::CTrackRunBox>(subTree, ilo::toFcc("trun"));
+      findAllElementsWithFourccAndBoxType<box::CTrackRunBox>(subTree, "trun"_fcc);
 
   for (auto& trunBoxElementPointer : trunBoxElements) {
     BoxElement& trunBoxElement = const_cast<BoxElement&>(trunBoxElementPointer.get());
@@ -997,9 +1001,8 @@ void CIsobmffWriter::Pimpl::updateTrunDataOffset(BoxTree::NodeType& subTree,
     trunConfig.dataoffset = static_cast<int32_t>(dataOffset);
 
     // Replace old trun box with new one
-    auto nodefactory =
-        CServiceLocatorSingleton::instance().lock()->getService<INodeFactory>().lock();
-    nodefactory->replaceNode(trunBoxElement, box::CTrackRunBox::STrunBoxWriteConfig(trunConfig));
+    const INodeFactory& nodefactory = m_parserContext->nodeFactory();
+    nodefactory.replaceNode(trunBoxElement, box::CTrackRunBox::STrunBoxWriteConfig(trunConfig));
   }
 }
 
@@ -1010,21 +1013,21 @@ void CIsobmffWriter::Pimpl::updateChunkOffsets(
     BoxElement& trakBoxElement = const_cast<BoxElement&>(trakBoxElementRef.get());
 
     auto stblBoxElements =
-        findAllElementsWithFourccAndBoxType<box::CContainerBox>(trakBoxElement, ilo::toFcc("stbl"));
+        findAllElementsWithFourccAndBoxType<box::CContainerBox>(trakBoxElement, "stbl"_fcc);
     ILO_ASSERT(stblBoxElements.size() == 1,
                "one and only one stbl box should be present for each trak");
     BoxElement& stblBoxElement = const_cast<BoxElement&>(stblBoxElements[0].get());
 
-    auto stcoBoxElements = findAllElementsWithFourccAndBoxType<box::CChunkOffsetBox>(
-        stblBoxElement, ilo::toFcc("stco"));
-    auto co64BoxElements = findAllElementsWithFourccAndBoxType<box::CChunkOffset64Box>(
-        stblBoxElement, ilo::toFcc("co64"));
+    auto stcoBoxElements =
+        findAllElementsWithFourccAndBoxType<box::CChunkOffsetBox>(stblBoxElement, "stco"_fcc);
+    auto co64BoxElements =
+        findAllElementsWithFourccAndBoxType<box::CChunkOffset64Box>(stblBoxElement, "co64"_fcc);
     ILO_ASSERT((stcoBoxElements.size() >= 1 && co64BoxElements.size() == 0) ||
                    (co64BoxElements.size() >= 1 && stcoBoxElements.size() == 0),
                "only one box of either stco or co64 should be present");
     if (stcoBoxElements.size() == 0) {
       BoxElement& co64BoxElement = const_cast<BoxElement&>(co64BoxElements[0].get());
-      auto co64Box = std::dynamic_pointer_cast<box::CChunkOffset64Box>(co64BoxElement.item);
+      auto co64Box = box::boxCast<box::CChunkOffset64Box>(co64BoxElement.item);
       ILO_ASSERT(co64Box != nullptr, "Casting to CChunkOffset64Box failed, wrong type.");
 
       // Create config from existing co64 box
@@ -1036,13 +1039,12 @@ void CIsobmffWriter::Pimpl::updateChunkOffsets(
                     [&offset](uint64_t& chunkOffset) { chunkOffset += offset; });
 
       // Replace old co64 box with new one
-      auto nodefactory =
-          CServiceLocatorSingleton::instance().lock()->getService<INodeFactory>().lock();
-      nodefactory->replaceNode(co64BoxElement,
-                               box::CChunkOffset64Box::SCo64BoxWriteConfig(co64Config));
+      const INodeFactory& nodefactory = m_parserContext->nodeFactory();
+      nodefactory.replaceNode(co64BoxElement,
+                              box::CChunkOffset64Box::SCo64BoxWriteConfig(co64Config));
     } else {
       BoxElement& stcoBoxElement = const_cast<BoxElement&>(stcoBoxElements[0].get());
-      auto stcoBox = std::dynamic_pointer_cast<box::CChunkOffsetBox>(stcoBoxElement.item);
+      auto stcoBox = box::boxCast<box::CChunkOffsetBox>(stcoBoxElement.item);
       ILO_ASSERT(stcoBox != nullptr, "Casting to CChunkOffsetBox failed, wrong type.");
 
       // Create config from existing stco box
@@ -1054,10 +1056,9 @@ void CIsobmffWriter::Pimpl::updateChunkOffsets(
                     [&offset](uint32_t& chunkOffset) { chunkOffset += offset; });
 
       // Replace old co64 box with new one
-      auto nodefactory =
-          CServiceLocatorSingleton::instance().lock()->getService<INodeFactory>().lock();
-      nodefactory->replaceNode(stcoBoxElement,
-                               box::CChunkOffsetBox::SStcoBoxWriteConfig(stcoConfig));
+      const INodeFactory& nodefactory = m_parserContext->nodeFactory();
+      nodefactory.replaceNode(stcoBoxElement,
+                              box::CChunkOffsetBox::SStcoBoxWriteConfig(stcoConfig));
     }
   }
 }
@@ -1118,51 +1119,51 @@ void CIsobmffWriter::Pimpl::updateDurationsInTree(const MetaSampleVec& sampleMet
   uint64_t longestTrackTimescale = 0;
 
   auto moovBoxElements =
-      findAllElementsWithFourccAndBoxType<box::CContainerBox>(*m_tree, ilo::toFcc("moov"));
+      findAllElementsWithFourccAndBoxType<box::CContainerBox>(*m_tree, "moov"_fcc);
   ILO_ASSERT(moovBoxElements.size() == 1, "one and only one moov box should be present");
   BoxElement& moovBoxElement = const_cast<BoxElement&>(moovBoxElements[0].get());
 
   auto mvhdBoxElements =
-      findAllElementsWithFourccAndBoxType<box::CMovieHeaderBox>(*m_tree, ilo::toFcc("mvhd"));
+      findAllElementsWithFourccAndBoxType<box::CMovieHeaderBox>(*m_tree, "mvhd"_fcc);
   ILO_ASSERT(mvhdBoxElements.size() == 1, "one and only one mvhd box should be present");
 
   BoxElement& mvhdBoxElement = const_cast<BoxElement&>(mvhdBoxElements[0].get());
   auto mvhdBox = std::dynamic_pointer_cast<box::CMovieHeaderBox>(mvhdBoxElement.item);
 
   auto trakBoxElements =
-      findAllElementsWithFourccAndBoxType<box::CContainerBox>(moovBoxElement, ilo::toFcc("trak"));
+      findAllElementsWithFourccAndBoxType<box::CContainerBox>(moovBoxElement, "trak"_fcc);
   ILO_ASSERT(trakBoxElements.size() >= 1, "one or more trak boxes should be present");
 
-  auto nodefactory = CServiceLocatorSingleton::instance().lock()->getService<INodeFactory>().lock();
+  const INodeFactory& nodefactory = m_parserContext->nodeFactory();
 
   for (auto trakBoxElementRef : trakBoxElements) {
     BoxElement& trakBoxElement = const_cast<BoxElement&>(trakBoxElementRef.get());
 
     auto edtsBoxElements =
-        findAllElementsWithFourccAndBoxType<box::CContainerBox>(trakBoxElement, ilo::toFcc("edts"));
+        findAllElementsWithFourccAndBoxType<box::CContainerBox>(trakBoxElement, "edts"_fcc);
     ILO_ASSERT(edtsBoxElements.size() <= 1, "zero or one edts box should be present");
 
     std::shared_ptr<box::CEditListBox> elstBox;
     if (edtsBoxElements.size() == 1) {
       BoxElement& edtsBoxElement = const_cast<BoxElement&>(edtsBoxElements[0].get());
-      auto elstBoxElements = findAllElementsWithFourccAndBoxType<box::CEditListBox>(
-          edtsBoxElement, ilo::toFcc("elst"));
+      auto elstBoxElements =
+          findAllElementsWithFourccAndBoxType<box::CEditListBox>(edtsBoxElement, "elst"_fcc);
       BoxElement& elstBoxElement = const_cast<BoxElement&>(elstBoxElements[0].get());
       elstBox = std::dynamic_pointer_cast<box::CEditListBox>(elstBoxElement.item);
     }
 
-    auto tkhdBoxElements = findAllElementsWithFourccAndBoxType<box::CTrackHeaderBox>(
-        trakBoxElement, ilo::toFcc("tkhd"));
+    auto tkhdBoxElements =
+        findAllElementsWithFourccAndBoxType<box::CTrackHeaderBox>(trakBoxElement, "tkhd"_fcc);
     BoxElement& tkhdBoxElement = const_cast<BoxElement&>(tkhdBoxElements[0].get());
     auto tkhdBox = std::dynamic_pointer_cast<box::CTrackHeaderBox>(tkhdBoxElement.item);
 
     auto mdiaBoxElements =
-        findAllElementsWithFourccAndBoxType<box::CContainerBox>(trakBoxElement, ilo::toFcc("mdia"));
+        findAllElementsWithFourccAndBoxType<box::CContainerBox>(trakBoxElement, "mdia"_fcc);
     ILO_ASSERT(mdiaBoxElements.size() == 1,
                "one and only one mdia box should be present for each trak");
 
-    auto mdhdBoxElements = findAllElementsWithFourccAndBoxType<box::CMediaHeaderBox>(
-        trakBoxElement, ilo::toFcc("mdhd"));
+    auto mdhdBoxElements =
+        findAllElementsWithFourccAndBoxType<box::CMediaHeaderBox>(trakBoxElement, "mdhd"_fcc);
     BoxElement& mdhdBoxElement = const_cast<BoxElement&>(mdhdBoxElements[0].get());
     auto mdhdBox = std::dynamic_pointer_cast<box::CMediaHeaderBox>(mdhdBoxElement.item);
 
@@ -1181,14 +1182,14 @@ void CIsobmffWriter::Pimpl::updateDurationsInTree(const MetaSampleVec& sampleMet
     }
 
     // Replace old tkhd box with the new one
-    nodefactory->replaceNode(tkhdBoxElement, box::CTrackHeaderBox::STkhdBoxWriteConfig(tkhdConfig));
+    nodefactory.replaceNode(tkhdBoxElement, box::CTrackHeaderBox::STkhdBoxWriteConfig(tkhdConfig));
 
     // Create mdhd config from existing box and set new duration
     auto mdhdConfig = createMdhdConfig(mdhdBox);
     mdhdConfig.duration = tracksDuration[tkhdBox->trackID()];
 
     // Replace old mdhd box with the new one
-    nodefactory->replaceNode(mdhdBoxElement, box::CMediaHeaderBox::SMdhdBoxWriteConfig(mdhdConfig));
+    nodefactory.replaceNode(mdhdBoxElement, box::CMediaHeaderBox::SMdhdBoxWriteConfig(mdhdConfig));
 
     // Store the timescale of the longest track
     if (tracksDuration.at(tkhdBox->trackID()) == longestTrack) {
@@ -1207,7 +1208,7 @@ void CIsobmffWriter::Pimpl::updateDurationsInTree(const MetaSampleVec& sampleMet
       std::floor(longestTrack * mvhdBox->timescale() / longestTrackTimescale));
 
   // Replace old mdhd box with the new one
-  nodefactory->replaceNode(mvhdBoxElement, box::CMovieHeaderBox::SMvhdBoxWriteConfig(mvhdConfig));
+  nodefactory.replaceNode(mvhdBoxElement, box::CMovieHeaderBox::SMvhdBoxWriteConfig(mvhdConfig));
 }
 
 void CIsobmffWriter::Pimpl::updateSampleGroupsConfig(SSampleGroupsConfig& config,
@@ -96,6 +96,7 @@ amm-info@iis.fraunhofer.de
 #include "mmtisobmff/writer/output.h"
 #include "common/tracksampleinfo.h"
 #include "tree/boxtree.h"
+#include "service/parsercontext.h"
 #include "writer/sample_store.h"
 #include "writer/trak_sample_enhancer.h"
 #include "writer/traf_samplegroups_enhancer.h"
@@ -116,6 +117,7 @@ struct CIsobmffWriter::Pimpl {
   };
 
   struct SPimplConfig {
+    std::shared_ptr<const CParserContext> parserContext = nullptr;
     std::unique_ptr<IIsobmffOutput> out = nullptr;
     std::unique_ptr<IIsobmffOutput> tmpOut = nullptr;
     std::unique_ptr<BoxTree> tree = nullptr;
@@ -164,16 +166,16 @@ struct CIsobmffWriter::Pimpl {
 
    private:
     void fillDefaultConfig() {
-      rollConfig.boxesConfig.sbgpConfig.groupingType = ilo::toFcc("roll");
-      rollConfig.boxesConfig.sgpdConfig.groupingType = ilo::toFcc("roll");
+      rollConfig.boxesConfig.sbgpConfig.groupingType = "roll"_fcc;
+      rollConfig.boxesConfig.sgpdConfig.groupingType = "roll"_fcc;
       rollConfig.boxesConfig.sgpdConfig.defaultLength = 2;
       rollConfig.lastGroupDescIndex = groupDescriptionIndexStart;
-      prolConfig.boxesConfig.sbgpConfig.groupingType = ilo::toFcc("prol");
-      prolConfig.boxesConfig.sgpdConfig.groupingType = ilo::toFcc("prol");
+      prolConfig.boxesConfig.sbgpConfig.groupingType = "prol"_fcc;
+      prolConfig.boxesConfig.sgpdConfig.groupingType = "prol"_fcc;
       prolConfig.boxesConfig.sgpdConfig.defaultLength = 2;
       prolConfig.lastGroupDescIndex = groupDescriptionIndexStart;
-      sapConfig.boxesConfig.sbgpConfig.groupingType = ilo::toFcc("sap ");
-      sapConfig.boxesConfig.sgpdConfig.groupingType = ilo::toFcc("sap ");
+      sapConfig.boxesConfig.sbgpConfig.groupingType = "sap "_fcc;
+      sapConfig.boxesConfig.sgpdConfig.groupingType = "sap "_fcc;
       sapConfig.boxesConfig.sgpdConfig.defaultLength = 1;
       sapConfig.lastGroupDescIndex = groupDescriptionIndexStart;
     }
@@ -188,7 +190,8 @@ struct CIsobmffWriter::Pimpl {
   };
 
   Pimpl(SPimplConfig& config)
-      : m_tree(std::move(config.tree)),
+      : m_parserContext(config.parserContext),
+        m_tree(std::move(config.tree)),
         m_timeNowUtc(config.timeNowUtc),
         m_sampleStore(std::move(config.sampleStore)),
         m_hasFragments(config.hasFragments),
@@ -249,6 +252,7 @@ struct CIsobmffWriter::Pimpl {
   // Function to overwrite the base media decode time
   void overwriteBaseMediaDecodeTime(uint32_t trackId, uint64_t newBmdtOffset);
 
+  std::shared_ptr<const CParserContext> m_parserContext;
   std::unique_ptr<BoxTree> m_tree = nullptr;
   std::vector<std::unique_ptr<BoxTree>> m_fragTrees;
   uint64_t m_timeNowUtc = 0;